@@ -1,5 +1,10 @@
 #include "src/EvoVulkan/VulkanKernel.cpp"
 #include "src/EvoVulkan/DescriptorManager.cpp"
+#include "src/EvoVulkan/BindlessTextureTable.cpp"
+#include "src/EvoVulkan/FrameDescriptorAllocator.cpp"
+#include "src/EvoVulkan/DescriptorCache.cpp"
+#include "src/EvoVulkan/DescriptorBuffer.cpp"
+#include "src/EvoVulkan/UniformRing.cpp"
 
 #include "src/EvoVulkan/Types/MultisampleTarget.cpp"
 #include "src/EvoVulkan/Types/Device.cpp"
@@ -18,6 +23,9 @@
 #include "src/EvoVulkan/Types/VmaBuffer.cpp"
 #include "src/EvoVulkan/Types/Instance.cpp"
 #include "src/EvoVulkan/Types/DescriptorPool.cpp"
+#include "src/EvoVulkan/Types/SamplerCache.cpp"
+#include "src/EvoVulkan/Types/LayoutCache.cpp"
+#include "src/EvoVulkan/Types/TrackedUniformBuffer.cpp"
 
 #include "src/EvoVulkan/Tools/VulkanTools.cpp"
 #include "src/EvoVulkan/Tools/VulkanDebug.cpp"
@@ -25,7 +33,11 @@
 #include "src/EvoVulkan/Tools/Singleton.cpp"
 
 #include "src/EvoVulkan/Memory/Allocator.cpp"
+#include "src/EvoVulkan/Memory/Defragmenter.cpp"
+#include "src/EvoVulkan/Memory/AliasingPool.cpp"
+#include "src/EvoVulkan/Memory/HostAllocator.cpp"
 
 #include "src/EvoVulkan/Complexes/Framebuffer.cpp"
 #include "src/EvoVulkan/Complexes/Shader.cpp"
-#include "src/EvoVulkan/Complexes/Mesh.cpp"
\ No newline at end of file
+#include "src/EvoVulkan/Complexes/Mesh.cpp"
+#include "src/EvoVulkan/Complexes/TextureAtlas.cpp"
\ No newline at end of file
@@ -0,0 +1,69 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_BINDLESSTEXTURETABLE_H
+#define EVOVULKAN_BINDLESSTEXTURETABLE_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Types {
+    class Device;
+}
+
+namespace EvoVulkan::Core {
+    /**
+     * @brief Глобальный массив комбинированных семплеров (set = 1, binding = 0),
+     * индекс текстуры передается в шейдер через push constants.
+     * Требует descriptor indexing (Vulkan 1.2).
+     */
+    class DLL_EVK_EXPORT BindlessTextureTable : public Tools::NonCopyable {
+    public:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    private:
+        BindlessTextureTable() = default;
+        ~BindlessTextureTable() override = default;
+
+    public:
+        static BindlessTextureTable* Create(const Types::Device* device, uint32_t capacity);
+
+    public:
+        /// возвращает индекс в массиве или InvalidIndex, если таблица заполнена
+        uint32_t Register(const VkDescriptorImageInfo& imageInfo);
+        bool Update(uint32_t index, const VkDescriptorImageInfo& imageInfo);
+        bool Unregister(uint32_t index);
+
+        void Bind(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, uint32_t setIndex,
+                  VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS) const;
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD VkDescriptorSetLayout GetLayout() const { return m_layout; }
+        EVK_NODISCARD VkDescriptorSet GetDescriptorSet() const { return m_set; }
+        EVK_NODISCARD uint32_t GetCapacity() const { return m_capacity; }
+        EVK_NODISCARD uint32_t GetCount() const;
+
+    private:
+        void Write(uint32_t index, const VkDescriptorImageInfo& imageInfo);
+
+    private:
+        const Types::Device*  m_device    = nullptr;
+
+        VkDescriptorSetLayout m_layout    = VK_NULL_HANDLE;
+        VkDescriptorPool      m_pool      = VK_NULL_HANDLE;
+        VkDescriptorSet       m_set       = VK_NULL_HANDLE;
+
+        uint32_t              m_capacity  = 0;
+        /// следующий ни разу не выданный индекс
+        uint32_t              m_next      = 0;
+        std::vector<uint32_t> m_freeList  = { };
+        std::vector<bool>     m_used      = { };
+
+        mutable std::mutex    m_mutex     = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_BINDLESSTEXTURETABLE_H
@@ -16,6 +16,7 @@
 
 #include <EvoVulkan/DescriptorManager.h>
 #include <EvoVulkan/Types/MultisampleTarget.h>
+#include <EvoVulkan/Memory/AliasingPool.h>
 
 namespace EvoVulkan::Complexes {
     class DLL_EVK_EXPORT FrameBufferAttachment : public Tools::NonCopyable {
@@ -29,6 +30,7 @@ namespace EvoVulkan::Complexes {
             m_format = std::exchange(attachment.m_format, {});
             m_device = std::exchange(attachment.m_device, {});
             m_allocator = std::exchange(attachment.m_allocator, {});
+            m_aliasingPool = std::exchange(attachment.m_aliasingPool, {});
         }
 
         FrameBufferAttachment& operator=(FrameBufferAttachment&& attachment) noexcept {
@@ -37,6 +39,7 @@ namespace EvoVulkan::Complexes {
             m_format = std::exchange(attachment.m_format, {});
             m_device = std::exchange(attachment.m_device, {});
             m_allocator = std::exchange(attachment.m_allocator, {});
+            m_aliasingPool = std::exchange(attachment.m_aliasingPool, {});
 
             return *this;
         }
@@ -53,6 +56,7 @@ namespace EvoVulkan::Complexes {
         VkFormat m_format = VK_FORMAT_UNDEFINED;
         Types::Device* m_device = nullptr;
         EvoVulkan::Memory::Allocator* m_allocator = nullptr;
+        EvoVulkan::Memory::AliasingPool* m_aliasingPool = nullptr;
 
     };
 
@@ -65,6 +69,7 @@ namespace EvoVulkan::Complexes {
 
     public:
         /// depth will be auto added to end array of attachments
+        /// aliasingPool: attachments share memory with other frame buffers whose lifetime (pass indices) doesn't intersect
         static FrameBuffer* Create(
                 Types::Device* device,
                 EvoVulkan::Memory::Allocator* allocator,
@@ -73,7 +78,9 @@ namespace EvoVulkan::Complexes {
                 Types::CmdPool* pool,
                 const std::vector<VkFormat>& colorAttachments,
                 uint32_t width, uint32_t height,
-                float scale = 1.f);
+                float scale = 1.f,
+                Memory::AliasingPool* aliasingPool = nullptr,
+                Memory::AliasingLifetime lifetime = { });
 
         operator VkFramebuffer() const { return m_framebuffer; }
 
@@ -148,6 +155,9 @@ namespace EvoVulkan::Complexes {
         Types::CmdPool*           m_cmdPool           = nullptr;
         Core::DescriptorManager*  m_descriptorManager = nullptr;
 
+        Memory::AliasingPool*     m_aliasingPool      = nullptr;
+        Memory::AliasingLifetime  m_lifetime          = { };
+
         VkRect2D                  m_scissor           = {};
         VkViewport                m_viewport          = {};
 
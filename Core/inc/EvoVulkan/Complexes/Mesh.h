@@ -66,8 +66,12 @@ namespace EvoVulkan::Complexes {
     }
 
     class Mesh {
+    public:
+        /// байты для inline uniform block биндинга
+        using InlineBlock = std::vector<uint8_t>;
+        using Uniform     = std::variant<VkDescriptorImageInfo, Types::Buffer*, InlineBlock>;
     private:
-        std::vector<std::variant<VkDescriptorImageInfo, Types::Buffer*>> m_uniforms;
+        std::vector<Uniform> m_uniforms;
     private:
         /** \note reference */
         Types::Buffer const*     m_vertices          = nullptr;
@@ -77,6 +81,10 @@ namespace EvoVulkan::Complexes {
 
         //VkDescriptorSet          m_descriptorSet     = VK_NULL_HANDLE;
         Types::DescriptorSet      m_descriptorSet     = { };
+        /// сет получен из DescriptorCache и возвращается туда через Release
+        bool                      m_cachedSet         = false;
+        /// для push descriptor шейдеров сет не выделяется, дескрипторы пишутся при каждом Draw
+        DescriptorUpdateData      m_pushData          = { };
 
         //Types::Buffer**          m_uniforms          = nullptr;
         //uint32_t                 m_countUniforms     = 0;
@@ -89,11 +97,17 @@ namespace EvoVulkan::Complexes {
 
         Shader const*            m_attachShader      = nullptr;
     public:
-        void Draw(const VkCommandBuffer& cmd);
+        /// false, если не удалось записать дескрипторы, тогда отрисовка не записывается
+        bool Draw(const VkCommandBuffer& cmd);
 
         Mesh(const Types::Device* device, Types::Buffer const *vertices, Types::Buffer const *indices, const uint32_t& countIndices, Core::DescriptorManager* manager);
 
+        /// i-й элемент пишется в i-й биндинг шейдера
+        void SetUniforms(const std::vector<Uniform>& uniforms);
+
+        /// берет сет из DescriptorCache, а с inline uniform блоками выделяет свой и записывает его шаблонным обновлением
         bool Bake(Shader const* shader);
+        void Destroy();
     };
 }
 
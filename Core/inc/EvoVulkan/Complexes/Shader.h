@@ -43,9 +43,40 @@ namespace EvoVulkan::Complexes {
 
     };
 
+    class Shader;
+
+    /// Упакованные данные для vkUpdateDescriptorSetWithTemplate, раскладка берется из шаблона шейдера
+    class DLL_EVK_EXPORT DescriptorUpdateData {
+        friend class Shader;
+    public:
+        bool SetImage(uint32_t binding, const VkDescriptorImageInfo& info, uint32_t arrayElement = 0);
+        bool SetBuffer(uint32_t binding, const VkDescriptorBufferInfo& info, uint32_t arrayElement = 0);
+        bool SetTexelBuffer(uint32_t binding, VkBufferView view, uint32_t arrayElement = 0);
+        /// копирует байты прямо в данные сета, offset и size в байтах внутри блока
+        bool SetInlineUniformBlock(uint32_t binding, const void* data, uint32_t size, uint32_t offset = 0);
+
+        EVK_NODISCARD const void* GetData() const { return m_data.data(); }
+        EVK_NODISCARD bool Valid() const { return m_shader && !m_data.empty(); }
+        /// хотя бы один дескриптор биндинга был записан
+        EVK_NODISCARD bool IsSet(uint32_t binding) const { return m_bindings.count(binding) != 0; }
+
+    private:
+        /// image и buffer info одного размера, поэтому тип дескриптора проверяется отдельно
+        template<typename T> bool Set(uint32_t binding, uint32_t arrayElement, const T& value, bool(*isValidType)(VkDescriptorType));
+
+    private:
+        const Shader*        m_shader   = nullptr;
+        std::vector<uint8_t> m_data     = { };
+        /// шаблон пишет все биндинги лейаута, незаданный биндинг ушел бы в драйвер нулевыми хендлами
+        std::set<uint32_t>   m_bindings = { };
+
+    };
+
     class DLL_EVK_EXPORT Shader : public Tools::NonCopyable {
     public:
-        Shader(const Types::Device* device, Types::RenderPass renderPass, const VkPipelineCache& cache);
+        /// менеджер нужен только для того, чтобы пулы сетов этого шейдера считались по его биндингам
+        Shader(const Types::Device* device, Types::RenderPass renderPass, const VkPipelineCache& cache,
+               Core::DescriptorManager* manager = nullptr);
         ~Shader() override = default;
 
         operator VkPipeline() const { return m_pipeline; }
@@ -57,6 +88,16 @@ namespace EvoVulkan::Complexes {
                 const std::vector<VkDescriptorSetLayoutBinding>& descriptorLayoutBindings,
                 const std::vector<VkDeviceSize>& uniformSizes);
 
+        /// должно вызываться до Compile
+        void SetPushConstants(const std::vector<VkPushConstantRange>& ranges);
+        /// внешние лейауты идут после собственного (set = 0), например bindless таблица на set = 1
+        void SetExternalSetLayouts(const std::vector<VkDescriptorSetLayout>& layouts);
+        /// set = 0 становится push descriptor лейаутом, сеты под него не выделяются. Должно вызываться до Compile
+        bool SetPushDescriptors(bool enabled);
+        /// лейауты и пайплайн создаются для Core::DescriptorBuffer, пулы и шаблоны обновления не используются.
+        /// Внешние лейауты тоже должны быть созданы с DESCRIPTOR_BUFFER_BIT_EXT
+        bool SetDescriptorBuffer(bool enabled);
+
         bool SetVertexDescriptions(
                 const std::vector<VkVertexInputBindingDescription>& binding,
                 const std::vector<VkVertexInputAttributeDescription>& attribute);
@@ -76,8 +117,22 @@ namespace EvoVulkan::Complexes {
          */
         EVK_NODISCARD EVK_INLINE VkDescriptorSetLayout GetDescriptorSetLayout() const noexcept { return m_descriptorSetLayout; }
         EVK_NODISCARD EVK_INLINE std::vector<VkDeviceSize> GetUniformSizes() const { return m_uniformSizes; }
+        EVK_NODISCARD EVK_INLINE const std::vector<VkDescriptorSetLayoutBinding>& GetLayoutBindings() const { return m_layoutBindings; }
         EVK_NODISCARD EVK_INLINE VkPipeline GetPipeline() const noexcept { return m_pipeline; }
         EVK_NODISCARD EVK_INLINE VkPipelineLayout GetPipelineLayout() const noexcept { return m_pipelineLayout; }
+        EVK_NODISCARD EVK_INLINE VkDescriptorUpdateTemplate GetUpdateTemplate() const noexcept { return m_updateTemplate; }
+        EVK_NODISCARD const VkDescriptorUpdateTemplateEntry* GetTemplateEntry(uint32_t binding) const;
+
+        /// буфер под все биндинги шейдера, доступен после Compile
+        EVK_NODISCARD DescriptorUpdateData CreateUpdateData() const;
+        /// записывает все биндинги сета одним вызовом
+        bool UpdateDescriptorSet(VkDescriptorSet descriptorSet, const DescriptorUpdateData& data) const;
+
+        /// записывает дескрипторы set = 0 прямо в командный буфер, dstSet у записей игнорируется
+        bool PushDescriptors(const VkCommandBuffer& cmd, const std::vector<VkWriteDescriptorSet>& writes) const;
+        bool PushDescriptors(const VkCommandBuffer& cmd, const DescriptorUpdateData& data) const;
+        EVK_NODISCARD EVK_INLINE bool IsPushDescriptors() const noexcept { return m_pushDescriptors; }
+        EVK_NODISCARD EVK_INLINE bool IsDescriptorBuffer() const noexcept { return m_descriptorBuffer; }
 
         void Bind(const VkCommandBuffer& cmd) const;
 
@@ -88,6 +143,9 @@ namespace EvoVulkan::Complexes {
 
     private:
         bool BuildLayouts();
+        bool BuildUpdateTemplate();
+        /// каждый биндинг шаблона должен быть задан в data
+        EVK_NODISCARD bool IsUpdateDataComplete(const DescriptorUpdateData& data) const;
 
     private:
         struct {
@@ -97,11 +155,15 @@ namespace EvoVulkan::Complexes {
         } m_vertices;
 
         const Types::Device*                         m_device              = nullptr;
+        Core::DescriptorManager*                     m_descriptorManager   = nullptr;
         //VkRenderPass                                 m_renderPass          = VK_NULL_HANDLE;
         Types::RenderPass                            m_renderPass          = { };
 
         VkDescriptorSetLayout                        m_descriptorSetLayout = VK_NULL_HANDLE;
         std::vector<VkDescriptorSetLayoutBinding>    m_layoutBindings      = {};
+        /** \brief external layouts are reference. */
+        std::vector<VkDescriptorSetLayout>           m_externalLayouts     = {};
+        std::vector<VkPushConstantRange>             m_pushConstants       = {};
 
         bool                                         m_hasVertices         = false;
 
@@ -110,7 +172,13 @@ namespace EvoVulkan::Complexes {
         VkPipeline                                   m_pipeline            = VK_NULL_HANDLE;
         VkPipelineLayout                             m_pipelineLayout      = VK_NULL_HANDLE;
 
+        VkDescriptorUpdateTemplate                   m_updateTemplate      = VK_NULL_HANDLE;
+        std::vector<VkDescriptorUpdateTemplateEntry> m_templateEntries     = {};
+        size_t                                       m_templateSize        = 0;
+
         VkBool32                                     m_blendEnable         = VK_FALSE;
+        bool                                         m_pushDescriptors     = false;
+        bool                                         m_descriptorBuffer    = false;
 
         std::vector<VkPipelineShaderStageCreateInfo> m_shaderStages        = {};
         std::vector<VkShaderModule>                  m_shaderModules       = {};
@@ -0,0 +1,102 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_TEXTUREATLAS_H
+#define EVOVULKAN_TEXTUREATLAS_H
+
+#include <EvoVulkan/Types/Texture.h>
+
+namespace EvoVulkan::Complexes {
+    /// Описание подтекстуры внутри атласа. UV указаны в нормализованных координатах слоя
+    struct DLL_EVK_EXPORT AtlasRegion {
+        uint32_t m_layer  = UINT32_MAX;
+
+        uint32_t m_x      = 0;
+        uint32_t m_y      = 0;
+        uint32_t m_width  = 0;
+        uint32_t m_height = 0;
+
+        float_t  m_u0     = 0.f;
+        float_t  m_v0     = 0.f;
+        float_t  m_u1     = 0.f;
+        float_t  m_v1     = 0.f;
+
+        EVK_NODISCARD bool Valid() const { return m_layer != UINT32_MAX; }
+    };
+
+    struct DLL_EVK_EXPORT AtlasImage {
+        const uint8_t* m_pixels = nullptr;
+        uint32_t       m_width  = 0;
+        uint32_t       m_height = 0;
+    };
+
+    /**
+     * @brief Упаковывает много маленьких изображений в слои одного массива текстур (shelf packing).
+     * Все подтекстуры разделяют один VkImageView и один дескриптор, шейдер выбирает
+     * подтекстуру по индексу слоя и UV-прямоугольнику из AtlasRegion.
+     */
+    class DLL_EVK_EXPORT TextureAtlas : public Tools::NonCopyable {
+        /// горизонтальная полка фиксированной высоты, заполняется слева направо
+        struct Shelf {
+            uint32_t m_y      = 0;
+            uint32_t m_height = 0;
+            uint32_t m_x      = 0;
+        };
+
+        struct Layer {
+            std::vector<Shelf> m_shelves = { };
+            uint32_t           m_top     = 0;
+        };
+    private:
+        TextureAtlas() = default;
+        ~TextureAtlas() override = default;
+
+    public:
+        static TextureAtlas* Create(
+                Types::Device* device,
+                Memory::Allocator* allocator,
+                Core::DescriptorManager* manager,
+                Types::CmdPool* pool,
+                VkFormat format,
+                uint32_t layerWidth, uint32_t layerHeight,
+                uint32_t maxLayers,
+                VkFilter filter = VK_FILTER_LINEAR,
+                uint32_t padding = 1);
+
+    public:
+        /// находит место под изображение и загружает его, при нехватке места возвращает невалидный регион
+        AtlasRegion Add(const uint8_t* pixels, uint32_t width, uint32_t height);
+        /// пакетная загрузка: один staging буфер и одна отправка команд на все изображения.
+        /// Регионы идут в порядке images, не поместившиеся изображения получают невалидный регион
+        std::vector<AtlasRegion> Add(const std::vector<AtlasImage>& images);
+
+        /// сбрасывает разметку, содержимое слоев будет перезаписано последующими Add
+        void Clear();
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD EVK_INLINE Types::Texture* GetTexture() const { return m_texture; }
+        EVK_NODISCARD EVK_INLINE uint32_t GetUsedLayersCount() const { return static_cast<uint32_t>(m_layers.size()); }
+        EVK_NODISCARD EVK_INLINE uint32_t GetRegionsCount() const { return m_regionsCount; }
+
+    private:
+        bool Pack(uint32_t width, uint32_t height, AtlasRegion& region);
+        bool PackInLayer(Layer& layer, uint32_t width, uint32_t height, uint32_t& x, uint32_t& y) const;
+
+    private:
+        Types::Texture*    m_texture      = nullptr;
+
+        std::vector<Layer> m_layers       = { };
+
+        uint32_t           m_layerWidth   = 0;
+        uint32_t           m_layerHeight  = 0;
+        uint32_t           m_maxLayers    = 0;
+        uint32_t           m_padding      = 0;
+        uint32_t           m_regionsCount = 0;
+
+    };
+}
+
+#endif //EVOVULKAN_TEXTUREATLAS_H
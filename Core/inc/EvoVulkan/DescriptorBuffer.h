@@ -0,0 +1,94 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_DESCRIPTORBUFFER_H
+#define EVOVULKAN_DESCRIPTORBUFFER_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
+
+namespace EvoVulkan::Types {
+    class Device;
+    struct Buffer;
+}
+
+namespace EvoVulkan::Core {
+    /// участок буфера дескрипторов под один сет
+    struct DLL_EVK_EXPORT DescriptorBufferSet {
+        VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+        VkDeviceSize          m_offset = 0;
+        VkDeviceSize          m_size   = 0;
+
+        EVK_NODISCARD bool Valid() const noexcept { return m_layout != VK_NULL_HANDLE && m_size > 0; }
+    };
+
+    /**
+     * @brief Бэкенд дескрипторов на VK_EXT_descriptor_buffer.
+     * Дескрипторы пишутся через vkGetDescriptorEXT прямо в отображенный буфер и привязываются по смещению,
+     * без пулов и выделения сетов. Запись в разные сеты не требует синхронизации, под мьютексом только
+     * выделение участков буфера.
+     * Лейауты должны быть созданы с DESCRIPTOR_BUFFER_BIT_EXT, см. Shader::SetDescriptorBuffer.
+     */
+    class DLL_EVK_EXPORT DescriptorBuffer : public Tools::NonCopyable {
+    private:
+        DescriptorBuffer() = default;
+        ~DescriptorBuffer() override = default;
+
+    public:
+        static DescriptorBuffer* Create(Types::Device* device, Memory::Allocator* allocator, VkDeviceSize size = 4 * 1024 * 1024);
+
+    public:
+        DescriptorBufferSet Allocate(VkDescriptorSetLayout layout);
+        void Free(DescriptorBufferSet& set);
+
+        bool WriteImage(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type,
+                        const VkDescriptorImageInfo& info, uint32_t arrayElement = 0);
+        /// буфер должен быть создан с VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, range не может быть VK_WHOLE_SIZE
+        bool WriteBuffer(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type,
+                         const VkDescriptorBufferInfo& info, uint32_t arrayElement = 0);
+        /// у inline блока нет дескриптора, его данные лежат прямо в буфере по смещению биндинга.
+        /// offset и size в байтах, кратны 4
+        bool WriteInlineBlock(const DescriptorBufferSet& set, uint32_t binding, const void* data, uint32_t size, uint32_t offset = 0);
+
+        /// привязывает сам буфер, вызывается один раз на командный буфер до Bind
+        void BindBuffer(const VkCommandBuffer& cmd) const;
+        void Bind(const VkCommandBuffer& cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+                  uint32_t firstSet, const DescriptorBufferSet& set) const;
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD VkDeviceSize GetSize() const { return m_size; }
+        EVK_NODISCARD VkDeviceSize GetUsedSize() const;
+
+    private:
+        bool Write(const DescriptorBufferSet& set, uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT& info);
+
+        EVK_NODISCARD VkDeviceSize GetLayoutSize(VkDescriptorSetLayout layout);
+        EVK_NODISCARD size_t GetDescriptorSize(VkDescriptorType type) const;
+
+    private:
+        const Types::Device*                              m_device      = nullptr;
+
+        Types::Buffer*                                    m_buffer      = nullptr;
+        uint8_t*                                          m_mapped      = nullptr;
+        VkDeviceAddress                                   m_address     = 0;
+        VkBufferUsageFlags                                m_usage       = 0;
+        VkDeviceSize                                      m_size        = 0;
+        VkDeviceSize                                      m_alignment   = 0;
+        VkDeviceSize                                      m_used        = 0;
+
+        /// свободные участки: смещение -> размер, соседние склеиваются при освобождении
+        std::map<VkDeviceSize, VkDeviceSize>              m_freeRanges  = { };
+        std::unordered_map<VkDescriptorSetLayout, VkDeviceSize> m_layoutSizes = { };
+
+        mutable std::mutex                                m_mutex       = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_DESCRIPTORBUFFER_H
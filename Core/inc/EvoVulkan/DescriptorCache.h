@@ -0,0 +1,137 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_DESCRIPTORCACHE_H
+#define EVOVULKAN_DESCRIPTORCACHE_H
+
+#include <EvoVulkan/Types/DescriptorSet.h>
+
+namespace EvoVulkan::Core {
+    class DescriptorManager;
+
+    struct DLL_EVK_EXPORT DescriptorWrite {
+        uint32_t               m_binding      = 0;
+        uint32_t               m_arrayElement = 0;
+        VkDescriptorType       m_type         = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        VkDescriptorImageInfo  m_image        = { };
+        VkDescriptorBufferInfo m_buffer       = { };
+
+        EVK_NODISCARD bool IsImage() const;
+        /// ссылается ли запись на данный хендл (семплер, вью или буфер)
+        EVK_NODISCARD bool Uses(uint64_t handle) const;
+        /// подменяет хендл ресурса, false - запись на него не ссылается
+        bool Replace(uint64_t oldHandle, uint64_t newHandle);
+
+        bool operator==(const DescriptorWrite& other) const;
+    };
+
+    /// Содержимое сета. Записи хранятся отсортированными по биндингу, поэтому порядок добавления не важен
+    class DLL_EVK_EXPORT DescriptorWrites {
+    public:
+        DescriptorWrites& AddImage(uint32_t binding, VkDescriptorType type, const VkDescriptorImageInfo& info, uint32_t arrayElement = 0);
+        DescriptorWrites& AddBuffer(uint32_t binding, VkDescriptorType type, const VkDescriptorBufferInfo& info, uint32_t arrayElement = 0);
+
+        EVK_NODISCARD const std::vector<DescriptorWrite>& GetWrites() const { return m_writes; }
+        EVK_NODISCARD std::set<VkDescriptorType> GetTypes() const;
+        EVK_NODISCARD bool Empty() const { return m_writes.empty(); }
+
+        bool Replace(uint64_t oldHandle, uint64_t newHandle);
+
+        bool operator==(const DescriptorWrites& other) const { return m_writes == other.m_writes; }
+
+    private:
+        void Insert(const DescriptorWrite& write);
+
+    private:
+        std::vector<DescriptorWrite> m_writes;
+
+    };
+
+    struct DLL_EVK_EXPORT DescriptorCacheKey {
+        VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+        DescriptorWrites      m_writes = { };
+
+        bool operator==(const DescriptorCacheKey& other) const {
+            return m_layout == other.m_layout && m_writes == other.m_writes;
+        }
+    };
+
+    struct DLL_EVK_EXPORT DescriptorCacheKeyHash {
+        size_t operator()(const DescriptorCacheKey& key) const;
+    };
+
+    /**
+     * @brief Кэш сетов дескрипторов по содержимому.
+     * Одинаковые (лейаут, ресурсы) получают один и тот же сет, vkUpdateDescriptorSets вызывается один раз.
+     * Сеты без ссылок не освобождаются сразу, а ждут повторного запроса, старые вытесняются по лимиту.
+     */
+    class DLL_EVK_EXPORT DescriptorCache : public Tools::NonCopyable {
+        struct Entry {
+            Types::DescriptorSet                 m_set;
+            uint32_t                             m_references;
+            std::list<VkDescriptorSet>::iterator m_unusedIt;
+            /// сеты, которые после Relocate совпали с этой записью. Их еще держат владельцы,
+            /// поэтому они делят счетчик ссылок записи и освобождаются вместе с ней
+            std::vector<Types::DescriptorSet>    m_aliases;
+        };
+
+        using Entries = std::unordered_map<DescriptorCacheKey, Entry, DescriptorCacheKeyHash>;
+    private:
+        DescriptorCache() = default;
+        ~DescriptorCache() override = default;
+
+    public:
+        static DescriptorCache* Create(const VkDevice& device, DescriptorManager* manager, uint32_t unusedLimit = 256);
+
+    public:
+        /// возвращает сет с нужным содержимым, увеличивая счетчик ссылок
+        Types::DescriptorSet Acquire(VkDescriptorSetLayout layout, const DescriptorWrites& writes);
+        bool Release(const Types::DescriptorSet& set);
+
+        /// освобождает неиспользуемые сеты, которые ссылаются на уничтожаемый ресурс
+        void Evict(uint64_t handle);
+        void EvictUnused();
+
+        /// переписывает сеты, которые ссылаются на перенесенный ресурс, сами сеты и их ссылки остаются прежними.
+        /// Сеты не должны использоваться в командах, которые еще выполняются
+        void Relocate(uint64_t oldHandle, uint64_t newHandle);
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD uint32_t GetSetsCount() const;
+        EVK_NODISCARD uint32_t GetUnusedCount() const;
+        EVK_NODISCARD uint64_t GetHits() const;
+        EVK_NODISCARD uint64_t GetMisses() const;
+
+    private:
+        void Erase(Entries::iterator entryIt);
+
+        /// обратный индекс: хендл ресурса -> ключи сетов, которые на него ссылаются
+        void Index(const DescriptorCacheKey* key);
+        void Unindex(const DescriptorCacheKey* key);
+        EVK_NODISCARD std::vector<const DescriptorCacheKey*> GetKeys(uint64_t handle) const;
+
+    private:
+        VkDevice                                   m_device      = VK_NULL_HANDLE;
+        DescriptorManager*                         m_manager     = nullptr;
+
+        Entries                                    m_entries     = Entries();
+        std::unordered_map<VkDescriptorSet, const DescriptorCacheKey*> m_sets = { };
+        /// ключи хранятся в узлах m_entries, их адреса не меняются до удаления записи
+        std::unordered_map<uint64_t, std::unordered_set<const DescriptorCacheKey*>> m_handles = { };
+        /// сеты без ссылок, в начале самые старые
+        std::list<VkDescriptorSet>                 m_unused      = { };
+        uint32_t                                   m_unusedLimit = 0;
+
+        uint64_t                                   m_hits        = 0;
+        uint64_t                                   m_misses      = 0;
+
+        /// текстуры запрашивают сеты и из потоков загрузки
+        mutable std::mutex                         m_mutex       = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_DESCRIPTORCACHE_H
@@ -13,8 +13,83 @@ namespace EvoVulkan::Types {
 }
 
 namespace EvoVulkan::Core {
+    class BindlessTextureTable;
+    class DescriptorCache;
+
+    /// пулы группируются по лейауту и маске типов дескрипторов
+    struct DLL_EVK_EXPORT DescriptorPoolKey {
+        VkDescriptorSetLayout m_layout   = VK_NULL_HANDLE;
+        uint64_t              m_typeMask = 0;
+
+        bool operator==(const DescriptorPoolKey& other) const {
+            return m_layout == other.m_layout && m_typeMask == other.m_typeMask;
+        }
+    };
+
+    struct DLL_EVK_EXPORT DescriptorPoolKeyHash {
+        size_t operator()(const DescriptorPoolKey& key) const;
+    };
+
+    /// статистика по одному лейауту, по ней можно подбирать размеры пулов
+    struct DLL_EVK_EXPORT DescriptorLayoutStats {
+        uint32_t m_liveSets    = 0;
+        uint32_t m_peakSets    = 0;
+        uint32_t m_pools       = 0;
+        /// суммарное количество сетов во всех пулах лейаута
+        uint32_t m_capacity    = 0;
+        uint64_t m_allocations = 0;
+
+        EVK_NODISCARD float_t GetUtilization() const {
+            return m_capacity == 0 ? 0.f : static_cast<float_t>(m_liveSets) / static_cast<float_t>(m_capacity);
+        }
+    };
+
+    /**
+     * @brief Потокобезопасный менеджер сетов дескрипторов.
+     * Каждый поток выделяет сеты из своих закрепленных пулов под разделяемой блокировкой,
+     * общие корзины пулов трогаются под эксклюзивной блокировкой только при смене пула.
+     * Освобождать сет можно из любого потока, пул синхронизирует Allocate/Free сам.
+     */
     class DLL_EVK_EXPORT DescriptorManager : public Tools::NonCopyable {
         using RequestTypes = std::set<VkDescriptorType>;
+
+        struct PoolBucket {
+            std::vector<Types::DescriptorPool*> m_pools;
+            /// незакрепленные пулы, в которых еще есть место. Последний отдается первым
+            std::vector<Types::DescriptorPool*> m_freePools;
+            /// размер следующего пула, растет геометрически
+            uint32_t                            m_nextPoolSets;
+        };
+
+        struct LayoutInfo {
+            /// количество дескрипторов каждого типа в одном сете
+            std::vector<VkDescriptorPoolSize> m_setSizes;
+            /// количество inline uniform block биндингов в одном сете, их размер в m_setSizes указан в байтах
+            uint32_t                          m_inlineBindings = 0;
+
+            /// меняются на быстром пути без эксклюзивной блокировки
+            std::atomic<uint32_t>             m_liveSets    = 0;
+            std::atomic<uint32_t>             m_peakSets    = 0;
+            std::atomic<uint64_t>             m_allocations = 0;
+
+            uint32_t                          m_pools       = 0;
+            uint32_t                          m_capacity    = 0;
+
+            void OnAllocate();
+            void OnFree();
+            EVK_NODISCARD DescriptorLayoutStats GetStats() const;
+        };
+
+        /// текущие пулы потока по ключам корзин, из них выделяет только этот поток
+        using ThreadCache  = std::unordered_map<DescriptorPoolKey, Types::DescriptorPool*, DescriptorPoolKeyHash>;
+
+        using PoolBuckets  = std::unordered_map<DescriptorPoolKey, PoolBucket, DescriptorPoolKeyHash>;
+        using LayoutInfos  = std::unordered_map<VkDescriptorSetLayout, LayoutInfo>;
+        using ThreadCaches = std::unordered_map<std::thread::id, ThreadCache>;
+    public:
+        static constexpr uint32_t MinPoolSets = 16;
+        static constexpr uint32_t MaxPoolSets = 1024;
+
     private:
         DescriptorManager()  = default;
         ~DescriptorManager() override = default;
@@ -28,13 +103,45 @@ namespace EvoVulkan::Core {
         Types::DescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout layout, const RequestTypes& requestTypes, bool reallocate = false);
         bool FreeDescriptorSet(Types::DescriptorSet* descriptorSet);
 
+        /// возвращает закрепленные за вызывающим потоком пулы в общие корзины.
+        /// При завершении потока вызывается автоматически, вручную - если поток живет дольше, чем выделяет сеты
+        void ReleaseThreadCache();
+
+        /// пулы для лейаута считаются по его биндингам, сеты выделяются только из зарегистрированных лейаутов
+        bool RegisterLayout(VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+        void UnregisterLayout(VkDescriptorSetLayout layout);
+
+        EVK_NODISCARD DescriptorLayoutStats GetLayoutStats(VkDescriptorSetLayout layout) const;
+        void PrintStats() const;
+
+        /// nullptr, если устройство не поддерживает descriptor indexing
+        EVK_NODISCARD BindlessTextureTable* GetBindlessTable() const { return m_bindlessTable; }
+        EVK_NODISCARD DescriptorCache* GetDescriptorCache() const { return m_cache; }
+
     private:
-        Types::DescriptorPool* FindDescriptorPool(VkDescriptorSetLayout layout, const RequestTypes& requestTypes);
-        Types::DescriptorPool* AllocateDescriptorPool(VkDescriptorSetLayout layout, const RequestTypes& requestTypes);
+        /// быстрый путь, вызывается под разделяемой блокировкой
+        Types::DescriptorSet AllocateFromThreadCache(const DescriptorPoolKey& key);
+        /// медленный путь, вызывается под эксклюзивной блокировкой
+        Types::DescriptorSet AllocateDescriptorSet(const DescriptorPoolKey& key, const RequestTypes& requestTypes, bool reallocate);
+
+        Types::DescriptorPool* FindDescriptorPool(PoolBucket& bucket);
+        Types::DescriptorPool* AllocateDescriptorPool(PoolBucket& bucket, VkDescriptorSetLayout layout, LayoutInfo& info, const RequestTypes& requestTypes);
+        /// пул без закрепления возвращается в список свободных или уничтожается, если пуст
+        void ReturnDescriptorPool(Types::DescriptorPool* pool);
+        void DestroyDescriptorPool(Types::DescriptorPool* pool);
+        void ResetUnlocked();
 
     private:
-        const EvoVulkan::Types::Device*  m_device = nullptr;
-        std::set<Types::DescriptorPool*> m_pools  = std::set<Types::DescriptorPool*>();
+        const EvoVulkan::Types::Device*  m_device        = nullptr;
+        PoolBuckets                      m_buckets       = PoolBuckets();
+        LayoutInfos                      m_layouts       = LayoutInfos();
+        ThreadCaches                     m_threadCaches  = ThreadCaches();
+        /// пулы, которые сейчас закреплены за каким-либо потоком
+        std::unordered_set<Types::DescriptorPool*> m_claimedPools = { };
+        BindlessTextureTable*            m_bindlessTable = nullptr;
+        DescriptorCache*                 m_cache         = nullptr;
+
+        mutable std::shared_mutex        m_mutex         = std::shared_mutex();
 
     };
 }
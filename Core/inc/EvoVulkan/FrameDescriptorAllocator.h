@@ -0,0 +1,60 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_FRAMEDESCRIPTORALLOCATOR_H
+#define EVOVULKAN_FRAMEDESCRIPTORALLOCATOR_H
+
+#include <EvoVulkan/Types/DescriptorSet.h>
+
+namespace EvoVulkan::Types {
+    class Device;
+    class DescriptorPool;
+}
+
+namespace EvoVulkan::Core {
+    /**
+     * @brief Линейный аллокатор временных сетов дескрипторов.
+     * Пулы создаются без FREE_DESCRIPTOR_SET_BIT, сеты выделяются подряд в течение кадра
+     * и возвращаются все разом через vkResetDescriptorPool, когда GPU закончил с этим кадром.
+     * Сеты из этого аллокатора нельзя освобождать через DescriptorManager::FreeDescriptorSet.
+     */
+    class DLL_EVK_EXPORT FrameDescriptorAllocator : public Tools::NonCopyable {
+        struct Frame {
+            std::vector<Types::DescriptorPool*> m_pools;
+            /// индекс пула, из которого сейчас идет выделение
+            uint32_t                            m_current;
+        };
+    private:
+        FrameDescriptorAllocator() = default;
+        ~FrameDescriptorAllocator() override = default;
+
+    public:
+        static FrameDescriptorAllocator* Create(const Types::Device* device, uint32_t framesCount, uint32_t setsPerPool = 512);
+
+    public:
+        /// сбрасывает пулы кадра, вызывать только когда фенс этого кадра уже просигналил
+        bool BeginFrame(uint32_t frameIndex);
+
+        Types::DescriptorSet Allocate(VkDescriptorSetLayout layout);
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD uint32_t GetFramesCount() const { return static_cast<uint32_t>(m_frames.size()); }
+        EVK_NODISCARD uint32_t GetCurrentFrame() const { return m_frameIndex; }
+
+    private:
+        Types::DescriptorPool* CreatePool() const;
+
+    private:
+        const Types::Device* m_device      = nullptr;
+
+        std::vector<Frame>   m_frames      = { };
+        uint32_t             m_frameIndex  = 0;
+        uint32_t             m_setsPerPool = 0;
+
+    };
+}
+
+#endif //EVOVULKAN_FRAMEDESCRIPTORALLOCATOR_H
@@ -0,0 +1,82 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_ALIASINGPOOL_H
+#define EVOVULKAN_ALIASINGPOOL_H
+
+#include <EvoVulkan/Memory/Allocator.h>
+
+namespace EvoVulkan::Types {
+    class Device;
+    class Image;
+}
+
+namespace EvoVulkan::Memory {
+    /// Время жизни ресурса в проходах кадра, обе границы включительно
+    struct DLL_EVK_EXPORT AliasingLifetime {
+        uint32_t m_first = 0;
+        uint32_t m_last  = 0;
+
+        EVK_NODISCARD bool Intersects(const AliasingLifetime& other) const {
+            return m_first <= other.m_last && other.m_first <= m_last;
+        }
+    };
+
+    /**
+     * @brief Общая память для промежуточных вложений кадра.
+     * Изображения, у которых время жизни не пересекается, размещаются по одним и тем же адресам,
+     * поэтому цепочка проходов занимает память по пиковому набору живых вложений, а не по их сумме.
+     * Перед рендер пассом на такой памяти нужен InsertAliasingBarrier, его ставит FrameBuffer::BeginCmd.
+     */
+    class DLL_EVK_EXPORT AliasingPool : public Tools::NonCopyable {
+        struct Placement {
+            VkImage          m_image;
+            VkDeviceSize     m_offset;
+            VkDeviceSize     m_size;
+            AliasingLifetime m_lifetime;
+        };
+
+        struct Block {
+            VmaAllocation          m_allocation = VK_NULL_HANDLE;
+            VkDeviceSize           m_size       = 0;
+            uint32_t               m_memoryType = UINT32_MAX;
+            std::vector<Placement> m_placements = { };
+        };
+    private:
+        AliasingPool() = default;
+        ~AliasingPool() override = default;
+
+    public:
+        static AliasingPool* Create(Types::Device* device, Allocator* allocator, VkDeviceSize blockSize = 64 * 1024 * 1024);
+
+        /// барьер между проходами: следующий проход пишет в память, которую предыдущий мог еще писать или читать
+        static void InsertAliasingBarrier(VkCommandBuffer cmd);
+
+    public:
+        Types::Image CreateImage(const VkImageCreateInfo& info, const AliasingLifetime& lifetime);
+        void DestroyImage(Types::Image& image);
+
+        /// сколько памяти занимают блоки и сколько заняли бы те же изображения без алиасинга
+        EVK_NODISCARD VkDeviceSize GetMemorySize() const;
+        EVK_NODISCARD VkDeviceSize GetRequestedSize() const;
+        EVK_NODISCARD uint32_t GetBlocksCount() const { return static_cast<uint32_t>(m_blocks.size()); }
+
+        void Destroy();
+        void Free();
+
+    private:
+        /// первое подходящее смещение среди изображений с пересекающимся временем жизни, UINT64_MAX - места нет
+        static VkDeviceSize FindOffset(const Block& block, const VkMemoryRequirements& requirements, const AliasingLifetime& lifetime);
+
+    private:
+        Types::Device*     m_device    = nullptr;
+        Allocator*         m_allocator = nullptr;
+        VkDeviceSize       m_blockSize = 0;
+
+        std::list<Block>   m_blocks    = { };
+
+    };
+}
+
+#endif //EVOVULKAN_ALIASINGPOOL_H
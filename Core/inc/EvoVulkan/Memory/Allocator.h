@@ -7,6 +7,7 @@
 
 #include <EvoVulkan/Tools/VulkanDebug.h>
 #include "../../../libs/VMA/src/VmaUsage.h"
+#include <EvoVulkan/Memory/HostAllocator.h>
 
 namespace EvoVulkan::Types {
     class Device;
@@ -19,6 +20,8 @@ namespace EvoVulkan::Memory {
     struct DLL_EVK_EXPORT Buffer {
         VkBuffer m_buffer;
         VmaAllocation m_allocation;
+        /// не nullptr только для аллокаций с VMA_ALLOCATION_CREATE_MAPPED_BIT, указатель живет вместе с аллокацией
+        void* m_mapped;
     };
 
     struct DLL_EVK_EXPORT RawMemory {
@@ -40,16 +43,98 @@ namespace EvoVulkan::Memory {
 
     };
 
+    /// Классы ресурсов. У каждого класса свой пул VMA, чтобы короткоживущие ресурсы не фрагментировали долгоживущие
+    enum class MemoryPool : uint8_t {
+        Default = 0,
+        Attachments,
+        StaticMeshes,
+        Textures,
+        Staging,
+        Uniforms,
+
+        Count
+    };
+
+    /// Модель многопоточности аллокатора, задается при создании
+    enum class AllocatorThreading : uint8_t {
+        /// все вызовы из одного потока, VMA и пулы работают без блокировок
+        External = 0,
+        /// вызовы из любых потоков: VMA синхронизируется сама, пулы классов - мьютексом аллокатора
+        Internal = 1
+    };
+
+    struct DLL_EVK_EXPORT PoolCreateInfo {
+        /// размер одного блока VkDeviceMemory
+        VkDeviceSize m_blockSize = 0;
+        /// предел памяти пула в байтах, округляется вверх до целого числа блоков. 0 - без ограничений
+        VkDeviceSize m_budget    = 0;
+        /// линейный алгоритм для ресурсов, которые освобождаются примерно в порядке выделения
+        bool         m_linear    = false;
+    };
+
+    struct DLL_EVK_EXPORT PoolStatistics {
+        uint32_t     m_blockCount      = 0;
+        uint32_t     m_allocationCount = 0;
+        VkDeviceSize m_blockBytes      = 0;
+        VkDeviceSize m_allocationBytes = 0;
+    };
+
+    /**
+     * @brief Владелец аллокации, которую дефрагментация может перенести на новое место.
+     * Регистрируется через Allocator::SetRelocatable, аллокации без владельца дефрагментация не трогает.
+     * Дескрипторы, записанные в обход DescriptorCache, владелец обновляет сам через AddRelocationListener.
+     */
+    class DLL_EVK_EXPORT Relocatable {
+    public:
+        /// старый и новый хендл (VkImageView или VkBuffer). Вызывается, пока старый хендл еще жив
+        using RelocationListener = std::function<void(uint64_t oldHandle, uint64_t newHandle)>;
+
+    public:
+        virtual ~Relocatable() = default;
+
+    public:
+        /// создает новый ресурс в dstAllocation и записывает копирование в cmd. false - аллокация остается на месте
+        virtual bool BeginRelocation(VkCommandBuffer cmd, VmaAllocation dstAllocation) = 0;
+        /// копирование выполнено и аллокация уже указывает на новое место: старый ресурс заменяется новым
+        virtual void EndRelocation() = 0;
+        /// перемещение отменено, новый ресурс уничтожается
+        virtual void CancelRelocation() = 0;
+
+        /// возвращает идентификатор для RemoveRelocationListener
+        uint32_t AddRelocationListener(RelocationListener listener);
+        void RemoveRelocationListener(uint32_t id);
+
+    protected:
+        void NotifyRelocation(uint64_t oldHandle, uint64_t newHandle);
+        EVK_NODISCARD bool HasRelocationListeners() const { return !m_relocationListeners.empty(); }
+
+    private:
+        std::vector<std::pair<uint32_t, RelocationListener>> m_relocationListeners;
+        uint32_t m_nextListenerId = 0;
+
+    };
+
     class DLL_EVK_EXPORT Allocator : public Tools::NonCopyable {
+        struct Pool {
+            VmaPool        m_pool          = VK_NULL_HANDLE;
+            /// пул VMA живет в одном типе памяти, он выбирается по первому ресурсу этого класса
+            uint32_t       m_memoryType    = UINT32_MAX;
+            /// типы памяти, ресурсы которых уже ушли мимо пула в общую память, о каждом предупреждаем один раз
+            uint32_t       m_fallbackTypes = 0;
+            PoolCreateInfo m_info          = { };
+        };
     private:
-        explicit Allocator(Types::Device* device)
+        Allocator(Types::Device* device, AllocatorThreading threading)
             : m_device(device)
+            , m_threading(threading)
         { }
 
         ~Allocator() override;
 
     public:
-        static Allocator* Create(Types::Device* device);
+        /// потоки загрузки выделяют ресурсы через тот же аллокатор в режиме Internal, тогда память остается
+        /// под бюджетами VMA и доступна дефрагментации
+        static Allocator* Create(Types::Device* device, AllocatorThreading threading = AllocatorThreading::External);
 
         operator VmaAllocator() const { return m_vmaAllocator; }
 
@@ -57,29 +142,86 @@ namespace EvoVulkan::Memory {
         void Free();
 
     public:
-        Buffer AllocBuffer(const VkBufferCreateInfo& info, VmaMemoryUsage usage);
-        Types::Image AllocImage(const VkImageCreateInfo& info, bool CPUUsage);
+        Buffer AllocBuffer(const VkBufferCreateInfo& info, VmaMemoryUsage usage, VmaAllocationCreateFlags flags = 0,
+                           MemoryPool pool = MemoryPool::Default);
+        /// подбирает тип памяти по флагам свойств, сама память выделяется внутри больших блоков VMA
+        Buffer AllocBuffer(const VkBufferCreateInfo& info, VkMemoryPropertyFlags requiredFlags, VmaAllocationCreateFlags flags = 0,
+                           MemoryPool pool = MemoryPool::Default);
+        /// отображенный буфер для частой записи с CPU: сначала видеопамять, видимая с хоста, в пределах бюджета, затем обычная host-visible.
+        /// coherent = false - coherent память только предпочитается, записи в non-coherent память вызывающий сбрасывает сам
+        Buffer AllocHostWritableBuffer(const VkBufferCreateInfo& info, MemoryPool pool = MemoryPool::Default, bool coherent = true);
+        Types::Image AllocImage(const VkImageCreateInfo& info, bool CPUUsage, MemoryPool pool = MemoryPool::Default);
         RawMemory AllocateMemory(VkMemoryAllocateInfo memoryAllocateInfo);
 
         void FreeBuffer(Buffer& info);
         void FreeImage(Types::Image& image);
         bool FreeMemory(RawMemory* memory);
 
+        /// nullptr снимает регистрацию, владелец должен жить дольше аллокации
+        void SetRelocatable(const Buffer& buffer, Relocatable* owner);
+        void SetRelocatable(const Types::Image& image, Relocatable* owner);
+
+        /// ресурсы для перемещения при дефрагментации, привязываются к началу временной аллокации
+        VkBuffer CreateRelocationBuffer(const VkBufferCreateInfo& info, VmaAllocation dstAllocation);
+        VkImage CreateRelocationImage(const VkImageCreateInfo& info, VmaAllocation dstAllocation);
+        void DestroyRelocationBuffer(VkBuffer buffer);
+        void DestroyRelocationImage(VkImage image);
+        /// уничтожает старый хендл и подставляет новый, аллокация остается прежней
+        void ReplaceBuffer(Buffer& buffer, VkBuffer newBuffer);
+        void ReplaceImage(Types::Image& image, VkImage newImage);
+
         EVK_NODISCARD uint64_t GetGPUMemoryUsage() const;
         EVK_NODISCARD uint64_t GetCPUMemoryUsage() const;
         EVK_NODISCARD uint64_t GetAllocatedMemorySize() const { return m_deviceMemoryAllocSize; }
         EVK_NODISCARD uint64_t GetAllocatedHeapsCount() const { return m_allocHeapsCount;       }
+        /// есть DEVICE_LOCAL | HOST_VISIBLE память: либо Resizable BAR, либо небольшое окно BAR на 256 МБ
+        EVK_NODISCARD bool HasDeviceLocalHostVisibleMemory() const { return m_deviceHostVisibleTypeBits != 0; }
+        /// окно BAR покрывает всю видеопамять, и ее можно использовать под загрузки без ограничений
+        EVK_NODISCARD bool IsResizableBAREnabled() const { return m_resizableBAR; }
+        /// память, которая выделяется только при реальном обращении (тайловые GPU). Под transient вложения
+        EVK_NODISCARD bool HasLazilyAllocatedMemory() const { return m_lazilyAllocatedTypeBits != 0; }
+        EVK_NODISCARD AllocatorThreading GetThreading() const { return m_threading; }
+
+        /// настройки применяются при создании пула, то есть до первого ресурса этого класса
+        bool SetPoolCreateInfo(MemoryPool pool, const PoolCreateInfo& info);
+        EVK_NODISCARD PoolStatistics GetPoolStatistics(MemoryPool pool) const;
+        EVK_NODISCARD PoolCreateInfo GetPoolCreateInfo(MemoryPool pool) const;
+        /// VK_NULL_HANDLE, если пул еще не создан или это общая память VMA
+        EVK_NODISCARD VmaPool GetVmaPool(MemoryPool pool) const;
+        EVK_NODISCARD static const char* GetPoolName(MemoryPool pool);
 
     private:
         bool Init();
+        void DetectDeviceLocalHostVisibleMemory();
+        void DetectLazilyAllocatedMemory();
+
+        /// пул класса под данный тип памяти. VK_NULL_HANDLE - ресурс идет в общую память VMA
+        VmaPool FindPool(MemoryPool pool, uint32_t memoryType);
+        VmaPool FindPool(MemoryPool pool, const VkBufferCreateInfo& info, const VmaAllocationCreateInfo& allocInfo);
+        VmaPool FindPool(MemoryPool pool, const VkImageCreateInfo& info, const VmaAllocationCreateInfo& allocInfo);
+
+        VkResult CreateBuffer(const VkBufferCreateInfo& info, VmaAllocationCreateInfo allocInfo, MemoryPool pool, Buffer& buffer);
+
+        /// блокировка таблицы пулов, берется только в режиме Internal
+        EVK_NODISCARD std::unique_lock<std::mutex> LockPools() const;
 
     private:
-        Types::Device* m_device       = nullptr;
-        VmaAllocator   m_vmaAllocator = VK_NULL_HANDLE;
+        Types::Device*     m_device       = nullptr;
+        VmaAllocator       m_vmaAllocator = VK_NULL_HANDLE;
+        AllocatorThreading m_threading    = AllocatorThreading::External;
 
         uint64_t       m_deviceMemoryAllocSize   = 0;
         uint32_t       m_allocHeapsCount         = 0;
 
+        /// типы памяти DEVICE_LOCAL | HOST_VISIBLE, coherent и нет, битовая маска для VmaAllocationCreateInfo::memoryTypeBits
+        uint32_t       m_deviceHostVisibleTypeBits = 0;
+        bool           m_resizableBAR              = false;
+        uint32_t       m_lazilyAllocatedTypeBits   = 0;
+
+        std::array<Pool, static_cast<size_t>(MemoryPool::Count)> m_pools = { };
+        /// пулы создаются лениво при первом ресурсе класса, в режиме Internal это может случиться в любом потоке
+        mutable std::mutex m_poolsMutex = std::mutex();
+
     };
 
 }
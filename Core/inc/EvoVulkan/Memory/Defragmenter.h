@@ -0,0 +1,85 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_DEFRAGMENTER_H
+#define EVOVULKAN_DEFRAGMENTER_H
+
+#include <EvoVulkan/Memory/Allocator.h>
+
+namespace EvoVulkan::Types {
+    class Device;
+    class CmdPool;
+}
+
+namespace EvoVulkan::Memory {
+    struct DLL_EVK_EXPORT DefragmentationStatistics {
+        VkDeviceSize m_bytesMoved       = 0;
+        VkDeviceSize m_bytesFreed       = 0;
+        uint32_t     m_allocationsMoved = 0;
+        uint32_t     m_blocksFreed      = 0;
+        uint32_t     m_passes           = 0;
+    };
+
+    /**
+     * @brief Инкрементальная дефрагментация памяти VMA.
+     * Каждый Step выполняет один проход: переносит не больше заданного объема и укладывается в бюджет времени,
+     * остальные перемещения откладываются на следующие кадры. Переносятся только аллокации с владельцем Relocatable,
+     * владелец сам копирует ресурс и пересоздает вью и дескрипторы. Линейные пулы не дефрагментируются.
+     */
+    class DLL_EVK_EXPORT Defragmenter : public Tools::NonCopyable {
+    private:
+        Defragmenter() = default;
+        ~Defragmenter() override = default;
+
+    public:
+        static Defragmenter* Create(Types::Device* device, Allocator* allocator, Types::CmdPool* cmdPool);
+
+    public:
+        /// запускает дефрагментацию общей памяти и всех созданных пулов, false - уже запущена
+        bool Begin();
+        /// один проход, вызывать только когда очередь простаивает.
+        /// true - ресурсы переехали и командные буферы со старыми хендлами надо перезаписать
+        bool Step();
+        void Cancel();
+
+        /// 0 - автоматический запуск выключен
+        void SetAutoInterval(uint32_t frames) { m_autoInterval = frames; }
+        void SetPassBudget(VkDeviceSize bytes, uint32_t allocations);
+        void SetTimeBudget(uint64_t microseconds) { m_timeBudget = microseconds; }
+
+        EVK_NODISCARD bool IsActive() const { return m_context != VK_NULL_HANDLE || m_poolIndex < m_pools.size(); }
+        EVK_NODISCARD const DefragmentationStatistics& GetStatistics() const { return m_statistics; }
+
+        void Destroy();
+        void Free();
+
+    private:
+        /// контекст для следующего пула в очереди, false - пулы закончились
+        bool BeginPool();
+        void EndPool();
+
+    private:
+        Types::Device*            m_device         = nullptr;
+        Allocator*                m_allocator      = nullptr;
+        Types::CmdPool*           m_cmdPool        = nullptr;
+
+        VmaDefragmentationContext m_context        = VK_NULL_HANDLE;
+        /// VK_NULL_HANDLE в очереди - общая память VMA
+        std::vector<VmaPool>      m_pools          = { };
+        size_t                    m_poolIndex      = 0;
+
+        /// ограничения одного прохода, время в микросекундах считается только на запись копирований
+        VkDeviceSize              m_maxBytes       = 16 * 1024 * 1024;
+        uint32_t                  m_maxAllocations = 64;
+        uint64_t                  m_timeBudget     = 2000;
+
+        uint32_t                  m_autoInterval   = 0;
+        uint32_t                  m_idleFrames     = 0;
+
+        DefragmentationStatistics m_statistics     = { };
+
+    };
+}
+
+#endif //EVOVULKAN_DEFRAGMENTER_H
@@ -0,0 +1,112 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_HOSTALLOCATOR_H
+#define EVOVULKAN_HOSTALLOCATOR_H
+
+#include <EvoVulkan/Tools/Singleton.h>
+
+namespace EvoVulkan::Memory {
+    /// Источник памяти для драйвера. Область выделения передается и при освобождении,
+    /// поэтому реализация может раскладывать память по отдельным аренам для каждой области
+    class DLL_EVK_EXPORT HostAllocatorBackend {
+    public:
+        virtual ~HostAllocatorBackend() = default;
+
+    public:
+        virtual void* Allocate(size_t size, VkSystemAllocationScope scope) = 0;
+        virtual void Free(void* memory, size_t size, VkSystemAllocationScope scope) = 0;
+
+    };
+
+    struct DLL_EVK_EXPORT HostScopeStatistics {
+        /// память, выделенная через обратные вызовы, без заголовков и выравнивания
+        uint64_t m_bytes         = 0;
+        uint64_t m_peakBytes     = 0;
+        uint64_t m_allocations   = 0;
+        /// память, которую драйвер выделил сам и только сообщил о ней (pfnInternalAllocation)
+        uint64_t m_internalBytes = 0;
+    };
+
+    /**
+     * @brief VkAllocationCallbacks для всех объектов Vulkan, которые создает библиотека, и для VMA.
+     * Каждое выделение драйвера получает заголовок с размером и областью, поэтому учет ведется по областям
+     * VkSystemAllocationScope, а общий объем можно ограничить бюджетом: сверх него драйвер получит
+     * VK_ERROR_OUT_OF_HOST_MEMORY. Бэкенд меняется только пока нет живых выделений, то есть до создания инстанса,
+     * а сам синглтон должен уничтожаться после всех объектов Vulkan.
+     */
+    class DLL_EVK_EXPORT HostAllocator : public Tools::Singleton<HostAllocator> {
+        friend class Tools::Singleton<HostAllocator>;
+
+        struct Header {
+            void*    m_raw;
+            size_t   m_size;
+            size_t   m_rawSize;
+            uint64_t m_scope;
+        };
+
+        struct Scope {
+            std::atomic<uint64_t> m_bytes         = 0;
+            std::atomic<uint64_t> m_peakBytes     = 0;
+            std::atomic<uint64_t> m_allocations   = 0;
+            std::atomic<uint64_t> m_internalBytes = 0;
+        };
+
+        static constexpr uint32_t ScopesCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+    protected:
+        HostAllocator();
+        ~HostAllocator() override = default;
+
+        void OnSingletonDestroy() override;
+
+    public:
+        EVK_NODISCARD const VkAllocationCallbacks* GetCallbacks() const { return &m_callbacks; }
+
+        /// nullptr - стандартный malloc/free. false, если у текущего бэкенда еще есть живые выделения
+        bool SetBackend(HostAllocatorBackend* backend);
+        /// предел памяти драйвера на CPU в байтах, включая внутренние выделения. 0 - без ограничений
+        void SetBudget(uint64_t bytes) { m_budget = bytes; }
+
+        EVK_NODISCARD HostScopeStatistics GetStatistics(VkSystemAllocationScope scope) const;
+        /// вся память драйвера на CPU: выделенная через обратные вызовы и внутренняя
+        EVK_NODISCARD uint64_t GetUsage() const { return m_totalBytes; }
+        EVK_NODISCARD uint64_t GetBudget() const { return m_budget; }
+        EVK_NODISCARD uint64_t GetFailedAllocations() const { return m_failedAllocations; }
+
+        void LogStatistics() const;
+
+    private:
+        void* Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void* Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        void Free(void* memory);
+
+        bool Reserve(size_t size);
+        void Release(size_t size);
+
+        static Header* GetHeader(void* memory);
+        static const char* GetScopeName(VkSystemAllocationScope scope);
+
+        static void* VKAPI_CALL AllocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static void* VKAPI_CALL ReallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope);
+        static void VKAPI_CALL FreeCallback(void* userData, void* memory);
+        static void VKAPI_CALL InternalAllocationCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+        static void VKAPI_CALL InternalFreeCallback(void* userData, size_t size, VkInternalAllocationType type, VkSystemAllocationScope scope);
+
+    private:
+        VkAllocationCallbacks               m_callbacks         = { };
+        HostAllocatorBackend*               m_backend           = nullptr;
+
+        std::array<Scope, ScopesCount>      m_scopes            = { };
+        std::atomic<uint64_t>               m_totalBytes        = 0;
+        std::atomic<uint64_t>               m_liveAllocations   = 0;
+        std::atomic<uint64_t>               m_failedAllocations = 0;
+        std::atomic<uint64_t>               m_budget            = 0;
+
+    };
+
+    /// обратные вызовы для pAllocator всех vkCreate*, vkDestroy*, vkAllocateMemory и vkFreeMemory
+    DLL_EVK_EXPORT const VkAllocationCallbacks* GetAllocationCallbacks();
+}
+
+#endif //EVOVULKAN_HOSTALLOCATOR_H
@@ -0,0 +1,155 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_FORMATUTILS_H
+#define EVOVULKAN_FORMATUTILS_H
+
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Tools {
+    /// Блочные форматы нельзя блитить, поэтому мипы для них должны приходить уже готовыми
+    EVK_MAYBE_UNUSED static bool IsBlockCompressedFormat(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC2_UNORM_BLOCK:
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC4_SNORM_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC5_SNORM_BLOCK:
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    EVK_MAYBE_UNUSED static bool IsFloatFormat(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_R16_SFLOAT:
+            case VK_FORMAT_R16G16_SFLOAT:
+            case VK_FORMAT_R16G16B16_SFLOAT:
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            case VK_FORMAT_R32_SFLOAT:
+            case VK_FORMAT_R32G32_SFLOAT:
+            case VK_FORMAT_R32G32B32_SFLOAT:
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// Размер блока в байтах. Для несжатых форматов блок - это один тексель
+    EVK_MAYBE_UNUSED static uint32_t GetFormatBlockSize(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+            case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+            case VK_FORMAT_BC4_UNORM_BLOCK:
+            case VK_FORMAT_BC4_SNORM_BLOCK:
+                return 8;
+
+            case VK_FORMAT_BC2_UNORM_BLOCK:
+            case VK_FORMAT_BC2_SRGB_BLOCK:
+            case VK_FORMAT_BC3_UNORM_BLOCK:
+            case VK_FORMAT_BC3_SRGB_BLOCK:
+            case VK_FORMAT_BC5_UNORM_BLOCK:
+            case VK_FORMAT_BC5_SNORM_BLOCK:
+            case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+            case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+            case VK_FORMAT_BC7_UNORM_BLOCK:
+            case VK_FORMAT_BC7_SRGB_BLOCK:
+                return 16;
+
+            case VK_FORMAT_R8_UNORM:
+            case VK_FORMAT_R8_SRGB:
+                return 1;
+
+            case VK_FORMAT_R8G8_UNORM:
+            case VK_FORMAT_R8G8_SRGB:
+            case VK_FORMAT_R16_SFLOAT:
+                return 2;
+
+            case VK_FORMAT_R8G8B8_UNORM:
+            case VK_FORMAT_R8G8B8_SRGB:
+                return 3;
+
+            case VK_FORMAT_R8G8B8A8_UNORM:
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_UNORM:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+            case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+            case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+            case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
+            case VK_FORMAT_R16G16_SFLOAT:
+            case VK_FORMAT_R32_SFLOAT:
+                return 4;
+
+            case VK_FORMAT_R16G16B16_SFLOAT:
+                return 6;
+
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+            case VK_FORMAT_R32G32_SFLOAT:
+                return 8;
+
+            case VK_FORMAT_R32G32B32_SFLOAT:
+                return 12;
+
+            case VK_FORMAT_R32G32B32A32_SFLOAT:
+                return 16;
+
+            default:
+                VK_ERROR("Tools::GetFormatBlockSize() : unsupported format! Format: " + std::to_string(format));
+                return 0;
+        }
+    }
+
+    /// Ширина/высота блока в текселях
+    EVK_MAYBE_UNUSED static uint32_t GetFormatBlockExtent(VkFormat format) {
+        return IsBlockCompressedFormat(format) ? 4 : 1;
+    }
+
+    /// Размер одного мип-уровня одного слоя в байтах
+    EVK_MAYBE_UNUSED static VkDeviceSize GetMipLevelSize(VkFormat format, uint32_t width, uint32_t height, uint32_t level) {
+        const uint32_t extent = GetFormatBlockExtent(format);
+
+        const uint32_t levelWidth  = EVK_MAX(width >> level, 1u);
+        const uint32_t levelHeight = EVK_MAX(height >> level, 1u);
+
+        const VkDeviceSize blocksX = (levelWidth + extent - 1) / extent;
+        const VkDeviceSize blocksY = (levelHeight + extent - 1) / extent;
+
+        return blocksX * blocksY * GetFormatBlockSize(format);
+    }
+
+    /// Размер всех мип-уровней всех слоев. Слои идут друг за другом, внутри слоя мипы от большего к меньшему
+    EVK_MAYBE_UNUSED static VkDeviceSize GetImageDataSize(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layers) {
+        VkDeviceSize layerSize = 0;
+
+        for (uint32_t level = 0; level < mipLevels; ++level)
+            layerSize += GetMipLevelSize(format, width, height, level);
+
+        return layerSize * layers;
+    }
+
+    EVK_MAYBE_UNUSED static uint32_t GetMaxMipLevels(uint32_t width, uint32_t height) {
+        return static_cast<uint32_t>(std::floor(std::log2(EVK_MAX(width, height)))) + 1;
+    }
+}
+
+#endif //EVOVULKAN_FORMATUTILS_H
@@ -0,0 +1,21 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_HASHUTILS_H
+#define EVOVULKAN_HASHUTILS_H
+
+#include <EvoVulkan/macros.h>
+
+namespace EvoVulkan::Tools {
+    template<typename T> EVK_INLINE void HashCombine(size_t& seed, const T& value) {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    template<typename T, typename... Args> EVK_INLINE void HashCombine(size_t& seed, const T& value, const Args&... args) {
+        HashCombine(seed, value);
+        HashCombine(seed, args...);
+    }
+}
+
+#endif //EVOVULKAN_HASHUTILS_H
@@ -8,6 +8,7 @@
 #include <EvoVulkan/Tools/VulkanInitializers.h>
 #include <EvoVulkan/Tools/VulkanConverter.h>
 #include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Memory/HostAllocator.h>
 
 #define EVSafeFreeObject(object) \
     if (object) {                \
@@ -19,7 +20,7 @@
 namespace EvoVulkan::Tools {
     static void DestroyFences(const VkDevice& device, const std::vector<VkFence>& fences) {
         for (auto& fence : fences)
-            vkDestroyFence(device, fence, nullptr);
+            vkDestroyFence(device, fence, Memory::GetAllocationCallbacks());
     }
 
     static std::vector<VkFence> CreateFences(const VkDevice& device, uint32_t count) {
@@ -28,7 +29,7 @@ namespace EvoVulkan::Tools {
         // Wait fences to sync command buffer access
         VkFenceCreateInfo fenceCreateInfo = Initializers::FenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
         for (auto& fence : waitFences) {
-            auto result = vkCreateFence(device, &fenceCreateInfo, nullptr, &fence);
+            auto result = vkCreateFence(device, &fenceCreateInfo, Memory::GetAllocationCallbacks(), &fence);
 
             if (result != VK_SUCCESS) {
                 VK_ERROR("Tools::CreateFences() : failed to create vulkan fences!");
@@ -21,6 +21,7 @@
 #include <EvoVulkan/Tools/VulkanConverter.h>
 
 #include <EvoVulkan/Types/VulkanBuffer.h>
+#include <EvoVulkan/Types/SamplerCache.h>
 #include "DeviceTools.h"
 #include "EvoVulkan/Types/Instance.h"
 
@@ -33,8 +34,15 @@ namespace EvoVulkan::Tools {
     DLL_EVK_EXPORT VkShaderModule LoadShaderModule(const char *fileName, VkDevice device);
 
     DLL_EVK_EXPORT VkPipelineLayout CreatePipelineLayout(const VkDevice& device, VkDescriptorSetLayout descriptorSetLayout);
+    DLL_EVK_EXPORT VkPipelineLayout CreatePipelineLayout(
+            const VkDevice& device,
+            const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+            const std::vector<VkPushConstantRange>& pushConstantRanges);
 
-    DLL_EVK_EXPORT VkDescriptorSetLayout CreateDescriptorLayout(const VkDevice& device, const std::vector<VkDescriptorSetLayoutBinding>& setLayoutBindings);
+    DLL_EVK_EXPORT VkDescriptorSetLayout CreateDescriptorLayout(
+            const VkDevice& device,
+            const std::vector<VkDescriptorSetLayoutBinding>& setLayoutBindings,
+            VkDescriptorSetLayoutCreateFlags flags = 0);
 
     Types::Pipeline* CreateStandardGeometryPipeLine(
             const Types::Device* device,
@@ -90,7 +98,7 @@ namespace EvoVulkan::Tools {
         Tools::PopulateDebugMessengerCreateInfo(createInfo);
 
         VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
-        auto result = CreateDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger);
+        auto result = CreateDebugUtilsMessengerEXT(instance, &createInfo, Memory::GetAllocationCallbacks(), &debugMessenger);
         if (result != VK_SUCCESS) {
             VK_ERROR("VulkanTools::SetupDebugMessenger() : failed to set up debug messenger! Reason: "
                 + Tools::Convert::result_to_description(result));
@@ -120,7 +128,8 @@ namespace EvoVulkan::Tools {
             Types::FamilyQueues *pQueues,
             const std::vector<const char *> &extensions,
             const std::vector<const char *> &validLayers,
-            VkPhysicalDeviceFeatures deviceFeatures)
+            VkPhysicalDeviceFeatures deviceFeatures,
+            void* pNextFeatures = nullptr)
     {
         VK_GRAPH("VulkanTools::CreateLogicalDevice() : create vulkan logical device...");
 
@@ -165,7 +174,7 @@ namespace EvoVulkan::Tools {
 
         VkPhysicalDeviceFeatures2 deviceFeatures2 = {};
         deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-        deviceFeatures2.pNext = nullptr; //(void*)&floatFeatures;
+        deviceFeatures2.pNext = pNextFeatures; //(void*)&floatFeatures;
         deviceFeatures2.features = deviceFeatures;
 
         //!=============================================================================================================
@@ -194,7 +203,7 @@ namespace EvoVulkan::Tools {
         }
 
         VkDevice device = VK_NULL_HANDLE;
-        auto result = vkCreateDevice(physicalDevice, &createInfo, nullptr, &device);
+        auto result = vkCreateDevice(physicalDevice, &createInfo, Memory::GetAllocationCallbacks(), &device);
         if (result != VK_SUCCESS) {
             VK_GRAPH("VulkanTools::CreateLogicalDevice() : failed to create logical device! \n\tReason: "
                 + Tools::Convert::result_to_string(result) + "\n\tDescription: " + Tools::Convert::result_to_description(result));
@@ -204,26 +213,41 @@ namespace EvoVulkan::Tools {
         return device;
     }
 
-    static bool CopyBufferToImage(Types::CmdBuffer* copyCmd, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
+    /// слои в буфере идут друг за другом с шагом layerSize, копируется только нулевой мип-уровень
+    static bool CopyBufferToImage(
+            Types::CmdBuffer* copyCmd,
+            VkBuffer buffer,
+            VkImage image,
+            uint32_t width,
+            uint32_t height,
+            uint32_t layerCount = 1,
+            VkDeviceSize layerSize = 0)
+    {
         if (!copyCmd->IsBegin())
             copyCmd->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
-        VkBufferImageCopy region = {};
-        region.bufferOffset      = 0;
-        region.bufferRowLength   = 0;
-        region.bufferImageHeight = 0;
-        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        region.imageSubresource.mipLevel = 0;
-        region.imageSubresource.baseArrayLayer = 0;
-        region.imageSubresource.layerCount = 1;
-        region.imageOffset = {0, 0, 0};
-        region.imageExtent = {
-                width,
-                height,
-                1
-        };
+        std::vector<VkBufferImageCopy> regions(layerCount);
+
+        for (uint32_t layer = 0; layer < layerCount; ++layer) {
+            VkBufferImageCopy& region = regions[layer];
+
+            region.bufferOffset      = layerSize * layer;
+            region.bufferRowLength   = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = layer;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {
+                    width,
+                    height,
+                    1
+            };
+        }
 
-        vkCmdCopyBufferToImage(*copyCmd, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        vkCmdCopyBufferToImage(*copyCmd, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
 
         copyCmd->End();
 
@@ -264,8 +288,9 @@ namespace EvoVulkan::Tools {
         }
         samplerIC.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
 
-        VkSampler sampler = VK_NULL_HANDLE;
-        if (vkCreateSampler(*device, &samplerIC, nullptr, &sampler) != VK_SUCCESS) {
+        /// одинаковые семплеры разделяются через кэш устройства, освобождать через Tools::DestroySampler
+        VkSampler sampler = device->GetSamplerCache()->Acquire(samplerIC);
+        if (sampler == VK_NULL_HANDLE) {
             VK_ERROR("Tools::CreateSampler() : failed to create vulkan sampler!");
             return VK_NULL_HANDLE;
         }
@@ -273,6 +298,17 @@ namespace EvoVulkan::Tools {
         return sampler;
     }
 
+    static void DestroySampler(const Types::Device* device, VkSampler* sampler) {
+        if (*sampler == VK_NULL_HANDLE)
+            return;
+
+        if (!device->GetSamplerCache()->Release(*sampler)) {
+            VK_ERROR("Tools::DestroySampler() : failed to release vulkan sampler!");
+        }
+
+        *sampler = VK_NULL_HANDLE;
+    }
+
     static std::set<std::string> GetSupportedExtensions() {
         uint32_t count;
         vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr); //get number of extensions
@@ -291,22 +327,23 @@ namespace EvoVulkan::Tools {
             VkFormat format,
             uint32_t mipLevels,
             VkImageAspectFlags imageAspectFlags,
-            bool cubeMap = false) {
+            VkImageViewType viewType,
+            uint32_t layerCount) {
         VkImageView view = VK_NULL_HANDLE;
 
         VkImageViewCreateInfo viewCI           = Tools::Initializers::ImageViewCreateInfo();
         viewCI.image                           = image;
-        viewCI.viewType                        = cubeMap ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D;
+        viewCI.viewType                        = viewType;
         viewCI.format                          = format;
         viewCI.components                      = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
         //viewCI.components                      = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
         viewCI.subresourceRange.aspectMask     = imageAspectFlags; //VK_IMAGE_ASPECT_COLOR_BIT;
         viewCI.subresourceRange.baseMipLevel   = 0;
         viewCI.subresourceRange.baseArrayLayer = 0;
-        viewCI.subresourceRange.layerCount     = cubeMap ? 6 : 1;
+        viewCI.subresourceRange.layerCount     = layerCount;
         viewCI.subresourceRange.levelCount     = mipLevels;
 
-        if (vkCreateImageView(device, &viewCI, nullptr, &view) != VK_SUCCESS) {
+        if (vkCreateImageView(device, &viewCI, Memory::GetAllocationCallbacks(), &view) != VK_SUCCESS) {
             VK_ERROR("Tools::CreateImageView() : failed to create image view!");
             return VK_NULL_HANDLE;
         }
@@ -314,6 +351,17 @@ namespace EvoVulkan::Tools {
         return view;
     }
 
+    static VkImageView CreateImageView(
+            const VkDevice& device,
+            VkImage image,
+            VkFormat format,
+            uint32_t mipLevels,
+            VkImageAspectFlags imageAspectFlags,
+            bool cubeMap = false) {
+        return CreateImageView(device, image, format, mipLevels, imageAspectFlags,
+                               cubeMap ? VK_IMAGE_VIEW_TYPE_CUBE : VK_IMAGE_VIEW_TYPE_2D, cubeMap ? 6 : 1);
+    }
+
     /*
     static VkImage CreateImage(
             Types::Device* device,
@@ -350,7 +398,7 @@ namespace EvoVulkan::Tools {
             imageInfo.flags = createFlagBits;
 
         VkImage image = VK_NULL_HANDLE;
-        if (vkCreateImage(*device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        if (vkCreateImage(*device, &imageInfo, Memory::GetAllocationCallbacks(), &image) != VK_SUCCESS) {
             VK_ERROR("Tools::CreateImage() : failed to create vulkan image!");
             return VK_NULL_HANDLE;
         }
@@ -463,7 +511,8 @@ namespace EvoVulkan::Tools {
             const std::vector<const char*>& validationLayers,
             const bool& enableSampleShading,
             bool multisampling,
-            uint32_t sampleCount)
+            uint32_t sampleCount,
+            bool descriptorBuffer = false)
     {
         VK_GRAPH("VulkanTools::CreateDevice() : create vulkan device...");
 
@@ -528,12 +577,148 @@ namespace EvoVulkan::Tools {
         deviceFeatures.textureCompressionBC       = true;
         //deviceFeatures.textureCompressionETC2     = true;
 
+        Types::DeviceFeatures features = {};
+        void* pNextFeatures = nullptr;
+
+        //!=============================================================================================================
+
+        /// структура descriptor indexing входит в ядро только с Vulkan 1.2, до этого ее нельзя передавать в запрос
+        if (Tools::GetDeviceProperties(physicalDevice).apiVersion >= VK_API_VERSION_1_2) {
+            VkPhysicalDeviceDescriptorIndexingFeatures supportedIndexing = {};
+            supportedIndexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+            VkPhysicalDeviceFeatures2 supportedFeatures = {};
+            supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            supportedFeatures.pNext = &supportedIndexing;
+
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+
+            features.m_descriptorIndexing =
+                    supportedIndexing.shaderSampledImageArrayNonUniformIndexing &&
+                    supportedIndexing.runtimeDescriptorArray &&
+                    supportedIndexing.descriptorBindingPartiallyBound &&
+                    supportedIndexing.descriptorBindingSampledImageUpdateAfterBind &&
+                    supportedIndexing.descriptorBindingUpdateUnusedWhilePending;
+        }
+
+        VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+        if (features.m_descriptorIndexing) {
+            indexingFeatures.shaderSampledImageArrayNonUniformIndexing    = VK_TRUE;
+            indexingFeatures.runtimeDescriptorArray                       = VK_TRUE;
+            indexingFeatures.descriptorBindingPartiallyBound              = VK_TRUE;
+            indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            indexingFeatures.descriptorBindingUpdateUnusedWhilePending    = VK_TRUE;
+            indexingFeatures.pNext = pNextFeatures;
+            pNextFeatures = &indexingFeatures;
+        }
+        else
+            VK_WARN("VulkanTools::CreateDevice() : descriptor indexing isn't supported, bindless textures are disabled!");
+
+        //!=============================================================================================================
+
+        /// необязательные расширения включаются, только если устройство их поддерживает
+        std::vector<const char*> enabledExtensions = extensions;
+
+        auto&& enableOptional = [&enabledExtensions, physicalDevice](const char* name) -> bool {
+            for (auto&& extension : enabledExtensions) {
+                if (strcmp(extension, name) == 0)
+                    return true;
+            }
+
+            if (!Tools::CheckDeviceExtensionSupport(physicalDevice, { name })) {
+                VK_LOG("VulkanTools::CreateDevice() : optional extension \"" + std::string(name) + "\" isn't supported.");
+                return false;
+            }
+
+            enabledExtensions.emplace_back(name);
+
+            return true;
+        };
+
+        features.m_pushDescriptors = enableOptional(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+
+        //!=============================================================================================================
+
+        VkPhysicalDeviceBufferDeviceAddressFeatures addressFeatures = {};
+        addressFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures = {};
+        descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+        /// структуру расширения можно передавать в запрос, только если устройство его поддерживает
+        if (descriptorBuffer && Tools::GetDeviceProperties(physicalDevice).apiVersion >= VK_API_VERSION_1_2 &&
+            Tools::CheckDeviceExtensionSupport(physicalDevice, { VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME }))
+        {
+            VkPhysicalDeviceDescriptorBufferFeaturesEXT supportedDescriptorBuffer = {};
+            supportedDescriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+            VkPhysicalDeviceBufferDeviceAddressFeatures supportedAddress = {};
+            supportedAddress.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_BUFFER_DEVICE_ADDRESS_FEATURES;
+            supportedAddress.pNext = &supportedDescriptorBuffer;
+
+            VkPhysicalDeviceFeatures2 supportedBufferFeatures = {};
+            supportedBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            supportedBufferFeatures.pNext = &supportedAddress;
+
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedBufferFeatures);
+
+            features.m_descriptorBuffer = supportedDescriptorBuffer.descriptorBuffer && supportedAddress.bufferDeviceAddress;
+        }
+
+        if (features.m_descriptorBuffer && enableOptional(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) {
+            descriptorBufferFeatures.descriptorBuffer = VK_TRUE;
+            addressFeatures.bufferDeviceAddress       = VK_TRUE;
+
+            descriptorBufferFeatures.pNext = pNextFeatures;
+            addressFeatures.pNext = &descriptorBufferFeatures;
+            pNextFeatures = &addressFeatures;
+        }
+        else if (descriptorBuffer) {
+            features.m_descriptorBuffer = false;
+            VK_WARN("VulkanTools::CreateDevice() : descriptor buffer isn't supported, descriptor pools will be used!");
+        }
+
+        //!=============================================================================================================
+
+        VkPhysicalDeviceInlineUniformBlockFeaturesEXT inlineBlockFeatures = {};
+        inlineBlockFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_FEATURES_EXT;
+
+        /// vkGetPhysicalDeviceFeatures2 есть только начиная с Vulkan 1.1
+        if (Tools::GetDeviceProperties(physicalDevice).apiVersion >= VK_API_VERSION_1_1 &&
+            Tools::CheckDeviceExtensionSupport(physicalDevice, { VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME }))
+        {
+            VkPhysicalDeviceInlineUniformBlockFeaturesEXT supportedInlineBlock = {};
+            supportedInlineBlock.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2 supportedInlineFeatures = {};
+            supportedInlineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            supportedInlineFeatures.pNext = &supportedInlineBlock;
+
+            vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedInlineFeatures);
+
+            features.m_inlineUniformBlock = supportedInlineBlock.inlineUniformBlock &&
+                    enableOptional(VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME);
+        }
+
+        if (features.m_inlineUniformBlock) {
+            inlineBlockFeatures.inlineUniformBlock = VK_TRUE;
+            inlineBlockFeatures.pNext = pNextFeatures;
+            pNextFeatures = &inlineBlockFeatures;
+        }
+        else
+            VK_LOG("VulkanTools::CreateDevice() : inline uniform blocks aren't supported.");
+
+        //!=============================================================================================================
+
         logicalDevice = Tools::CreateLogicalDevice(
                 physicalDevice,
                 queues,
-                extensions,
+                enabledExtensions,
                 validationLayers,
-                deviceFeatures);
+                deviceFeatures,
+                pNextFeatures);
 
         if (logicalDevice == VK_NULL_HANDLE) {
             VK_ERROR("VulkanTools::CreateDevice() : failed create logical device!");
@@ -559,7 +744,8 @@ namespace EvoVulkan::Tools {
                 queues,
                 enableSampleShading,
                 multisampling,
-                static_cast<int32_t>(sampleCount)
+                static_cast<int32_t>(sampleCount),
+                features
         };
 
         if (auto finallyDevice = Types::Device::Create(createInfo)) {
@@ -27,6 +27,7 @@ namespace EvoVulkan::Types {
         };
     };
 
+    /// Allocate, Free и Reset синхронизированы внутри пула, поэтому сет можно вернуть из любого потока
     class DLL_EVK_EXPORT DescriptorPool : public Tools::NonCopyable {
         using RequestTypes = std::set<VkDescriptorType>;
     public:
@@ -39,22 +40,45 @@ namespace EvoVulkan::Types {
         operator VkDescriptorPool() const { return m_pool; }
 
     public:
-        static DescriptorPool* Create(VkDevice device, uint32_t maxSets, std::vector<VkDescriptorPoolSize> sizes);
-        static DescriptorPool* Create(VkDevice device, uint32_t maxSets, VkDescriptorSetLayout layout, const RequestTypes& requestTypes);
+        /// без FREE_DESCRIPTOR_SET_BIT сеты освобождаются только сбросом всего пула
+        static DescriptorPool* Create(VkDevice device, uint32_t maxSets, std::vector<VkDescriptorPoolSize> sizes,
+                                      VkDescriptorPoolCreateFlags flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
+        /// если sizes пустой, размеры считаются по множителям из PoolSizes.
+        /// Для inline uniform block размер в sizes задается в байтах, а inlineBlockBindings - общее число таких биндингов в пуле
+        static DescriptorPool* Create(VkDevice device, uint32_t maxSets, VkDescriptorSetLayout layout, const RequestTypes& requestTypes,
+                                      const std::vector<VkDescriptorPoolSize>& sizes = { }, uint32_t inlineBlockBindings = 0);
         static bool Contains(const std::set<VkDescriptorType>& types, const VkDescriptorType& type);
+        /// битовая маска типов, чтобы не сравнивать множества при каждом поиске пула
+        static uint64_t GetTypeMask(const RequestTypes& requestTypes);
 
     public:
         std::pair<VkResult, DescriptorSet> Allocate();
+        /// для пулов без привязки к лейауту
+        std::pair<VkResult, DescriptorSet> Allocate(VkDescriptorSetLayout layout);
         VkResult Free(VkDescriptorSet set);
+        /// возвращает все сеты пулу разом, сеты не должны использоваться GPU
+        VkResult Reset();
 
         bool Equal(const std::set<VkDescriptorType>& requestTypes);
+        EVK_NODISCARD bool Equal(uint64_t typeMask) const { return m_typeMask == typeMask; }
 
         EVK_NODISCARD bool IsOutOfMemory() const;
         EVK_NODISCARD uint32_t GetUsageCount() const { return m_used; }
+        EVK_NODISCARD uint32_t GetMaxSets() const { return m_maxSets; }
         EVK_NODISCARD VkDescriptorSetLayout GetLayout() const { return m_layout; }
+        EVK_NODISCARD uint64_t GetTypeMask() const { return m_typeMask; }
+        /// уникален за все время работы, в отличие от адреса, который может достаться новому пулу
+        EVK_NODISCARD uint64_t GetId() const { return m_id; }
+        EVK_NODISCARD bool IsFreeable() const { return m_flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; }
 
     private:
+        static uint64_t GenerateId();
+
+    private:
+        const uint64_t             m_id             = GenerateId();
+
         std::set<VkDescriptorType> m_requestTypes   = std::set<VkDescriptorType>();
+        uint64_t                   m_typeMask       = 0;
         PoolSizes                  m_poolSizes      = PoolSizes();
 
         /// for check equal alloc request (reference)
@@ -63,9 +87,13 @@ namespace EvoVulkan::Types {
         VkDevice                   m_device         = VK_NULL_HANDLE;
         VkDescriptorPool           m_pool           = VK_NULL_HANDLE;
 
-        uint32_t                   m_used           = 0;
+        VkDescriptorPoolCreateFlags m_flags         = 0;
+
+        std::atomic<uint32_t>      m_used           = 0;
         const uint32_t             m_maxSets        = 0;
-        bool                       m_outOfMemory    = false;
+        std::atomic<bool>          m_outOfMemory    = false;
+
+        std::mutex                 m_mutex          = std::mutex();
 
     };
 }
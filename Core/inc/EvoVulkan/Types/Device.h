@@ -11,6 +11,7 @@
 #include <EvoVulkan/Tools/VulkanHelper.h>
 #include <EvoVulkan/Types/FamilyQueues.h>
 #include <EvoVulkan/Types/Instance.h>
+#include <EvoVulkan/Types/Features.h>
 
 #include <EvoVulkan/Tools/NonCopyable.h>
 
@@ -20,6 +21,8 @@ namespace EvoVulkan::Memory {
 
 namespace EvoVulkan::Types {
     class Device;
+    class SamplerCache;
+    class LayoutCache;
 
     struct DLL_EVK_EXPORT EvoDeviceCreateInfo {
         VkPhysicalDevice physicalDevice;
@@ -29,6 +32,20 @@ namespace EvoVulkan::Types {
         bool enableSampleShading;
         bool multisampling;
         int32_t sampleCount;
+        DeviceFeatures features;
+    };
+
+    /// функции VK_EXT_descriptor_buffer, загружаются только если расширение включено
+    struct DLL_EVK_EXPORT DescriptorBufferFunctions {
+        PFN_vkGetDescriptorSetLayoutSizeEXT          m_getLayoutSize       = nullptr;
+        PFN_vkGetDescriptorSetLayoutBindingOffsetEXT m_getBindingOffset    = nullptr;
+        PFN_vkGetDescriptorEXT                       m_getDescriptor       = nullptr;
+        PFN_vkCmdBindDescriptorBuffersEXT            m_cmdBindBuffers      = nullptr;
+        PFN_vkCmdSetDescriptorBufferOffsetsEXT       m_cmdSetBufferOffsets = nullptr;
+
+        EVK_NODISCARD bool Valid() const {
+            return m_getLayoutSize && m_getBindingOffset && m_getDescriptor && m_cmdBindBuffers && m_cmdSetBufferOffsets;
+        }
     };
 
     class DLL_EVK_EXPORT Device : public Tools::NonCopyable {
@@ -58,6 +75,18 @@ namespace EvoVulkan::Types {
         EVK_NODISCARD EVK_INLINE VkPhysicalDeviceMemoryProperties GetMemoryProperties() const { return m_memoryProperties; }
 
         EVK_NODISCARD FamilyQueues* GetQueues() const;
+        EVK_NODISCARD SamplerCache* GetSamplerCache() const { return m_samplerCache; }
+        EVK_NODISCARD LayoutCache* GetLayoutCache() const { return m_layoutCache; }
+        EVK_NODISCARD const DeviceFeatures& GetFeatures() const { return m_features; }
+        EVK_NODISCARD uint32_t GetMaxBindlessTextures() const { return m_maxBindlessTextures; }
+        EVK_NODISCARD uint32_t GetMaxPushDescriptors() const { return m_maxPushDescriptors; }
+        EVK_NODISCARD uint32_t GetMaxInlineUniformBlockSize() const { return m_maxInlineUniformBlockSize; }
+        EVK_NODISCARD VkDeviceSize GetMinUniformBufferOffsetAlignment() const { return m_minUniformBufferOffsetAlignment; }
+        EVK_NODISCARD VkDeviceSize GetNonCoherentAtomSize() const { return m_nonCoherentAtomSize; }
+        EVK_NODISCARD PFN_vkCmdPushDescriptorSetKHR GetCmdPushDescriptorSet() const { return m_cmdPushDescriptorSet; }
+        EVK_NODISCARD PFN_vkCmdPushDescriptorSetWithTemplateKHR GetCmdPushDescriptorSetWithTemplate() const { return m_cmdPushDescriptorSetWithTemplate; }
+        EVK_NODISCARD const DescriptorBufferFunctions& GetDescriptorBufferFunctions() const { return m_descriptorBufferFunctions; }
+        EVK_NODISCARD const VkPhysicalDeviceDescriptorBufferPropertiesEXT& GetDescriptorBufferProperties() const { return m_descriptorBufferProperties; }
         EVK_NODISCARD bool IsReady() const;
         EVK_NODISCARD bool IsSupportLinearBlitting(const VkFormat& imageFormat) const;
         EVK_NODISCARD VkCommandPool CreateCommandPool(VkCommandPoolCreateFlags flagBits) const;
@@ -71,11 +100,35 @@ namespace EvoVulkan::Types {
         VkDevice                         m_logicalDevice           = VK_NULL_HANDLE;
         Types::Instance*                 m_instance                = nullptr;
 
+        /// общие для всего устройства семплеры, дедуплицируются по VkSamplerCreateInfo
+        SamplerCache*                    m_samplerCache            = nullptr;
+        /// лейауты сетов и пайплайнов, дедуплицируются по биндингам и push constant диапазонам
+        LayoutCache*                     m_layoutCache             = nullptr;
+
         bool                             m_enableSamplerAnisotropy = false;
         float_t                          m_maxSamplerAnisotropy    = 0.f;
 
         VkPhysicalDeviceMemoryProperties m_memoryProperties        = {};
 
+        DeviceFeatures                   m_features                = {};
+        /// максимальный размер update after bind массива комбинированных семплеров
+        uint32_t                         m_maxBindlessTextures     = 0;
+        uint32_t                         m_maxPushDescriptors      = 0;
+        /// в байтах, для одного биндинга
+        uint32_t                         m_maxInlineUniformBlockSize = 0;
+        /// выравнивание смещений uniform буферов, в том числе динамических
+        VkDeviceSize                     m_minUniformBufferOffsetAlignment = 0;
+        /// гранулярность flush/invalidate для non-coherent памяти
+        VkDeviceSize                     m_nonCoherentAtomSize     = 0;
+
+        /// функции расширений не экспортируются загрузчиком, берем их через vkGetDeviceProcAddr
+        PFN_vkCmdPushDescriptorSetKHR             m_cmdPushDescriptorSet             = nullptr;
+        PFN_vkCmdPushDescriptorSetWithTemplateKHR m_cmdPushDescriptorSetWithTemplate = nullptr;
+
+        DescriptorBufferFunctions                     m_descriptorBufferFunctions  = {};
+        /// размеры дескрипторов каждого типа и выравнивание смещений в буфере
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT m_descriptorBufferProperties = {};
+
         std::string                      m_deviceName              = "Unknown";
 
         /// don't use for VkAttachmentDescription
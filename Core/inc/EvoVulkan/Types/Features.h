@@ -5,4 +5,20 @@
 #ifndef EVOVULKAN_FEATURES_H
 #define EVOVULKAN_FEATURES_H
 
+#include <EvoVulkan/macros.h>
+
+namespace EvoVulkan::Types {
+    /// Необязательные возможности, которые были включены при создании логического устройства
+    struct DLL_EVK_EXPORT DeviceFeatures {
+        /// Vulkan 1.2 descriptor indexing: partially bound и update after bind массивы текстур
+        bool m_descriptorIndexing = false;
+        /// VK_KHR_push_descriptor: сеты пишутся прямо в командный буфер, без пулов
+        bool m_pushDescriptors    = false;
+        /// VK_EXT_descriptor_buffer: дескрипторы пишутся в буфер и привязываются по смещению
+        bool m_descriptorBuffer   = false;
+        /// VK_EXT_inline_uniform_block: маленькие константы хранятся прямо в сете, без буфера
+        bool m_inlineUniformBlock = false;
+    };
+}
+
 #endif //EVOVULKAN_FEATURES_H
@@ -9,6 +9,7 @@
 
 namespace EvoVulkan::Memory {
     class Allocator;
+    class AliasingPool;
 }
 
 namespace EvoVulkan::Types {
@@ -59,15 +60,22 @@ namespace EvoVulkan::Types {
         bool multisampling = true;
         VkImageCreateFlagBits createFlagBits = VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM;
         uint32_t arrayLayers = 1;
+        VkImageType imageType = VK_IMAGE_TYPE_2D;
+        /// only for VK_IMAGE_TYPE_3D
+        uint32_t depth = 1;
         bool CPUUsage = false;
+        Memory::MemoryPool pool = Memory::MemoryPool::Default;
 
         EVK_NODISCARD bool Valid() const {
             return width > 0 && height > 0 && device && allocator;
         }
+
+        EVK_NODISCARD VkImageCreateInfo ToVulkanCreateInfo() const;
     };
 
     class DLL_EVK_EXPORT Image : public Tools::NonCopyable {
         friend class Memory::Allocator;
+        friend class Memory::AliasingPool;
     public:
         Image() = default;
         ~Image() override = default;
@@ -76,12 +84,14 @@ namespace EvoVulkan::Types {
             m_image = std::exchange(image.m_image, {});
             m_allocation = std::exchange(image.m_allocation, {});
             m_allocator = std::exchange(image.m_allocator, {});
+            m_aliased = std::exchange(image.m_aliased, {});
         }
 
         Image& operator=(Image&& image) noexcept {
             m_image = std::exchange(image.m_image, {});
             m_allocation = std::exchange(image.m_allocation, {});
             m_allocator = std::exchange(image.m_allocator, {});
+            m_aliased = std::exchange(image.m_aliased, {});
 
             return *this;
         }
@@ -93,6 +103,8 @@ namespace EvoVulkan::Types {
 
         EVK_NODISCARD Image Copy() const;
         EVK_NODISCARD bool Valid() const;
+        /// память принадлежит AliasingPool, а аллокация - общий блок, освобождать через пул
+        EVK_NODISCARD bool IsAliased() const { return m_aliased; }
 
         operator VkImage() const { return m_image; }
 
@@ -100,6 +112,7 @@ namespace EvoVulkan::Types {
         VkImage m_image            = VK_NULL_HANDLE;
         VmaAllocation m_allocation = VK_NULL_HANDLE;
         VmaAllocator m_allocator   = VK_NULL_HANDLE;
+        bool m_aliased             = false;
 
     };
 }
@@ -0,0 +1,100 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_LAYOUTCACHE_H
+#define EVOVULKAN_LAYOUTCACHE_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Types {
+    struct DLL_EVK_EXPORT SetLayoutBindingKey {
+        uint32_t               binding         = 0;
+        VkDescriptorType       descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLER;
+        uint32_t               descriptorCount = 0;
+        VkShaderStageFlags     stageFlags      = 0;
+        std::vector<VkSampler> immutableSamplers;
+
+        bool operator==(const SetLayoutBindingKey& other) const;
+    };
+
+    /// Биндинги отсортированы по номеру, поэтому порядок объявления в шейдере на ключ не влияет
+    struct DLL_EVK_EXPORT SetLayoutKey {
+        VkDescriptorSetLayoutCreateFlags flags = 0;
+        std::vector<SetLayoutBindingKey> bindings;
+
+        SetLayoutKey() = default;
+        SetLayoutKey(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, VkDescriptorSetLayoutCreateFlags createFlags);
+
+        bool operator==(const SetLayoutKey& other) const;
+    };
+
+    struct DLL_EVK_EXPORT PipelineLayoutKey {
+        std::vector<VkDescriptorSetLayout> setLayouts;
+        std::vector<VkPushConstantRange>   pushConstants;
+
+        bool operator==(const PipelineLayoutKey& other) const;
+    };
+
+    struct DLL_EVK_EXPORT SetLayoutKeyHash {
+        size_t operator()(const SetLayoutKey& key) const;
+    };
+
+    struct DLL_EVK_EXPORT PipelineLayoutKeyHash {
+        size_t operator()(const PipelineLayoutKey& key) const;
+    };
+
+    /**
+     * @brief Общие для устройства лейауты сетов и пайплайнов.
+     * Шейдеры с одинаковым интерфейсом получают одни и те же хендлы,
+     * а значит и общие пулы дескрипторов в DescriptorManager.
+     */
+    class DLL_EVK_EXPORT LayoutCache : public Tools::NonCopyable {
+        template<typename Key> struct Entry {
+            Key      m_key;
+            uint32_t m_references;
+        };
+    private:
+        LayoutCache() = default;
+        ~LayoutCache() override = default;
+
+    public:
+        static LayoutCache* Create(VkDevice device);
+
+    public:
+        /// возвращает общий лейаут для данных биндингов, увеличивая счетчик ссылок
+        VkDescriptorSetLayout AcquireSetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings,
+                                               VkDescriptorSetLayoutCreateFlags flags = 0);
+        /// уменьшает счетчик ссылок, лейаут уничтожается когда ссылок не осталось.
+        /// onDestroy вызывается под блокировкой кэша перед уничтожением, поэтому параллельный Acquire
+        /// того же лейаута не может вклиниться между последней ссылкой и очисткой связанных с ним данных
+        bool ReleaseSetLayout(VkDescriptorSetLayout layout, const std::function<void(VkDescriptorSetLayout)>& onDestroy = nullptr);
+
+        VkPipelineLayout AcquirePipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                               const std::vector<VkPushConstantRange>& pushConstants = { });
+        bool ReleasePipelineLayout(VkPipelineLayout layout);
+
+        /// 0, если лейаут создан не этим кэшем
+        EVK_NODISCARD uint32_t GetReferences(VkDescriptorSetLayout layout) const;
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD uint32_t GetSetLayoutsCount() const;
+        EVK_NODISCARD uint32_t GetPipelineLayoutsCount() const;
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+
+        std::unordered_map<SetLayoutKey, VkDescriptorSetLayout, SetLayoutKeyHash>  m_setLayouts      = { };
+        std::unordered_map<VkDescriptorSetLayout, Entry<SetLayoutKey>>             m_setEntries      = { };
+
+        std::unordered_map<PipelineLayoutKey, VkPipelineLayout, PipelineLayoutKeyHash> m_pipelineLayouts = { };
+        std::unordered_map<VkPipelineLayout, Entry<PipelineLayoutKey>>                 m_pipelineEntries = { };
+
+        mutable std::mutex m_mutex = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_LAYOUTCACHE_H
@@ -8,10 +8,7 @@
 #include <EvoVulkan/Types/Device.h>
 #include <EvoVulkan/Types/Swapchain.h>
 #include <EvoVulkan/Types/Image.h>
-
-namespace EvoVulkan::Memory {
-    class Allocator;
-}
+#include <EvoVulkan/Memory/AliasingPool.h>
 
 namespace EvoVulkan::Types {
     class DLL_EVK_EXPORT MultisampleTarget : public Tools::NonCopyable {
@@ -31,7 +28,9 @@ namespace EvoVulkan::Types {
                 Swapchain* swapchain,
                 uint32_t w, uint32_t h,
                 const std::vector<VkFormat>& formats,
-                bool multisampling);
+                bool multisampling,
+                Memory::AliasingPool* aliasingPool = nullptr,
+                uint32_t pass = 0);
 
     public:
         void Destroy();
@@ -44,12 +43,20 @@ namespace EvoVulkan::Types {
         EVK_NODISCARD VkImageView GetDepth() const noexcept { return m_depth.m_view; }
         EVK_NODISCARD uint32_t GetResolveCount() const noexcept { return m_countResolves; }
 
+    private:
+        Types::Image CreateTransientImage(const ImageCreateInfo& info) const;
+        void FreeTransientImage(Types::Image& image) const;
+
     private:
         Device*            m_device    = nullptr;
         Memory::Allocator* m_allocator = nullptr;
         Swapchain*         m_swapchain = nullptr;
         Types::CmdPool*    m_cmdPool   = nullptr;
 
+        /// без lazily allocated памяти transient вложения делят память с вложениями других проходов
+        Memory::AliasingPool* m_aliasingPool = nullptr;
+        uint32_t              m_pass         = 0;
+
         bool m_multisampling = true;
 
         uint32_t m_countResolves = 0;
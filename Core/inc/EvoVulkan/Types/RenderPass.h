@@ -25,7 +25,7 @@ namespace EvoVulkan::Types {
         VK_LOG("Tools::DestroyRenderPass() : destroy vulkan render pass...");
 
         if (renderPass->Ready()) {
-            vkDestroyRenderPass(*device, renderPass->m_self, nullptr);
+            vkDestroyRenderPass(*device, renderPass->m_self, Memory::GetAllocationCallbacks());
             renderPass->m_self = VK_NULL_HANDLE;
             renderPass->m_countAttachments = 0;
             renderPass->m_countColorAttach = 0;
@@ -50,7 +50,8 @@ namespace EvoVulkan::Types {
             attachments[0].format = swapchain->GetColorFormat();
             attachments[0].samples = device->GetMSAASamples();
             attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            // With multisampling only the resolved image is needed after the pass
+            attachments[0].storeOp = multisampling ? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
             attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -83,7 +84,7 @@ namespace EvoVulkan::Types {
                 attachments[1].format = swapchain->GetDepthFormat();
                 attachments[1].samples = device->GetMSAASamples();
                 attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-                attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+                attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
                 attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
                 attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
                 attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -98,6 +99,9 @@ namespace EvoVulkan::Types {
             for (uint32_t i = 0; i < attachments.size() - (depth ? 1 : 0); i++) {
                 colorReferences.push_back({i, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
                 if (multisampling) {
+                    // transient multisampled image, its content is resolved and then dropped
+                    attachments[i].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
                     VkAttachmentDescription attachmentDescription = {
                             .flags = 0,
                             .format = attachments[i].format,
@@ -163,7 +167,7 @@ namespace EvoVulkan::Types {
         renderPassInfo.pDependencies = dependencies.data();
 
         VkRenderPass renderPass = VK_NULL_HANDLE;
-        auto result = vkCreateRenderPass(*device, &renderPassInfo, nullptr, &renderPass);
+        auto result = vkCreateRenderPass(*device, &renderPassInfo, Memory::GetAllocationCallbacks(), &renderPass);
         if (result != VK_SUCCESS) {
             VK_ERROR("Types::CreateRenderPass() : failed to create vulkan render pass! Reason: " +
                      Tools::Convert::result_to_description(result));
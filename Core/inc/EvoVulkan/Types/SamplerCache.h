@@ -0,0 +1,76 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_SAMPLERCACHE_H
+#define EVOVULKAN_SAMPLERCACHE_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Types {
+    /// Полное состояние VkSamplerCreateInfo без pNext, по нему семплеры и дедуплицируются
+    struct DLL_EVK_EXPORT SamplerKey {
+        VkSamplerCreateFlags flags                   = 0;
+        VkFilter             magFilter               = VK_FILTER_NEAREST;
+        VkFilter             minFilter               = VK_FILTER_NEAREST;
+        VkSamplerMipmapMode  mipmapMode              = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        VkSamplerAddressMode addressModeU            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        VkSamplerAddressMode addressModeV            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        VkSamplerAddressMode addressModeW            = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        float_t              mipLodBias              = 0.f;
+        VkBool32             anisotropyEnable        = VK_FALSE;
+        float_t              maxAnisotropy           = 0.f;
+        VkBool32             compareEnable           = VK_FALSE;
+        VkCompareOp          compareOp               = VK_COMPARE_OP_NEVER;
+        float_t              minLod                  = 0.f;
+        float_t              maxLod                  = 0.f;
+        VkBorderColor        borderColor             = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+        VkBool32             unnormalizedCoordinates = VK_FALSE;
+
+        SamplerKey() = default;
+        explicit SamplerKey(const VkSamplerCreateInfo& info);
+
+        bool operator==(const SamplerKey& other) const;
+
+        EVK_NODISCARD VkSamplerCreateInfo ToCreateInfo() const;
+    };
+
+    struct DLL_EVK_EXPORT SamplerKeyHash {
+        size_t operator()(const SamplerKey& key) const;
+    };
+
+    class DLL_EVK_EXPORT SamplerCache : public Tools::NonCopyable {
+        struct Entry {
+            SamplerKey m_key;
+            uint32_t   m_references;
+        };
+    private:
+        SamplerCache() = default;
+        ~SamplerCache() override = default;
+
+    public:
+        static SamplerCache* Create(VkDevice device);
+
+    public:
+        /// возвращает общий семплер для данного состояния, увеличивая счетчик ссылок
+        VkSampler Acquire(const VkSamplerCreateInfo& info);
+        /// уменьшает счетчик ссылок, семплер уничтожается когда ссылок не осталось
+        bool Release(VkSampler sampler);
+
+        void Destroy();
+        void Free();
+
+        EVK_NODISCARD uint32_t GetSamplersCount() const;
+
+    private:
+        VkDevice                                                  m_device   = VK_NULL_HANDLE;
+
+        std::unordered_map<SamplerKey, VkSampler, SamplerKeyHash> m_samplers = { };
+        std::unordered_map<VkSampler, Entry>                      m_entries  = { };
+
+        mutable std::mutex                                        m_mutex    = std::mutex();
+
+    };
+}
+
+#endif //EVOVULKAN_SAMPLERCACHE_H
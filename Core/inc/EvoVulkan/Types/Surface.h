@@ -20,6 +20,7 @@ namespace EvoVulkan::Types {
         ~Surface() override = default;
 
     public:
+        /// surfaceKhr должен быть создан с Memory::GetAllocationCallbacks(), с ними же он и уничтожается
         static Surface* Create(const VkSurfaceKHR& surfaceKhr, const VkInstance& instance, void* windowHandle);
 
         operator VkSurfaceKHR() const { return m_surface; }
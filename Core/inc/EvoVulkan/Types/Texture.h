@@ -29,7 +29,17 @@ namespace EvoVulkan::Types {
     class Device;
     class CmdPool;
 
-    class DLL_EVK_EXPORT Texture : public Tools::NonCopyable {
+    /// прямоугольник одного слоя для пакетной загрузки через Texture::CopyRegions
+    struct DLL_EVK_EXPORT TextureRegion {
+        const uint8_t* m_pixels = nullptr;
+        uint32_t       m_layer  = 0;
+        uint32_t       m_x      = 0;
+        uint32_t       m_y      = 0;
+        uint32_t       m_width  = 0;
+        uint32_t       m_height = 0;
+    };
+
+    class DLL_EVK_EXPORT Texture : public Tools::NonCopyable, public Memory::Relocatable {
         friend class EvoVulkan::Complexes::FrameBuffer;
     private:
         Texture() = default;
@@ -41,6 +51,7 @@ namespace EvoVulkan::Types {
         static Texture* LoadCubeMap(
                 Device* device,
                 Memory::Allocator *allocator,
+                Core::DescriptorManager* manager,
                 CmdPool* pool,
                 VkFormat format,
                 int32_t width,
@@ -88,12 +99,48 @@ namespace EvoVulkan::Types {
             return Load(device, allocator, manager, pool, pixels, format, width, height, 1, filter, cpuUsage);
         }
 
+        /// слои в pixels идут друг за другом, каждый слой - только нулевой мип-уровень
+        static Texture* LoadArray(
+                Device *device,
+                Memory::Allocator *allocator,
+                Core::DescriptorManager* manager,
+                CmdPool *pool,
+                const std::vector<const uint8_t*>& layers,
+                VkFormat format,
+                int32_t width, int32_t height,
+                uint32_t mipLevels, VkFilter filter,
+                bool cpuUsage = false);
+
+        /// пустой массив текстур без мипов, заполняется по частям через CopyRegion
+        static Texture* CreateArray(
+                Device *device,
+                Memory::Allocator *allocator,
+                Core::DescriptorManager* manager,
+                CmdPool *pool,
+                VkFormat format,
+                int32_t width, int32_t height,
+                uint32_t layers, VkFilter filter);
+
     public:
         void RandomizeSeed();
 
+        /// копирует пиксели в прямоугольник одного слоя, только для текстур без мипов
+        bool CopyRegion(const uint8_t* pixels, uint32_t layer, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+        /// все прямоугольники загружаются через один staging буфер и одну отправку команд
+        bool CopyRegions(const std::vector<TextureRegion>& regions);
+
         void Destroy();
         void Free();
 
+        /// разрешает дефрагментации переносить текстуру. Вызывать, только если все сеты с этой текстурой
+        /// получены через DescriptorCache, а остальные дескрипторы обновляются через AddRelocationListener
+        bool EnableRelocation();
+
+        /// при дефрагментации: изображение копируется целиком, затем пересоздаются вью, bindless слот и сеты из кэша
+        bool BeginRelocation(VkCommandBuffer cmd, VmaAllocation dstAllocation) override;
+        void EndRelocation() override;
+        void CancelRelocation() override;
+
         EVK_NODISCARD EVK_INLINE VkDescriptorImageInfo* GetDescriptorRef() noexcept { return &m_descriptor; }
         EVK_NODISCARD EVK_INLINE VkSampler GetSampler() const { return m_sampler; }
         EVK_NODISCARD EVK_INLINE VkImageLayout GetLayout() const { return m_imageLayout; }
@@ -101,14 +148,30 @@ namespace EvoVulkan::Types {
         EVK_NODISCARD EVK_INLINE VkImage GetImage() const { return m_image; }
         EVK_NODISCARD EVK_INLINE uint32_t GetWidth() const { return m_width; }
         EVK_NODISCARD EVK_INLINE uint32_t GetHeight() const { return m_height; }
+        EVK_NODISCARD EVK_INLINE uint32_t GetMipLevels() const { return m_mipLevels; }
+        EVK_NODISCARD EVK_INLINE VkFormat GetFormat() const { return m_format; }
+        EVK_NODISCARD EVK_INLINE uint32_t GetLayersCount() const { return m_layers; }
+        EVK_NODISCARD EVK_INLINE bool IsArray() const { return m_array; }
         EVK_NODISCARD EVK_INLINE uint32_t GetSeed() const { return m_seed; }
+        /// индекс в bindless таблице или UINT32_MAX, если текстура в нее не попала
+        EVK_NODISCARD EVK_INLINE uint32_t GetBindlessIndex() const { return m_bindlessIndex; }
         Types::DescriptorSet GetDescriptorSet(VkDescriptorSetLayout layout);
 
     private:
         bool Create(VmaBuffer* stagingBuffer);
 
+        /// понижает количество мип-уровней до одного, если их нельзя сгенерировать блитом
+        static uint32_t GetSupportedMipLevels(const Device* device, VkFormat format, uint32_t mipLevels);
+
+        EVK_NODISCARD VkImageViewType GetViewType() const;
+
     private:
         Types::Image       m_image                   = Types::Image();
+        /// параметры изображения нужны, чтобы создать его копию при дефрагментации
+        VkImageCreateInfo  m_imageInfo               = {};
+        VkImage            m_relocationImage         = VK_NULL_HANDLE;
+        /// вью создается вместе с новым изображением, чтобы EndRelocation не мог провалиться
+        VkImageView        m_relocationView          = VK_NULL_HANDLE;
 
         VkSampler          m_sampler                 = VK_NULL_HANDLE;
         VkImageView        m_view                    = VK_NULL_HANDLE;
@@ -120,10 +183,13 @@ namespace EvoVulkan::Types {
         uint32_t           m_width                   = 0;
         uint32_t           m_height                  = 0;
         uint32_t           m_mipLevels               = 0;
+        uint32_t           m_layers                  = 1;
         uint32_t           m_seed                    = 0;
+        uint32_t           m_bindlessIndex           = UINT32_MAX;
 
         bool               m_canBeDestroyed          = false;
         bool               m_cubeMap                 = false;
+        bool               m_array                   = false;
         bool               m_isDestroyed             = false;
         bool               m_cpuUsage                = false;
 
@@ -132,7 +198,8 @@ namespace EvoVulkan::Types {
         Memory::Allocator* m_allocator               = nullptr;
         Core::DescriptorManager* m_descriptorManager = nullptr;
 
-        Types::DescriptorSet      m_descriptorSet     = {};
+        /// сеты из кэша менеджера, по одному на каждый запрошенный лейаут
+        std::unordered_map<VkDescriptorSetLayout, Types::DescriptorSet> m_descriptorSets = {};
         VkDescriptorImageInfo    m_descriptor        = {};
 
     };
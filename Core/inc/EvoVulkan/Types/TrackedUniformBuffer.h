@@ -0,0 +1,82 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_TRACKEDUNIFORMBUFFER_H
+#define EVOVULKAN_TRACKEDUNIFORMBUFFER_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
+
+namespace EvoVulkan::Types {
+    class Device;
+    struct Buffer;
+
+    /**
+     * @brief Uniform буфер с теневой копией на CPU.
+     * Запись сравнивается с теневой копией, в отображенную память уходят только реально изменившиеся байты,
+     * а их диапазоны копятся до Flush, где сливаются и отправляются одним vkFlushMappedMemoryRanges.
+     * Для coherent памяти Flush только сбрасывает диапазоны.
+     */
+    class DLL_EVK_EXPORT TrackedUniformBuffer : public Tools::NonCopyable {
+        struct Range {
+            VkDeviceSize m_offset;
+            VkDeviceSize m_size;
+        };
+    private:
+        TrackedUniformBuffer() = default;
+        ~TrackedUniformBuffer() override = default;
+
+    public:
+        operator VkBuffer() const;
+
+    public:
+        static TrackedUniformBuffer* Create(Device* device, Memory::Allocator* allocator, VkDeviceSize size);
+
+        /// сливает грязные диапазоны всех буферов в один вызов vkFlushMappedMemoryRanges
+        static VkResult Flush(const Device* device, const std::vector<TrackedUniformBuffer*>& buffers);
+
+    public:
+        /// возвращает false, если данные совпали с теневой копией и ничего не было записано
+        bool Write(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+
+        template<typename T> bool Write(const T& data, VkDeviceSize offset = 0) {
+            return Write(&data, sizeof(T), offset);
+        }
+
+        VkResult Flush();
+
+        EVK_NODISCARD VkDescriptorBufferInfo* GetDescriptorRef();
+        EVK_NODISCARD bool IsDirty() const { return !m_dirty.empty(); }
+        EVK_NODISCARD bool IsCoherent() const { return m_coherent; }
+        EVK_NODISCARD VkDeviceSize GetSize() const { return m_shadow.size(); }
+
+        void Destroy();
+        void Free();
+
+    private:
+        void MarkDirty(VkDeviceSize offset, VkDeviceSize size);
+        /// переводит грязные диапазоны в диапазоны памяти, выровненные по nonCoherentAtomSize и слитые между собой
+        void CollectRanges(std::vector<VkMappedMemoryRange>& ranges) const;
+
+    private:
+        const Device*        m_device    = nullptr;
+        Buffer*              m_buffer    = nullptr;
+        uint8_t*             m_mapped    = nullptr;
+
+        std::vector<uint8_t> m_shadow    = { };
+        std::vector<Range>   m_dirty     = { };
+
+        /// память аллокации и смещение в ней, диапазоны flush задаются относительно VkDeviceMemory
+        VkDeviceMemory       m_memory    = VK_NULL_HANDLE;
+        VkDeviceSize         m_offset    = 0;
+        VkDeviceSize         m_atomSize  = 1;
+        bool                 m_coherent  = false;
+
+    };
+}
+
+#endif //EVOVULKAN_TRACKEDUNIFORMBUFFER_H
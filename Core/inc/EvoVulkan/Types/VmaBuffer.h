@@ -5,16 +5,16 @@
 #ifndef EVOVULKAN_VMABUFFER_H
 #define EVOVULKAN_VMABUFFER_H
 
-#include <EvoVulkan/Tools/NonCopyable.h>
+#include <EvoVulkan/Memory/Allocator.h>
 
-namespace EvoVulkan::Memory {
-    class Allocator;
+namespace EvoVulkan::Core {
+    class DescriptorCache;
 }
 
 namespace EvoVulkan::Types {
     class Device;
 
-    struct DLL_EVK_EXPORT VmaBuffer : Tools::NonCopyable {
+    struct DLL_EVK_EXPORT VmaBuffer : Tools::NonCopyable, Memory::Relocatable {
     private:
         VmaBuffer(Memory::Allocator* allocator, VkDeviceSize size);
         ~VmaBuffer() override = default;
@@ -28,7 +28,9 @@ namespace EvoVulkan::Types {
                 VkBufferUsageFlags bufferUsage,
                 VmaMemoryUsage memoryUsage,
                 VkDeviceSize size,
-                void* data = nullptr);
+                void* data = nullptr,
+                bool persistentMapped = false,
+                Memory::MemoryPool pool = Memory::MemoryPool::Default);
 
         static VmaBuffer* Create(
                 Memory::Allocator* allocator,
@@ -39,10 +41,14 @@ namespace EvoVulkan::Types {
         EVK_NODISCARD const VkBuffer* GetCRef() const { return &m_buffer.m_buffer; }
         EVK_NODISCARD VkDescriptorBufferInfo* GetDescriptorRef() { return &m_descriptor; }
 
+        EVK_NODISCARD bool IsPersistentMapped() const { return m_persistentMapped; }
+
         void CopyToDevice(void *data, bool flush = false);
         void SetupDescriptor(VkDeviceSize offset = 0);
 
-        VkResult Flush();
+        /// для non-coherent памяти, смещение и размер задаются относительно аллокации
+        VkResult Flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+        VkResult Invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
         VkResult Bind();
         VkResult Map();
         void* MapData();
@@ -51,12 +57,26 @@ namespace EvoVulkan::Types {
         void Destroy();
         void Free();
 
+        /// разрешает дефрагментации переносить буфер. Сеты из cache переписываются автоматически,
+        /// остальные дескрипторы с этим буфером владелец обновляет через AddRelocationListener
+        bool EnableRelocation(Core::DescriptorCache* cache = nullptr);
+
+        /// при дефрагментации содержимое копируется на GPU, дескриптор буфера обновляется
+        bool BeginRelocation(VkCommandBuffer cmd, VmaAllocation dstAllocation) override;
+        void EndRelocation() override;
+        void CancelRelocation() override;
+
     private:
         void*                  m_mapped     = nullptr;
         Memory::Allocator*     m_allocator  = nullptr;
         Memory::Buffer         m_buffer     = { };
         VkDescriptorBufferInfo m_descriptor = { };
         VkDeviceSize           m_size       = 0;
+        VkBufferUsageFlags     m_usage      = 0;
+        VkBuffer               m_relocationBuffer = VK_NULL_HANDLE;
+        Core::DescriptorCache* m_descriptorCache  = nullptr;
+        /// буфер отображен на все время жизни, Map и Unmap ничего не делают
+        bool                   m_persistentMapped = false;
 
     };
 }
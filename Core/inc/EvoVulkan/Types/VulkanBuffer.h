@@ -24,21 +24,51 @@ namespace EvoVulkan::Types {
                 Memory::Allocator* allocator,
                 VkBufferUsageFlags usageFlags,
                 VkMemoryPropertyFlags memoryPropertyFlags,
-                VkDeviceSize size, void *data = nullptr);
+                VkDeviceSize size, void *data = nullptr,
+                bool persistentMapped = false,
+                Memory::MemoryPool pool = Memory::MemoryPool::Default);
 
         static Buffer* Create(Device* device, Memory::Allocator* allocator, VkDeviceSize size, void *data = nullptr);
 
+        /**
+         * @brief Persistently mapped buffer for data the CPU rewrites often (per-frame constants, dynamic geometry).
+         * Placed in DEVICE_LOCAL | HOST_VISIBLE memory when the allocator has it within budget, so writes go straight
+         * to VRAM without a staging copy, otherwise falls back to regular host-visible memory. The memory is host coherent
+         * unless coherent is false, then coherent memory is only preferred and the caller must flush its writes.
+         */
+        static Buffer* CreateHostWritable(
+                Device* device,
+                Memory::Allocator* allocator,
+                VkBufferUsageFlags usageFlags,
+                VkDeviceSize size, void* data = nullptr,
+                Memory::MemoryPool pool = Memory::MemoryPool::Default,
+                bool coherent = true);
+
+    private:
+        static Buffer* Create(
+                Device* device,
+                Memory::Allocator* allocator,
+                const Memory::Buffer& memory,
+                VkBufferUsageFlags usageFlags,
+                VkMemoryPropertyFlags memoryPropertyFlags,
+                VkDeviceSize size, void* data);
+
     public:
         operator VkBuffer() const { return m_buffer; }
 
     public:
         VkResult Map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
-        VkResult Bind(VkDeviceSize offset = 0) const;
         VkResult Flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
         VkResult Invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
 
         EVK_NODISCARD const VkBuffer* GetCRef() const { return &m_buffer; }
         EVK_NODISCARD VkDescriptorBufferInfo* GetDescriptorRef() { return &m_descriptor; }
+        EVK_NODISCARD bool IsPersistentMapped() const { return m_persistentData != nullptr; }
+        EVK_NODISCARD VmaAllocation GetAllocation() const { return m_allocation; }
+        EVK_NODISCARD VkDeviceSize GetSize() const { return m_size; }
+        EVK_NODISCARD bool IsDeviceLocal() const { return (m_memoryPropertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0; }
+        /// стабильный указатель на начало буфера, nullptr если буфер создан без persistentMapped
+        EVK_NODISCARD void* GetPersistentData() const { return m_persistentData; }
 
         void* MapData();
         void Unmap();
@@ -55,11 +85,13 @@ namespace EvoVulkan::Types {
         Types::Device*         m_device              = nullptr;
         Memory::Allocator*     m_allocator           = nullptr;
         VkBuffer               m_buffer              = VK_NULL_HANDLE;
-        Memory::RawMemory      m_memory              = {};
+        VmaAllocation          m_allocation          = VK_NULL_HANDLE;
         VkDescriptorBufferInfo m_descriptor          = {};
         VkDeviceSize           m_size                = 0;
         VkDeviceSize           m_alignment           = 0;
         void*                  m_mapped              = nullptr;
+        /** @brief Set for buffers created with VMA_ALLOCATION_CREATE_MAPPED_BIT, valid for the whole buffer lifetime */
+        void*                  m_persistentData      = nullptr;
         /** @brief Usage flags to be filled by external source at buffer creation (to query at some later point) */
         VkBufferUsageFlags     m_usageFlags          = {};
         /** @brief Memory property flags to be filled by external source at buffer creation (to query at some later point) */
@@ -0,0 +1,76 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#ifndef EVOVULKAN_UNIFORMRING_H
+#define EVOVULKAN_UNIFORMRING_H
+
+#include <EvoVulkan/Tools/NonCopyable.h>
+
+namespace EvoVulkan::Memory {
+    class Allocator;
+}
+
+namespace EvoVulkan::Types {
+    class Device;
+    struct Buffer;
+}
+
+namespace EvoVulkan::Core {
+    /**
+     * @brief Кольцевой uniform буфер для данных, которые меняются каждый кадр.
+     * Буфер отображен в память на все время жизни и разбит на части по числу кадров в полете.
+     * Данные объектов линейно дописываются в часть текущего кадра с выравниванием по minUniformBufferOffsetAlignment,
+     * а в шейдер попадают через VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC и динамическое смещение,
+     * поэтому один сет может обслуживать сколько угодно объектов.
+     */
+    class DLL_EVK_EXPORT UniformRing : public Tools::NonCopyable {
+    private:
+        UniformRing() = default;
+        ~UniformRing() override = default;
+
+    public:
+        static UniformRing* Create(
+                Types::Device* device,
+                Memory::Allocator* allocator,
+                uint32_t framesCount,
+                VkDeviceSize frameSize = 4 * 1024 * 1024);
+
+    public:
+        /// переходит на часть кольца для данного кадра, вызывать только когда фенс этого кадра уже просигналил
+        bool BeginFrame(uint32_t frameIndex);
+
+        /// резервирует место в текущем кадре и возвращает указатель для записи, nullptr если кадр переполнен
+        void* Allocate(VkDeviceSize size, uint32_t& dynamicOffset);
+        bool Push(const void* data, VkDeviceSize size, uint32_t& dynamicOffset);
+
+        template<typename T> bool Push(const T& data, uint32_t& dynamicOffset) {
+            return Push(&data, sizeof(T), dynamicOffset);
+        }
+
+        /// дескриптор для динамического биндинга, range - размер данных одного объекта
+        EVK_NODISCARD VkDescriptorBufferInfo GetDescriptor(VkDeviceSize range) const;
+
+        EVK_NODISCARD VkDeviceSize GetFrameSize() const { return m_frameSize; }
+        EVK_NODISCARD VkDeviceSize GetUsedSize() const { return m_head; }
+        EVK_NODISCARD uint32_t GetFramesCount() const { return m_framesCount; }
+
+        void Destroy();
+        void Free();
+
+    private:
+        Types::Buffer* m_buffer      = nullptr;
+        uint8_t*       m_mapped      = nullptr;
+
+        VkDeviceSize   m_alignment   = 0;
+        VkDeviceSize   m_frameSize   = 0;
+        /// смещение начала части текущего кадра и заполненность этой части
+        VkDeviceSize   m_frameOffset = 0;
+        VkDeviceSize   m_head        = 0;
+
+        uint32_t       m_framesCount = 0;
+
+    };
+}
+
+#endif //EVOVULKAN_UNIFORMRING_H
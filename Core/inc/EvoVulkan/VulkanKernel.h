@@ -6,6 +6,8 @@
 #define EVOVULKAN_VULKANKERNEL_H
 
 #include <EvoVulkan/Memory/Allocator.h>
+#include <EvoVulkan/Memory/Defragmenter.h>
+#include <EvoVulkan/Memory/AliasingPool.h>
 
 #include <EvoVulkan/Tools/VulkanTools.h>
 #include <EvoVulkan/Tools/VulkanInsert.h>
@@ -14,6 +16,9 @@
 #include <EvoVulkan/Types/VulkanBuffer.h>
 
 #include <EvoVulkan/DescriptorManager.h>
+#include <EvoVulkan/FrameDescriptorAllocator.h>
+#include <EvoVulkan/UniformRing.h>
+#include <EvoVulkan/DescriptorBuffer.h>
 #include <EvoVulkan/Types/RenderPass.h>
 #include <EvoVulkan/Complexes/Framebuffer.h>
 
@@ -28,6 +33,11 @@ namespace EvoVulkan::Core {
         Success = 0, Fatal = 1, Error = 2
     };
 
+    /// DescriptorBuffer используется, только если устройство поддерживает VK_EXT_descriptor_buffer
+    enum class DescriptorBackend : uint8_t {
+        Pools = 0, DescriptorBuffer = 1
+    };
+
     class DLL_EVK_EXPORT VulkanKernel : public Tools::NonCopyable {
     protected:
         VulkanKernel() = default;
@@ -72,12 +82,29 @@ namespace EvoVulkan::Core {
         EVK_NODISCARD EVK_INLINE bool MultisamplingEnabled() const noexcept { return m_multisampling; }
 
         EVK_NODISCARD Core::DescriptorManager* GetDescriptorManager() const;
+        /// временные сеты текущего кадра, сбрасываются в PrepareFrame
+        EVK_NODISCARD EVK_INLINE Core::FrameDescriptorAllocator* GetFrameDescriptorAllocator() const { return m_frameDescriptors; }
+        /// покадровые uniform данные через динамические смещения, часть кадра сбрасывается в PrepareFrame
+        EVK_NODISCARD EVK_INLINE Core::UniformRing* GetUniformRing() const { return m_uniformRing; }
+        /// проходы дефрагментации выполняются в PrepareFrame, после переноса ресурсов вызывается BuildCmdBuffers
+        EVK_NODISCARD EVK_INLINE Memory::Defragmenter* GetDefragmenter() const { return m_defragmenter; }
+        /// общая память для промежуточных FrameBuffer, время жизни задается номерами проходов при их создании
+        EVK_NODISCARD EVK_INLINE Memory::AliasingPool* GetAliasingPool() const { return m_aliasingPool; }
+        /// nullptr, если выбран бэкенд на пулах
+        EVK_NODISCARD EVK_INLINE Core::DescriptorBuffer* GetDescriptorBuffer() const { return m_descriptorBuffer; }
+        EVK_NODISCARD EVK_INLINE DescriptorBackend GetDescriptorBackend() const noexcept { return m_descriptorBackend; }
         EVK_NODISCARD uint32_t GetCountBuildIterations() const;
         EVK_NODISCARD bool IsValidationLayersEnabled() const { return m_validationEnabled; }
 
         void SetFramebuffersQueue(const std::vector<Complexes::FrameBuffer*>& queue);
         void SetMultisampling(uint32_t sampleCount);
         void SetSwapchainImagesCount(uint32_t count);
+        /// вызывать до Init, при отсутствии расширения будет выбран бэкенд на пулах
+        void SetDescriptorBackend(DescriptorBackend backend);
+        /// вызывать до Init, размер части кольца на один кадр в байтах
+        void SetUniformRingSize(VkDeviceSize frameSize);
+        /// вызывать до Init. Internal - ресурсы можно создавать через аллокатор из любых потоков
+        void SetAllocatorThreading(Memory::AllocatorThreading threading);
 
         void SetGUIEnabled(bool enabled);
 
@@ -131,6 +158,14 @@ namespace EvoVulkan::Core {
         Types::MultisampleTarget*  m_multisample          = nullptr;
 
         Core::DescriptorManager*   m_descriptorManager    = nullptr;
+        Core::FrameDescriptorAllocator* m_frameDescriptors = nullptr;
+        Core::UniformRing*         m_uniformRing          = nullptr;
+        VkDeviceSize               m_uniformRingSize      = 4 * 1024 * 1024;
+        Memory::Defragmenter*      m_defragmenter         = nullptr;
+        Memory::AliasingPool*      m_aliasingPool         = nullptr;
+        Memory::AllocatorThreading m_allocatorThreading   = Memory::AllocatorThreading::External;
+        Core::DescriptorBuffer*    m_descriptorBuffer     = nullptr;
+        DescriptorBackend          m_descriptorBackend    = DescriptorBackend::Pools;
 
         /// optional. Maybe nullptr
         VkSemaphore                m_waitSemaphore        = VK_NULL_HANDLE;
@@ -37,6 +37,7 @@
 
 #define EVK_INLINE inline
 #define EVK_ID_INVALID -1
+#define EVK_BINDLESS_TEXTURES_COUNT 16384
 
 #define EVK_MAX(a, b) (a > b ? a : b)
 #define EVK_MIN(a, b) (a < b ? a : b)
@@ -54,8 +55,13 @@
 #include <set>
 #include <vector>
 #include <map>
+#include <list>
 #include <algorithm>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include <sys/stat.h>
 #include <fstream>
 #include <array>
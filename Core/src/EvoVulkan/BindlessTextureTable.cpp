@@ -0,0 +1,179 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/BindlessTextureTable.h>
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Tools/VulkanInitializers.h>
+
+namespace EvoVulkan::Core {
+    BindlessTextureTable* BindlessTextureTable::Create(const Types::Device* device, uint32_t capacity) {
+        if (!device || !device->GetFeatures().m_descriptorIndexing) {
+            VK_ERROR("BindlessTextureTable::Create() : descriptor indexing isn't enabled on this device!");
+            return nullptr;
+        }
+
+        capacity = EVK_MIN(capacity, device->GetMaxBindlessTextures());
+        if (capacity == 0) {
+            VK_ERROR("BindlessTextureTable::Create() : capacity is zero!");
+            return nullptr;
+        }
+
+        auto&& table = new BindlessTextureTable();
+        table->m_device   = device;
+        table->m_capacity = capacity;
+        table->m_used.resize(capacity, false);
+
+        /// ---------------------------------------------------------------------------------------------------------
+
+        auto&& binding = Tools::Initializers::DescriptorSetLayoutBinding(
+                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_ALL, 0, capacity);
+
+        /// незаписанные элементы допустимы, обновлять можно даже когда сет уже записан в командный буфер
+        const VkDescriptorBindingFlags bindingFlags =
+                VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCI = {};
+        bindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsCI.bindingCount  = 1;
+        bindingFlagsCI.pBindingFlags = &bindingFlags;
+
+        auto&& layoutCI = Tools::Initializers::DescriptorSetLayoutCreateInfo(&binding, 1);
+        layoutCI.pNext = &bindingFlagsCI;
+        layoutCI.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+
+        VkResult result = vkCreateDescriptorSetLayout(*device, &layoutCI, Memory::GetAllocationCallbacks(), &table->m_layout);
+        if (result != VK_SUCCESS) {
+            VK_ERROR("BindlessTextureTable::Create() : failed to create descriptor set layout!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            EVSafeFreeObject(table);
+            return nullptr;
+        }
+
+        /// ---------------------------------------------------------------------------------------------------------
+
+        VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, capacity };
+
+        auto&& poolCI = Tools::Initializers::DescriptorPoolCreateInfo(1, &poolSize, 1);
+        poolCI.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+
+        if ((result = vkCreateDescriptorPool(*device, &poolCI, Memory::GetAllocationCallbacks(), &table->m_pool)) != VK_SUCCESS) {
+            VK_ERROR("BindlessTextureTable::Create() : failed to create descriptor pool!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            EVSafeFreeObject(table);
+            return nullptr;
+        }
+
+        /// ---------------------------------------------------------------------------------------------------------
+
+        auto&& allocInfo = Tools::Initializers::DescriptorSetAllocateInfo(table->m_pool, &table->m_layout, 1);
+
+        if ((result = vkAllocateDescriptorSets(*device, &allocInfo, &table->m_set)) != VK_SUCCESS) {
+            VK_ERROR("BindlessTextureTable::Create() : failed to allocate descriptor set!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            EVSafeFreeObject(table);
+            return nullptr;
+        }
+
+        VK_GRAPH("BindlessTextureTable::Create() : bindless texture table created with " + std::to_string(capacity) + " slots.");
+
+        return table;
+    }
+
+    uint32_t BindlessTextureTable::Register(const VkDescriptorImageInfo& imageInfo) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        uint32_t index = InvalidIndex;
+
+        if (!m_freeList.empty()) {
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        }
+        else if (m_next < m_capacity)
+            index = m_next++;
+        else {
+            VK_ERROR("BindlessTextureTable::Register() : table is full! Capacity: " + std::to_string(m_capacity));
+            return InvalidIndex;
+        }
+
+        m_used[index] = true;
+        Write(index, imageInfo);
+
+        return index;
+    }
+
+    bool BindlessTextureTable::Update(uint32_t index, const VkDescriptorImageInfo& imageInfo) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (index >= m_capacity || !m_used[index]) {
+            VK_ERROR("BindlessTextureTable::Update() : index isn't registered! Index: " + std::to_string(index));
+            return false;
+        }
+
+        Write(index, imageInfo);
+
+        return true;
+    }
+
+    bool BindlessTextureTable::Unregister(uint32_t index) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (index >= m_capacity || !m_used[index]) {
+            VK_ERROR("BindlessTextureTable::Unregister() : index isn't registered! Index: " + std::to_string(index));
+            return false;
+        }
+
+        /// дескриптор не перезаписываем, благодаря partially bound шейдер просто не должен к нему обращаться
+        m_used[index] = false;
+        m_freeList.emplace_back(index);
+
+        return true;
+    }
+
+    void BindlessTextureTable::Write(uint32_t index, const VkDescriptorImageInfo& imageInfo) {
+        VkDescriptorImageInfo descriptorInfo = imageInfo;
+
+        VkWriteDescriptorSet write = Tools::Initializers::WriteDescriptorSet(
+                m_set, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, &descriptorInfo);
+        write.dstArrayElement = index;
+
+        vkUpdateDescriptorSets(*m_device, 1, &write, 0, nullptr);
+    }
+
+    void BindlessTextureTable::Bind(VkCommandBuffer cmd, VkPipelineLayout pipelineLayout, uint32_t setIndex, VkPipelineBindPoint bindPoint) const {
+        vkCmdBindDescriptorSets(cmd, bindPoint, pipelineLayout, setIndex, 1, &m_set, 0, nullptr);
+    }
+
+    uint32_t BindlessTextureTable::GetCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_next - static_cast<uint32_t>(m_freeList.size());
+    }
+
+    void BindlessTextureTable::Destroy() {
+        /// сет освобождается вместе с пулом
+        if (m_pool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(*m_device, m_pool, Memory::GetAllocationCallbacks());
+            m_pool = VK_NULL_HANDLE;
+            m_set  = VK_NULL_HANDLE;
+        }
+
+        if (m_layout != VK_NULL_HANDLE) {
+            vkDestroyDescriptorSetLayout(*m_device, m_layout, Memory::GetAllocationCallbacks());
+            m_layout = VK_NULL_HANDLE;
+        }
+
+        m_freeList.clear();
+        m_used.clear();
+        m_next = 0;
+    }
+
+    void BindlessTextureTable::Free() {
+        delete this;
+    }
+}
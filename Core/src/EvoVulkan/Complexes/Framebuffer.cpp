@@ -12,7 +12,9 @@ static EvoVulkan::Complexes::FrameBufferAttachment CreateAttachment(
         EvoVulkan::Types::CmdPool* pool,
         VkFormat format,
         VkImageUsageFlags usage,
-        VkExtent2D imageSize)
+        VkExtent2D imageSize,
+        EvoVulkan::Memory::AliasingPool* aliasingPool,
+        const EvoVulkan::Memory::AliasingLifetime& lifetime)
 {
     VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_FLAG_BITS_MAX_ENUM;
 
@@ -39,7 +41,19 @@ static EvoVulkan::Complexes::FrameBufferAttachment CreateAttachment(
             false
     );
 
-    FBOAttachment.m_image = EvoVulkan::Types::Image::Create(imageCI);
+    imageCI.pool = EvoVulkan::Memory::MemoryPool::Attachments;
+
+    if (aliasingPool) {
+        FBOAttachment.m_image = aliasingPool->CreateImage(imageCI.ToVulkanCreateInfo(), lifetime);
+    }
+    else {
+        FBOAttachment.m_image = EvoVulkan::Types::Image::Create(imageCI);
+    }
+
+    if (!FBOAttachment.m_image.Valid()) {
+        VK_ERROR("Types::CreateAttachment() : failed to create image!");
+        return {};
+    }
 
     /// ставим барьер памяти, чтобы можно было использовать в шейдерах
     {
@@ -63,13 +77,17 @@ static EvoVulkan::Complexes::FrameBufferAttachment CreateAttachment(
     FBOAttachment.m_format = format;
     FBOAttachment.m_device = device;
     FBOAttachment.m_allocator = allocator;
+    FBOAttachment.m_aliasingPool = aliasingPool;
 
     return std::move(FBOAttachment);
 }
 
 void EvoVulkan::Complexes::FrameBuffer::Free()  {
+    /// семплер не зависит от размеров, поэтому переживает ReCreate и освобождается только здесь
+    Tools::DestroySampler(m_device, &m_colorSampler);
+
     if (m_semaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(*m_device, m_semaphore, nullptr);
+        vkDestroySemaphore(*m_device, m_semaphore, Memory::GetAllocationCallbacks());
         m_semaphore = VK_NULL_HANDLE;
     }
 
@@ -109,13 +127,20 @@ EvoVulkan::Complexes::FrameBuffer *EvoVulkan::Complexes::FrameBuffer::Create(
         const std::vector<VkFormat> &colorAttachments,
         uint32_t width,
         uint32_t height,
-        float scale)
+        float scale,
+        Memory::AliasingPool* aliasingPool,
+        Memory::AliasingLifetime lifetime)
 {
     if (scale <= 0.f) {
         VK_ERROR("Framebuffer::Create() : scale <= zero!");
         return nullptr;
     }
 
+    if (lifetime.m_first > lifetime.m_last) {
+        VK_ERROR("Framebuffer::Create() : invalid aliasing lifetime!");
+        return nullptr;
+    }
+
     auto fbo = new FrameBuffer();
     {
         fbo->m_scale             = scale;
@@ -127,10 +152,12 @@ EvoVulkan::Complexes::FrameBuffer *EvoVulkan::Complexes::FrameBuffer::Create(
         fbo->m_countColorAttach  = colorAttachments.size();
         fbo->m_attachFormats     = colorAttachments;
         fbo->m_depthFormat       = Tools::GetDepthFormat(*device);
+        fbo->m_aliasingPool      = aliasingPool;
+        fbo->m_lifetime          = lifetime;
     }
 
     auto semaphoreCI  = Tools::Initializers::SemaphoreCreateInfo();
-    if (vkCreateSemaphore(*device, &semaphoreCI, nullptr, &fbo->m_semaphore) != VK_SUCCESS) {
+    if (vkCreateSemaphore(*device, &semaphoreCI, Memory::GetAllocationCallbacks(), &fbo->m_semaphore) != VK_SUCCESS) {
         VK_ERROR("Framebuffer::Create() : failed to create vulkan semaphore!");
         return nullptr;
     }
@@ -161,7 +188,9 @@ bool EvoVulkan::Complexes::FrameBuffer::ReCreate(uint32_t width, uint32_t height
             m_swapchain,
             width, height,
             m_attachFormats,
-            m_device->MultisampleEnabled()
+            m_device->MultisampleEnabled(),
+            m_aliasingPool,
+            m_lifetime.m_first
     );
 
     if (!m_multisampleTarget) {
@@ -204,17 +233,15 @@ void EvoVulkan::Complexes::FrameBuffer::Destroy()  {
     }
 
     if (m_framebuffer != VK_NULL_HANDLE) {
-        vkDestroyFramebuffer(*m_device, m_framebuffer, nullptr);
+        vkDestroyFramebuffer(*m_device, m_framebuffer, Memory::GetAllocationCallbacks());
         m_framebuffer = VK_NULL_HANDLE;
     }
-
-    if (m_colorSampler != VK_NULL_HANDLE) {
-        vkDestroySampler(*m_device, m_colorSampler, nullptr);
-        m_colorSampler = VK_NULL_HANDLE;
-    }
 }
 
 bool EvoVulkan::Complexes::FrameBuffer::CreateSampler()  {
+    if (m_colorSampler != VK_NULL_HANDLE)
+        return true;
+
     VkSamplerCreateInfo sampler = Tools::Initializers::SamplerCreateInfo();
 
     sampler.magFilter     = VK_FILTER_NEAREST;
@@ -228,7 +255,9 @@ bool EvoVulkan::Complexes::FrameBuffer::CreateSampler()  {
     sampler.minLod        = 0.0f;
     sampler.maxLod        = 1.0f;
     sampler.borderColor   = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-    if (vkCreateSampler(*m_device, &sampler, nullptr, &m_colorSampler) != VK_SUCCESS) {
+
+    /// при ReCreate семплер с тем же состоянием просто берется из кэша устройства
+    if ((m_colorSampler = m_device->GetSamplerCache()->Acquire(sampler)) == VK_NULL_HANDLE) {
         VK_ERROR("Framebuffer::CreateSampler() : failed to create vulkan sampler!");
         return false;
     }
@@ -271,7 +300,7 @@ bool EvoVulkan::Complexes::FrameBuffer::CreateFramebuffer()  {
     FBO_CI.height                  = m_height;
     FBO_CI.layers                  = 1;
 
-    if (vkCreateFramebuffer(*m_device, &FBO_CI, nullptr, &m_framebuffer) != VK_SUCCESS || m_framebuffer == VK_NULL_HANDLE) {
+    if (vkCreateFramebuffer(*m_device, &FBO_CI, Memory::GetAllocationCallbacks(), &m_framebuffer) != VK_SUCCESS || m_framebuffer == VK_NULL_HANDLE) {
         VK_ERROR("Framebuffer::CreateFramebuffer() : failed to create vulkan framebuffer!");
         return false;
     }
@@ -292,6 +321,8 @@ bool EvoVulkan::Complexes::FrameBuffer::CreateRenderPass()  {
         attachmentDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
         if (i == m_countColorAttach) {
+            /// глубина живет в transient памяти MultisampleTarget и после пасса не нужна
+            attachmentDesc.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             attachmentDesc.format = m_depthFormat;
             attachmentDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
             attachmentDesc.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
@@ -343,7 +374,9 @@ bool EvoVulkan::Complexes::FrameBuffer::CreateAttachments()  {
                 m_cmdPool,
                 m_attachFormats[i],
                 VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                { m_width, m_height }
+                { m_width, m_height },
+                m_aliasingPool,
+                m_lifetime
         );
 
         if (!m_attachments[i].Ready()) {
@@ -427,6 +460,11 @@ VkImageView EvoVulkan::Complexes::FrameBuffer::GetAttachment(uint32_t id) const
 
 void EvoVulkan::Complexes::FrameBuffer::BeginCmd() {
     vkBeginCommandBuffer(m_cmdBuff, &m_cmdBufInfo);
+
+    /// память вложений могла только что принадлежать вложениям предыдущего прохода
+    if (m_aliasingPool) {
+        Memory::AliasingPool::InsertAliasingBarrier(m_cmdBuff);
+    }
 }
 
 void EvoVulkan::Complexes::FrameBuffer::End() const {
@@ -465,18 +503,25 @@ void EvoVulkan::Complexes::FrameBufferAttachment::Init() {
     m_format = VK_FORMAT_UNDEFINED;
 
     m_device = VK_NULL_HANDLE;
+    m_aliasingPool = nullptr;
 }
 
 void EvoVulkan::Complexes::FrameBufferAttachment::Destroy() {
     if (m_view) {
-        vkDestroyImageView(*m_device, m_view, nullptr);
+        vkDestroyImageView(*m_device, m_view, Memory::GetAllocationCallbacks());
         m_view = VK_NULL_HANDLE;
     }
 
     if (m_image.Valid()) {
-        m_allocator->FreeImage(m_image);
+        if (m_image.IsAliased()) {
+            m_aliasingPool->DestroyImage(m_image);
+        }
+        else {
+            m_allocator->FreeImage(m_image);
+        }
     }
 
     m_device = nullptr;
     m_allocator = nullptr;
+    m_aliasingPool = nullptr;
 }
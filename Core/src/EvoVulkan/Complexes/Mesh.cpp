@@ -4,19 +4,134 @@
 
 #include <EvoVulkan/Complexes/Mesh.h>
 #include <EvoVulkan/Types/VulkanBuffer.h>
+#include <EvoVulkan/DescriptorCache.h>
 
-void EvoVulkan::Complexes::Mesh::Draw(const VkCommandBuffer& cmd) {
+bool EvoVulkan::Complexes::Mesh::Draw(const VkCommandBuffer& cmd) {
     VkDeviceSize offsets[1] = {0};
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            this->m_attachShader->GetPipelineLayout(), 0, 1, &m_descriptorSet.m_self, 0, NULL);
+
+    if (m_attachShader->IsPushDescriptors()) {
+        if (!m_attachShader->PushDescriptors(cmd, m_pushData)) {
+            VK_ERROR("Mesh::Draw() : failed to push descriptors!");
+            return false;
+        }
+    }
+    else
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                this->m_attachShader->GetPipelineLayout(), 0, 1, &m_descriptorSet.m_self, 0, NULL);
     vkCmdBindVertexBuffers(cmd, 0, 1, m_vertices->GetCRef(), offsets);
     vkCmdBindIndexBuffer(cmd, *m_indices, 0, VK_INDEX_TYPE_UINT32);
 
     vkCmdDrawIndexed(cmd, m_countIndices, 1, 0, 0, 0);
+
+    return true;
 }
 
 bool EvoVulkan::Complexes::Mesh::Bake(Shader const* shader) {
-    return true;
+    if (!shader || (!m_descriptorManager && !shader->IsPushDescriptors())) {
+        VK_ERROR("Mesh::Bake() : shader or descriptor manager is nullptr!");
+        return false;
+    }
+
+    auto&& bindings = shader->GetLayoutBindings();
+    if (bindings.size() != m_uniforms.size()) {
+        VK_ERROR("Mesh::Bake() : uniforms count doesn't match shader bindings! "
+                 "Uniforms: " + std::to_string(m_uniforms.size()) + ", bindings: " + std::to_string(bindings.size()));
+        return false;
+    }
+
+    Destroy();
+
+    m_attachShader = shader;
+
+    /// inline блоки хранятся в самом сете и в ключ кэша не попадают, такие сеты не разделяются
+    const bool hasInlineBlocks = std::any_of(m_uniforms.begin(), m_uniforms.end(), [](const Uniform& uniform) {
+        return std::holds_alternative<InlineBlock>(uniform);
+    });
+
+    /// кэш пишет сет через vkUpdateDescriptorSets, данные шаблона ему не нужны
+    if (!shader->IsPushDescriptors() && !hasInlineBlocks) {
+        Core::DescriptorWrites writes;
+
+        for (size_t i = 0; i < m_uniforms.size(); ++i) {
+            if (auto&& pImage = std::get_if<VkDescriptorImageInfo>(&m_uniforms[i])) {
+                writes.AddImage(bindings[i].binding, bindings[i].descriptorType, *pImage);
+            }
+            else if (auto&& pBuffer = std::get_if<Types::Buffer*>(&m_uniforms[i]); pBuffer && *pBuffer) {
+                writes.AddBuffer(bindings[i].binding, bindings[i].descriptorType, *(*pBuffer)->GetDescriptorRef());
+            }
+            else {
+                VK_ERROR("Mesh::Bake() : failed to set uniform! Binding: " + std::to_string(bindings[i].binding));
+                return false;
+            }
+        }
+
+        m_descriptorSet = m_descriptorManager->GetDescriptorCache()->Acquire(shader->GetDescriptorSetLayout(), writes);
+        if (!m_descriptorSet.Valid()) {
+            VK_ERROR("Mesh::Bake() : failed to acquire descriptor set!");
+            return false;
+        }
+
+        m_cachedSet = true;
+
+        return true;
+    }
+
+    auto&& data = shader->CreateUpdateData();
+
+    for (size_t i = 0; i < m_uniforms.size(); ++i) {
+        bool result = false;
+
+        if (auto&& pImage = std::get_if<VkDescriptorImageInfo>(&m_uniforms[i])) {
+            result = data.SetImage(bindings[i].binding, *pImage);
+        }
+        else if (auto&& pBuffer = std::get_if<Types::Buffer*>(&m_uniforms[i]); pBuffer && *pBuffer) {
+            result = data.SetBuffer(bindings[i].binding, *(*pBuffer)->GetDescriptorRef());
+        }
+        else if (auto&& pBlock = std::get_if<InlineBlock>(&m_uniforms[i]); pBlock && !pBlock->empty()) {
+            result = data.SetInlineUniformBlock(bindings[i].binding, pBlock->data(), static_cast<uint32_t>(pBlock->size()));
+        }
+
+        if (!result) {
+            VK_ERROR("Mesh::Bake() : failed to set uniform! Binding: " + std::to_string(bindings[i].binding));
+            return false;
+        }
+    }
+
+    if (shader->IsPushDescriptors()) {
+        m_pushData = std::move(data);
+        return true;
+    }
+
+    std::set<VkDescriptorType> types;
+    for (auto&& binding : bindings) {
+        types.insert(binding.descriptorType);
+    }
+
+    m_descriptorSet = m_descriptorManager->AllocateDescriptorSet(shader->GetDescriptorSetLayout(), types);
+    if (!m_descriptorSet.Valid()) {
+        VK_ERROR("Mesh::Bake() : failed to allocate descriptor set!");
+        return false;
+    }
+
+    return shader->UpdateDescriptorSet(m_descriptorSet, data);
+}
+
+void EvoVulkan::Complexes::Mesh::SetUniforms(const std::vector<Uniform>& uniforms) {
+    m_uniforms = uniforms;
+}
+
+void EvoVulkan::Complexes::Mesh::Destroy() {
+    if (m_descriptorManager && m_descriptorSet.Valid()) {
+        if (m_cachedSet)
+            m_descriptorManager->GetDescriptorCache()->Release(m_descriptorSet);
+        else
+            m_descriptorManager->FreeDescriptorSet(&m_descriptorSet);
+    }
+
+    m_descriptorSet = Types::DescriptorSet();
+    m_cachedSet     = false;
+
+    m_pushData = DescriptorUpdateData();
 }
 
 EvoVulkan::Complexes::Mesh::Mesh(
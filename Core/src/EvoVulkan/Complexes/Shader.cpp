@@ -6,12 +6,19 @@
 
 #include <EvoVulkan/Tools/StringUtils.h>
 #include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Types/LayoutCache.h>
 #include <EvoVulkan/Tools/FileSystem.h>
 
-EvoVulkan::Complexes::Shader::Shader(const EvoVulkan::Types::Device* device, Types::RenderPass renderPass, const VkPipelineCache& cache) {
-    m_device     = device;
-    m_renderPass = renderPass;
-    m_cache      = cache;
+EvoVulkan::Complexes::Shader::Shader(
+        const EvoVulkan::Types::Device* device,
+        Types::RenderPass renderPass,
+        const VkPipelineCache& cache,
+        Core::DescriptorManager* manager)
+{
+    m_device            = device;
+    m_renderPass        = renderPass;
+    m_cache             = cache;
+    m_descriptorManager = manager;
 }
 
 bool EvoVulkan::Complexes::Shader::Load(
@@ -99,7 +106,7 @@ bool EvoVulkan::Complexes::Shader::SetVertexDescriptions(
 
 bool EvoVulkan::Complexes::Shader::ReCreatePipeLine(Types::RenderPass renderPass) {
     if (m_pipeline != VK_NULL_HANDLE) {
-        vkDestroyPipeline(*m_device, m_pipeline, VK_NULL_HANDLE);
+        vkDestroyPipeline(*m_device, m_pipeline, Memory::GetAllocationCallbacks());
         m_pipeline = VK_NULL_HANDLE;
     }
 
@@ -131,7 +138,8 @@ bool EvoVulkan::Complexes::Shader::ReCreatePipeLine(Types::RenderPass renderPass
 
     auto&& dynamicState       = Tools::Initializers::PipelineDynamicStateCreateInfo(dynamicStateEnables.data(), static_cast<uint32_t>(dynamicStateEnables.size()), 0);
     auto&& colorBlendState    = Tools::Initializers::PipelineColorBlendStateCreateInfo(m_renderPass.m_countColorAttach, blendAttachmentStates.data());
-    auto&& pipelineCreateInfo = Tools::Initializers::PipelineCreateInfo(m_pipelineLayout, m_renderPass.m_self, 0);
+    auto&& pipelineCreateInfo = Tools::Initializers::PipelineCreateInfo(m_pipelineLayout, m_renderPass.m_self,
+            m_descriptorBuffer ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0);
 
     pipelineCreateInfo.pVertexInputState   = &m_vertices.m_inputState;
     pipelineCreateInfo.pInputAssemblyState = &m_inputAssemblyState;
@@ -144,7 +152,7 @@ bool EvoVulkan::Complexes::Shader::ReCreatePipeLine(Types::RenderPass renderPass
     pipelineCreateInfo.stageCount          = static_cast<uint32_t>(m_shaderStages.size());
     pipelineCreateInfo.pStages             = m_shaderStages.data();
 
-    if (vkCreateGraphicsPipelines(*m_device, m_cache, 1, &pipelineCreateInfo, nullptr, &m_pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(*m_device, m_cache, 1, &pipelineCreateInfo, Memory::GetAllocationCallbacks(), &m_pipeline) != VK_SUCCESS) {
         VK_ERROR("Shader::ReCreatePipeLine() : failed to create vulkan graphics pipeline!");
         return false;
     }
@@ -186,40 +194,389 @@ bool EvoVulkan::Complexes::Shader::Compile(
     return true;
 }
 
+void EvoVulkan::Complexes::Shader::SetPushConstants(const std::vector<VkPushConstantRange>& ranges) {
+    m_pushConstants = ranges;
+}
+
+void EvoVulkan::Complexes::Shader::SetExternalSetLayouts(const std::vector<VkDescriptorSetLayout>& layouts) {
+    m_externalLayouts = layouts;
+}
+
+bool EvoVulkan::Complexes::Shader::SetPushDescriptors(bool enabled) {
+    if (enabled && !m_device->GetFeatures().m_pushDescriptors) {
+        VK_WARN("Shader::SetPushDescriptors() : push descriptors aren't supported by device!");
+        return false;
+    }
+
+    if (enabled && m_descriptorBuffer) {
+        VK_ERROR("Shader::SetPushDescriptors() : shader already uses descriptor buffer!");
+        return false;
+    }
+
+    m_pushDescriptors = enabled;
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::Shader::SetDescriptorBuffer(bool enabled) {
+    if (enabled && !m_device->GetFeatures().m_descriptorBuffer) {
+        VK_WARN("Shader::SetDescriptorBuffer() : descriptor buffer isn't supported by device!");
+        return false;
+    }
+
+    if (enabled && m_pushDescriptors) {
+        VK_ERROR("Shader::SetDescriptorBuffer() : shader already uses push descriptors!");
+        return false;
+    }
+
+    m_descriptorBuffer = enabled;
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::Shader::PushDescriptors(const VkCommandBuffer& cmd, const std::vector<VkWriteDescriptorSet>& writes) const {
+    if (!m_pushDescriptors) {
+        VK_ERROR("Shader::PushDescriptors() : shader doesn't use push descriptors!");
+        return false;
+    }
+
+    m_device->GetCmdPushDescriptorSet()(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0,
+            static_cast<uint32_t>(writes.size()), writes.data());
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::Shader::PushDescriptors(const VkCommandBuffer& cmd, const DescriptorUpdateData& data) const {
+    if (!m_pushDescriptors || !data.Valid() || data.m_shader != this) {
+        VK_ERROR("Shader::PushDescriptors() : shader doesn't use push descriptors or update data is invalid!");
+        return false;
+    }
+
+    if (!IsUpdateDataComplete(data)) {
+        VK_ERROR("Shader::PushDescriptors() : not all bindings are set!");
+        return false;
+    }
+
+    if (auto&& pushWithTemplate = m_device->GetCmdPushDescriptorSetWithTemplate()) {
+        pushWithTemplate(cmd, m_updateTemplate, m_pipelineLayout, 0, data.GetData());
+        return true;
+    }
+
+    VK_ERROR("Shader::PushDescriptors() : vkCmdPushDescriptorSetWithTemplateKHR isn't available!");
+
+    return false;
+}
+
 bool EvoVulkan::Complexes::Shader::BuildLayouts() {
-    m_descriptorSetLayout = Tools::CreateDescriptorLayout(*m_device, m_layoutBindings);
+    if (m_pushDescriptors) {
+        uint32_t descriptorsCount = 0;
+        for (auto&& binding : m_layoutBindings) {
+            descriptorsCount += binding.descriptorCount;
+        }
+
+        if (descriptorsCount > m_device->GetMaxPushDescriptors()) {
+            VK_ERROR("Shader::BuildLayouts() : too many push descriptors! Count: " + std::to_string(descriptorsCount) +
+                     ", max: " + std::to_string(m_device->GetMaxPushDescriptors()));
+            return false;
+        }
+    }
+
+    /// динамические смещения задаются только при vkCmdBindDescriptorSets, ни push, ни descriptor buffer их не поддерживают
+    if (m_pushDescriptors || m_descriptorBuffer) {
+        for (auto&& binding : m_layoutBindings) {
+            if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) {
+                VK_ERROR("Shader::BuildLayouts() : dynamic buffers can't be used with push descriptors or descriptor buffer! "
+                         "Binding: " + std::to_string(binding.binding));
+                return false;
+            }
+        }
+    }
+
+    for (auto&& binding : m_layoutBindings) {
+        if (binding.descriptorType != VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
+            continue;
+        }
+
+        if (!m_device->GetFeatures().m_inlineUniformBlock || m_pushDescriptors) {
+            VK_ERROR("Shader::BuildLayouts() : inline uniform blocks aren't supported by device or used with push descriptors! "
+                     "Binding: " + std::to_string(binding.binding));
+            return false;
+        }
+
+        /// размер блока задается в descriptorCount и должен быть кратен 4
+        if (binding.descriptorCount % 4 != 0 || binding.descriptorCount > m_device->GetMaxInlineUniformBlockSize()) {
+            VK_ERROR("Shader::BuildLayouts() : incorrect inline uniform block size! Binding: " + std::to_string(binding.binding) +
+                     ", size: " + std::to_string(binding.descriptorCount) + ", max: " + std::to_string(m_device->GetMaxInlineUniformBlockSize()));
+            return false;
+        }
+    }
+
+    VkDescriptorSetLayoutCreateFlags layoutFlags = 0;
+    if (m_pushDescriptors)
+        layoutFlags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    if (m_descriptorBuffer)
+        layoutFlags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+
+    /// шейдеры с одинаковыми биндингами получают один лейаут, а значит и общие пулы дескрипторов
+    m_descriptorSetLayout = m_device->GetLayoutCache()->AcquireSetLayout(m_layoutBindings, layoutFlags);
     if (m_descriptorSetLayout == VK_NULL_HANDLE) {
         VK_ERROR("Shader::BuildLayouts() : failed to create descriptor layout!");
         return false;
     }
 
-    m_pipelineLayout = Tools::CreatePipelineLayout(*m_device, m_descriptorSetLayout);
+    /// из push descriptor и descriptor buffer лейаутов сеты не выделяются, пулы под них не нужны
+    if (m_descriptorManager && !m_pushDescriptors && !m_descriptorBuffer && !m_layoutBindings.empty()) {
+        m_descriptorManager->RegisterLayout(m_descriptorSetLayout, m_layoutBindings);
+    }
+
+    std::vector<VkDescriptorSetLayout> setLayouts = { m_descriptorSetLayout };
+    setLayouts.insert(setLayouts.end(), m_externalLayouts.begin(), m_externalLayouts.end());
+
+    m_pipelineLayout = m_device->GetLayoutCache()->AcquirePipelineLayout(setLayouts, m_pushConstants);
     if (m_pipelineLayout == VK_NULL_HANDLE) {
         VK_ERROR("Shader::BuildLayouts() : failed to create pipeline layout!");
         return false;
     }
 
+    if (!m_layoutBindings.empty() && !m_descriptorBuffer && !BuildUpdateTemplate()) {
+        VK_ERROR("Shader::BuildLayouts() : failed to create descriptor update template!");
+        return false;
+    }
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::Shader::BuildUpdateTemplate() {
+    m_templateEntries.clear();
+    m_templateSize = 0;
+
+    for (auto&& binding : m_layoutBindings) {
+        size_t stride = 0;
+
+        switch (binding.descriptorType) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                stride = sizeof(VkDescriptorImageInfo);
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                stride = sizeof(VkBufferView);
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                stride = sizeof(VkDescriptorBufferInfo);
+                break;
+            case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+                /// descriptorCount у inline блока - это размер в байтах, stride драйвером игнорируется
+                stride = 1;
+                break;
+            default:
+                VK_ERROR("Shader::BuildUpdateTemplate() : descriptor type isn't supported by update template! "
+                         "Binding: " + std::to_string(binding.binding) + ", type: " + std::to_string(binding.descriptorType));
+                return false;
+        }
+
+        VkDescriptorUpdateTemplateEntry entry = {};
+        entry.dstBinding      = binding.binding;
+        entry.dstArrayElement = 0;
+        entry.descriptorCount = binding.descriptorCount;
+        entry.descriptorType  = binding.descriptorType;
+        entry.offset          = m_templateSize;
+        entry.stride          = stride;
+
+        m_templateEntries.emplace_back(entry);
+        m_templateSize += stride * binding.descriptorCount;
+
+        /// после inline блока выравниваем, чтобы следующие info структуры лежали по своей границе
+        m_templateSize = (m_templateSize + alignof(VkDescriptorBufferInfo) - 1) & ~(alignof(VkDescriptorBufferInfo) - 1);
+    }
+
+    if (m_templateEntries.empty()) {
+        return true;
+    }
+
+    VkDescriptorUpdateTemplateCreateInfo templateCI = {};
+    templateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    templateCI.descriptorUpdateEntryCount = static_cast<uint32_t>(m_templateEntries.size());
+    templateCI.pDescriptorUpdateEntries   = m_templateEntries.data();
+    templateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    templateCI.descriptorSetLayout        = m_descriptorSetLayout;
+
+    if (m_pushDescriptors) {
+        templateCI.templateType      = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+        templateCI.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        templateCI.pipelineLayout    = m_pipelineLayout;
+        templateCI.set               = 0;
+    }
+
+    auto result = vkCreateDescriptorUpdateTemplate(*m_device, &templateCI, Memory::GetAllocationCallbacks(), &m_updateTemplate);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("Shader::BuildUpdateTemplate() : failed to create descriptor update template!"
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result));
+        return false;
+    }
+
+    return true;
+}
+
+const VkDescriptorUpdateTemplateEntry* EvoVulkan::Complexes::Shader::GetTemplateEntry(uint32_t binding) const {
+    for (auto&& entry : m_templateEntries) {
+        if (entry.dstBinding == binding) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+bool EvoVulkan::Complexes::Shader::IsUpdateDataComplete(const DescriptorUpdateData& data) const {
+    bool complete = true;
+
+    for (auto&& entry : m_templateEntries) {
+        if (!data.IsSet(entry.dstBinding)) {
+            VK_ERROR("Shader::IsUpdateDataComplete() : binding isn't set! Binding: " + std::to_string(entry.dstBinding));
+            complete = false;
+        }
+    }
+
+    return complete;
+}
+
+EvoVulkan::Complexes::DescriptorUpdateData EvoVulkan::Complexes::Shader::CreateUpdateData() const {
+    DescriptorUpdateData data;
+
+    if (m_updateTemplate == VK_NULL_HANDLE) {
+        VK_ERROR("Shader::CreateUpdateData() : update template isn't created! Compile the shader first.");
+        return data;
+    }
+
+    data.m_shader = this;
+    data.m_data.resize(m_templateSize, 0);
+
+    return data;
+}
+
+bool EvoVulkan::Complexes::Shader::UpdateDescriptorSet(VkDescriptorSet descriptorSet, const DescriptorUpdateData& data) const {
+    if (m_pushDescriptors) {
+        VK_ERROR("Shader::UpdateDescriptorSet() : push descriptor shader has no descriptor sets!");
+        return false;
+    }
+
+    if (descriptorSet == VK_NULL_HANDLE || !data.Valid() || data.m_shader != this) {
+        VK_ERROR("Shader::UpdateDescriptorSet() : invalid descriptor set or update data!");
+        return false;
+    }
+
+    if (!IsUpdateDataComplete(data)) {
+        VK_ERROR("Shader::UpdateDescriptorSet() : not all bindings are set!");
+        return false;
+    }
+
+    vkUpdateDescriptorSetWithTemplate(*m_device, descriptorSet, m_updateTemplate, data.GetData());
+
+    return true;
+}
+
+//!=====================================================================================================================
+
+template<typename T> bool EvoVulkan::Complexes::DescriptorUpdateData::Set(
+        uint32_t binding,
+        uint32_t arrayElement,
+        const T& value,
+        bool(*isValidType)(VkDescriptorType))
+{
+    if (!m_shader) {
+        VK_ERROR("DescriptorUpdateData::Set() : update data isn't created by shader!");
+        return false;
+    }
+
+    auto&& entry = m_shader->GetTemplateEntry(binding);
+    if (!entry || arrayElement >= entry->descriptorCount || entry->stride != sizeof(T) || !isValidType(entry->descriptorType)) {
+        VK_ERROR("DescriptorUpdateData::Set() : binding doesn't match the shader layout! Binding: " + std::to_string(binding));
+        return false;
+    }
+
+    memcpy(m_data.data() + entry->offset + entry->stride * arrayElement, &value, sizeof(T));
+    m_bindings.insert(binding);
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::DescriptorUpdateData::SetImage(uint32_t binding, const VkDescriptorImageInfo& info, uint32_t arrayElement) {
+    return Set(binding, arrayElement, info, [](VkDescriptorType type) {
+        return (type >= VK_DESCRIPTOR_TYPE_SAMPLER && type <= VK_DESCRIPTOR_TYPE_STORAGE_IMAGE) || type == VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+    });
+}
+
+bool EvoVulkan::Complexes::DescriptorUpdateData::SetBuffer(uint32_t binding, const VkDescriptorBufferInfo& info, uint32_t arrayElement) {
+    return Set(binding, arrayElement, info, [](VkDescriptorType type) {
+        return type >= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER && type <= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    });
+}
+
+bool EvoVulkan::Complexes::DescriptorUpdateData::SetTexelBuffer(uint32_t binding, VkBufferView view, uint32_t arrayElement) {
+    return Set(binding, arrayElement, view, [](VkDescriptorType type) {
+        return type == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+    });
+}
+
+bool EvoVulkan::Complexes::DescriptorUpdateData::SetInlineUniformBlock(uint32_t binding, const void* data, uint32_t size, uint32_t offset) {
+    if (!m_shader || !data) {
+        VK_ERROR("DescriptorUpdateData::SetInlineUniformBlock() : update data isn't created by shader or data is nullptr!");
+        return false;
+    }
+
+    auto&& entry = m_shader->GetTemplateEntry(binding);
+    if (!entry || entry->descriptorType != VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT || offset + size > entry->descriptorCount) {
+        VK_ERROR("DescriptorUpdateData::SetInlineUniformBlock() : binding doesn't match the shader layout! Binding: " + std::to_string(binding));
+        return false;
+    }
+
+    memcpy(m_data.data() + entry->offset + offset, data, size);
+    m_bindings.insert(binding);
+
     return true;
 }
 
 void EvoVulkan::Complexes::Shader::Destroy() {
-    if (m_descriptorSetLayout != VK_NULL_HANDLE) {
-        vkDestroyDescriptorSetLayout(*m_device, m_descriptorSetLayout, nullptr);
-        m_descriptorSetLayout = VK_NULL_HANDLE;
+    if (m_updateTemplate != VK_NULL_HANDLE) {
+        vkDestroyDescriptorUpdateTemplate(*m_device, m_updateTemplate, Memory::GetAllocationCallbacks());
+        m_updateTemplate = VK_NULL_HANDLE;
     }
+    m_templateEntries.clear();
 
     if (m_pipelineLayout != VK_NULL_HANDLE) {
-        vkDestroyPipelineLayout(*m_device, m_pipelineLayout, nullptr);
+        m_device->GetLayoutCache()->ReleasePipelineLayout(m_pipelineLayout);
         m_pipelineLayout = VK_NULL_HANDLE;
     }
 
+    if (m_descriptorSetLayout != VK_NULL_HANDLE) {
+        /// лейаут общий, статистику пулов убираем только вместе с последним шейдером
+        if (auto&& manager = m_descriptorManager) {
+            m_device->GetLayoutCache()->ReleaseSetLayout(m_descriptorSetLayout, [manager](VkDescriptorSetLayout layout) {
+                manager->UnregisterLayout(layout);
+            });
+        }
+        else {
+            m_device->GetLayoutCache()->ReleaseSetLayout(m_descriptorSetLayout);
+        }
+
+        m_descriptorSetLayout = VK_NULL_HANDLE;
+    }
+
     for (auto&& module : m_shaderModules) {
-        vkDestroyShaderModule(*m_device, module, nullptr);
+        vkDestroyShaderModule(*m_device, module, Memory::GetAllocationCallbacks());
     }
     m_shaderModules.clear();
 
     if (m_pipeline != VK_NULL_HANDLE) {
-        vkDestroyPipeline(*m_device, m_pipeline, nullptr);
+        vkDestroyPipeline(*m_device, m_pipeline, Memory::GetAllocationCallbacks());
         m_pipeline = VK_NULL_HANDLE;
     }
 
@@ -0,0 +1,163 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Complexes/TextureAtlas.h>
+#include <EvoVulkan/Tools/FormatUtils.h>
+
+EvoVulkan::Complexes::TextureAtlas* EvoVulkan::Complexes::TextureAtlas::Create(
+        Types::Device* device,
+        Memory::Allocator* allocator,
+        Core::DescriptorManager* manager,
+        Types::CmdPool* pool,
+        VkFormat format,
+        uint32_t layerWidth,
+        uint32_t layerHeight,
+        uint32_t maxLayers,
+        VkFilter filter,
+        uint32_t padding)
+{
+    if (Tools::IsBlockCompressedFormat(format)) {
+        VK_ERROR("TextureAtlas::Create() : compressed formats are not supported!");
+        return nullptr;
+    }
+
+    auto&& texture = Types::Texture::CreateArray(device, allocator, manager, pool, format,
+                                                 static_cast<int32_t>(layerWidth), static_cast<int32_t>(layerHeight), maxLayers, filter);
+    if (!texture) {
+        VK_ERROR("TextureAtlas::Create() : failed to create texture array!");
+        return nullptr;
+    }
+
+    auto&& atlas = new TextureAtlas();
+    {
+        atlas->m_texture     = texture;
+        atlas->m_layerWidth  = layerWidth;
+        atlas->m_layerHeight = layerHeight;
+        atlas->m_maxLayers   = maxLayers;
+        atlas->m_padding     = padding;
+    }
+
+    return atlas;
+}
+
+EvoVulkan::Complexes::AtlasRegion EvoVulkan::Complexes::TextureAtlas::Add(const uint8_t* pixels, uint32_t width, uint32_t height) {
+    return Add(std::vector<AtlasImage> { AtlasImage { pixels, width, height } }).front();
+}
+
+std::vector<EvoVulkan::Complexes::AtlasRegion> EvoVulkan::Complexes::TextureAtlas::Add(const std::vector<AtlasImage>& images) {
+    std::vector<AtlasRegion> regions(images.size());
+
+    std::vector<Types::TextureRegion> copies;
+    copies.reserve(images.size());
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        auto&& image = images[i];
+
+        if (!image.m_pixels || image.m_width == 0 || image.m_height == 0) {
+            VK_ERROR("TextureAtlas::Add() : invalid image! Index: " + std::to_string(i));
+            continue;
+        }
+
+        if (!Pack(image.m_width, image.m_height, regions[i])) {
+            VK_WARN("TextureAtlas::Add() : atlas is full! Image: " + std::to_string(image.m_width) + "x" + std::to_string(image.m_height));
+            regions[i] = AtlasRegion();
+            continue;
+        }
+
+        copies.emplace_back(Types::TextureRegion {
+                image.m_pixels, regions[i].m_layer, regions[i].m_x, regions[i].m_y, image.m_width, image.m_height
+        });
+    }
+
+    if (!m_texture->CopyRegions(copies)) {
+        VK_ERROR("TextureAtlas::Add() : failed to copy images to atlas!");
+        return std::vector<AtlasRegion>(images.size());
+    }
+
+    m_regionsCount += static_cast<uint32_t>(copies.size());
+
+    return regions;
+}
+
+bool EvoVulkan::Complexes::TextureAtlas::Pack(uint32_t width, uint32_t height, EvoVulkan::Complexes::AtlasRegion &region) {
+    const uint32_t paddedWidth  = width + m_padding * 2;
+    const uint32_t paddedHeight = height + m_padding * 2;
+
+    if (paddedWidth > m_layerWidth || paddedHeight > m_layerHeight)
+        return false;
+
+    uint32_t x = 0, y = 0;
+    uint32_t layerIndex = 0;
+
+    for (; layerIndex < m_layers.size(); ++layerIndex) {
+        if (PackInLayer(m_layers[layerIndex], paddedWidth, paddedHeight, x, y))
+            break;
+    }
+
+    if (layerIndex == m_layers.size()) {
+        if (m_layers.size() >= m_maxLayers)
+            return false;
+
+        m_layers.emplace_back(Layer());
+
+        if (!PackInLayer(m_layers.back(), paddedWidth, paddedHeight, x, y))
+            return false;
+    }
+
+    region.m_layer  = layerIndex;
+    region.m_x      = x + m_padding;
+    region.m_y      = y + m_padding;
+    region.m_width  = width;
+    region.m_height = height;
+    region.m_u0     = static_cast<float_t>(region.m_x) / static_cast<float_t>(m_layerWidth);
+    region.m_v0     = static_cast<float_t>(region.m_y) / static_cast<float_t>(m_layerHeight);
+    region.m_u1     = static_cast<float_t>(region.m_x + width) / static_cast<float_t>(m_layerWidth);
+    region.m_v1     = static_cast<float_t>(region.m_y + height) / static_cast<float_t>(m_layerHeight);
+
+    return true;
+}
+
+bool EvoVulkan::Complexes::TextureAtlas::PackInLayer(Layer& layer, uint32_t width, uint32_t height, uint32_t& x, uint32_t& y) const {
+    Shelf* best = nullptr;
+
+    /// выбираем полку с наименьшей потерей по высоте
+    for (auto&& shelf : layer.m_shelves) {
+        if (shelf.m_height < height || shelf.m_x + width > m_layerWidth)
+            continue;
+
+        if (!best || shelf.m_height < best->m_height)
+            best = &shelf;
+    }
+
+    if (!best) {
+        if (layer.m_top + height > m_layerHeight)
+            return false;
+
+        layer.m_shelves.emplace_back(Shelf { layer.m_top, height, 0 });
+        layer.m_top += height;
+
+        best = &layer.m_shelves.back();
+    }
+
+    x = best->m_x;
+    y = best->m_y;
+
+    best->m_x += width;
+
+    return true;
+}
+
+void EvoVulkan::Complexes::TextureAtlas::Clear() {
+    m_layers.clear();
+    m_regionsCount = 0;
+}
+
+void EvoVulkan::Complexes::TextureAtlas::Destroy() {
+    Clear();
+    EVSafeFreeObject(m_texture);
+}
+
+void EvoVulkan::Complexes::TextureAtlas::Free() {
+    delete this;
+}
@@ -0,0 +1,334 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/DescriptorBuffer.h>
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Types/VulkanBuffer.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Core {
+    DescriptorBuffer* DescriptorBuffer::Create(Types::Device* device, Memory::Allocator* allocator, VkDeviceSize size) {
+        if (!device || !allocator) {
+            VK_ERROR("DescriptorBuffer::Create() : device or allocator is nullptr!");
+            return nullptr;
+        }
+
+        if (!device->GetFeatures().m_descriptorBuffer) {
+            VK_ERROR("DescriptorBuffer::Create() : descriptor buffer isn't supported by device!");
+            return nullptr;
+        }
+
+        auto&& properties = device->GetDescriptorBufferProperties();
+
+        /// в одном буфере лежат и семплеры, и ресурсы, поэтому он ограничен меньшим из диапазонов
+        size = EVK_MIN(size, EVK_MIN(properties.maxResourceDescriptorBufferRange, properties.maxSamplerDescriptorBufferRange));
+
+        auto&& descriptorBuffer = new DescriptorBuffer();
+
+        descriptorBuffer->m_device    = device;
+        descriptorBuffer->m_size      = size;
+        descriptorBuffer->m_alignment = EVK_MAX(properties.descriptorBufferOffsetAlignment, static_cast<VkDeviceSize>(1));
+        descriptorBuffer->m_usage     = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+                                        VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                                        VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+        descriptorBuffer->m_buffer = Types::Buffer::Create(
+                device,
+                allocator,
+                descriptorBuffer->m_usage,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                size,
+                nullptr,
+                true /** persistentMapped */);
+
+        if (!descriptorBuffer->m_buffer) {
+            VK_ERROR("DescriptorBuffer::Create() : failed to create descriptor buffer!");
+            delete descriptorBuffer;
+            return nullptr;
+        }
+
+        if (!(descriptorBuffer->m_mapped = static_cast<uint8_t*>(descriptorBuffer->m_buffer->GetPersistentData()))) {
+            VK_ERROR("DescriptorBuffer::Create() : failed to map descriptor buffer!");
+            descriptorBuffer->Destroy();
+            descriptorBuffer->Free();
+            return nullptr;
+        }
+
+        VkBufferDeviceAddressInfo addressInfo = {};
+        addressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.buffer = *descriptorBuffer->m_buffer;
+
+        descriptorBuffer->m_address = vkGetBufferDeviceAddress(*device, &addressInfo);
+        descriptorBuffer->m_freeRanges.insert(std::make_pair(0, size));
+
+        VK_LOG("DescriptorBuffer::Create() : descriptor buffer created with size " + std::to_string(size) + " bytes.");
+
+        return descriptorBuffer;
+    }
+
+    DescriptorBufferSet DescriptorBuffer::Allocate(VkDescriptorSetLayout layout) {
+        if (layout == VK_NULL_HANDLE) {
+            VK_ERROR("DescriptorBuffer::Allocate() : layout is nullptr!");
+            return DescriptorBufferSet();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        const VkDeviceSize size = GetLayoutSize(layout);
+
+        /// все участки кратны выравниванию, поэтому смещения всегда выровнены
+        for (auto&& rangeIt = m_freeRanges.begin(); rangeIt != m_freeRanges.end(); ++rangeIt) {
+            auto&& [offset, rangeSize] = *rangeIt;
+
+            if (rangeSize < size) {
+                continue;
+            }
+
+            DescriptorBufferSet set = { layout, offset, size };
+
+            if (rangeSize > size) {
+                m_freeRanges.insert(std::make_pair(offset + size, rangeSize - size));
+            }
+
+            m_freeRanges.erase(rangeIt);
+            m_used += size;
+
+            return set;
+        }
+
+        VK_ERROR("DescriptorBuffer::Allocate() : descriptor buffer is out of memory! "
+                 "Used: " + std::to_string(m_used) + ", size: " + std::to_string(m_size));
+
+        return DescriptorBufferSet();
+    }
+
+    void DescriptorBuffer::Free(DescriptorBufferSet& set) {
+        if (!set.Valid()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        VkDeviceSize offset = set.m_offset;
+        VkDeviceSize size   = set.m_size;
+
+        m_used -= EVK_MIN(m_used, size);
+
+        auto&& nextIt = m_freeRanges.lower_bound(offset);
+
+        if (nextIt != m_freeRanges.end() && offset + size == nextIt->first) {
+            size += nextIt->second;
+            nextIt = m_freeRanges.erase(nextIt);
+        }
+
+        if (nextIt != m_freeRanges.begin()) {
+            auto&& prevIt = std::prev(nextIt);
+            if (prevIt->first + prevIt->second == offset) {
+                prevIt->second += size;
+                set = DescriptorBufferSet();
+                return;
+            }
+        }
+
+        m_freeRanges.insert(std::make_pair(offset, size));
+
+        set = DescriptorBufferSet();
+    }
+
+    bool DescriptorBuffer::WriteImage(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type,
+                                      const VkDescriptorImageInfo& info, uint32_t arrayElement)
+    {
+        VkDescriptorGetInfoEXT getInfo = {};
+        getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+        getInfo.type  = type;
+
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                getInfo.data.pSampler = &info.sampler;
+                break;
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+                getInfo.data.pCombinedImageSampler = &info;
+                break;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                getInfo.data.pSampledImage = &info;
+                break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                getInfo.data.pStorageImage = &info;
+                break;
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                getInfo.data.pInputAttachmentImage = &info;
+                break;
+            default:
+                VK_ERROR("DescriptorBuffer::WriteImage() : descriptor type isn't an image type! Type: " + std::to_string(type));
+                return false;
+        }
+
+        return Write(set, binding, arrayElement, getInfo);
+    }
+
+    bool DescriptorBuffer::WriteBuffer(const DescriptorBufferSet& set, uint32_t binding, VkDescriptorType type,
+                                       const VkDescriptorBufferInfo& info, uint32_t arrayElement)
+    {
+        if (info.buffer == VK_NULL_HANDLE || info.range == VK_WHOLE_SIZE) {
+            VK_ERROR("DescriptorBuffer::WriteBuffer() : buffer is nullptr or range isn't specified!");
+            return false;
+        }
+
+        VkBufferDeviceAddressInfo bufferAddressInfo = {};
+        bufferAddressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        bufferAddressInfo.buffer = info.buffer;
+
+        VkDescriptorAddressInfoEXT addressInfo = {};
+        addressInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+        addressInfo.address = vkGetBufferDeviceAddress(*m_device, &bufferAddressInfo) + info.offset;
+        addressInfo.range   = info.range;
+        addressInfo.format  = VK_FORMAT_UNDEFINED;
+
+        VkDescriptorGetInfoEXT getInfo = {};
+        getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+        getInfo.type  = type;
+
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                getInfo.data.pUniformBuffer = &addressInfo;
+                break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                getInfo.data.pStorageBuffer = &addressInfo;
+                break;
+            default:
+                VK_ERROR("DescriptorBuffer::WriteBuffer() : descriptor type isn't supported! Type: " + std::to_string(type));
+                return false;
+        }
+
+        return Write(set, binding, arrayElement, getInfo);
+    }
+
+    bool DescriptorBuffer::WriteInlineBlock(const DescriptorBufferSet& set, uint32_t binding, const void* data, uint32_t size, uint32_t offset) {
+        if (!set.Valid() || !data || size == 0) {
+            VK_ERROR("DescriptorBuffer::WriteInlineBlock() : descriptor buffer set is invalid or data is empty!");
+            return false;
+        }
+
+        if (size % 4 != 0 || offset % 4 != 0) {
+            VK_ERROR("DescriptorBuffer::WriteInlineBlock() : size and offset must be multiple of 4! Binding: " + std::to_string(binding));
+            return false;
+        }
+
+        VkDeviceSize bindingOffset = 0;
+        m_device->GetDescriptorBufferFunctions().m_getBindingOffset(*m_device, set.m_layout, binding, &bindingOffset);
+
+        const VkDeviceSize begin = bindingOffset + offset;
+        if (begin + size > set.m_size) {
+            VK_ERROR("DescriptorBuffer::WriteInlineBlock() : data is out of set range! Binding: " + std::to_string(binding) +
+                     ", offset: " + std::to_string(offset) + ", size: " + std::to_string(size));
+            return false;
+        }
+
+        memcpy(m_mapped + set.m_offset + begin, data, size);
+
+        return true;
+    }
+
+    bool DescriptorBuffer::Write(const DescriptorBufferSet& set, uint32_t binding, uint32_t arrayElement, const VkDescriptorGetInfoEXT& info) {
+        if (!set.Valid()) {
+            VK_ERROR("DescriptorBuffer::Write() : descriptor buffer set is invalid!");
+            return false;
+        }
+
+        auto&& functions = m_device->GetDescriptorBufferFunctions();
+
+        const size_t descriptorSize = GetDescriptorSize(info.type);
+
+        VkDeviceSize bindingOffset = 0;
+        functions.m_getBindingOffset(*m_device, set.m_layout, binding, &bindingOffset);
+
+        const VkDeviceSize offset = bindingOffset + arrayElement * descriptorSize;
+        if (descriptorSize == 0 || offset + descriptorSize > set.m_size) {
+            VK_ERROR("DescriptorBuffer::Write() : descriptor is out of set range! Binding: " + std::to_string(binding) +
+                     ", array element: " + std::to_string(arrayElement));
+            return false;
+        }
+
+        functions.m_getDescriptor(*m_device, &info, descriptorSize, m_mapped + set.m_offset + offset);
+
+        return true;
+    }
+
+    void DescriptorBuffer::BindBuffer(const VkCommandBuffer& cmd) const {
+        VkDescriptorBufferBindingInfoEXT bindingInfo = {};
+        bindingInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+        bindingInfo.address = m_address;
+        bindingInfo.usage   = m_usage;
+
+        m_device->GetDescriptorBufferFunctions().m_cmdBindBuffers(cmd, 1, &bindingInfo);
+    }
+
+    void DescriptorBuffer::Bind(const VkCommandBuffer& cmd, VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+                                uint32_t firstSet, const DescriptorBufferSet& set) const
+    {
+        const uint32_t     bufferIndex = 0;
+        const VkDeviceSize offset      = set.m_offset;
+
+        m_device->GetDescriptorBufferFunctions().m_cmdSetBufferOffsets(cmd, bindPoint, layout, firstSet, 1, &bufferIndex, &offset);
+    }
+
+    VkDeviceSize DescriptorBuffer::GetLayoutSize(VkDescriptorSetLayout layout) {
+        if (auto&& sizeIt = m_layoutSizes.find(layout); sizeIt != m_layoutSizes.end()) {
+            return sizeIt->second;
+        }
+
+        VkDeviceSize size = 0;
+        m_device->GetDescriptorBufferFunctions().m_getLayoutSize(*m_device, layout, &size);
+
+        size = ((size + m_alignment - 1) / m_alignment) * m_alignment;
+
+        m_layoutSizes.insert(std::make_pair(layout, size));
+
+        return size;
+    }
+
+    size_t DescriptorBuffer::GetDescriptorSize(VkDescriptorType type) const {
+        auto&& properties = m_device->GetDescriptorBufferProperties();
+
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:                return properties.samplerDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: return properties.combinedImageSamplerDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:          return properties.sampledImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:          return properties.storageImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:       return properties.inputAttachmentDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:         return properties.uniformBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:         return properties.storageBufferDescriptorSize;
+            /// данные inline блока пишутся напрямую, см. WriteInlineBlock
+            case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+            default:
+                return 0;
+        }
+    }
+
+    VkDeviceSize DescriptorBuffer::GetUsedSize() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_used;
+    }
+
+    void DescriptorBuffer::Destroy() {
+        if (m_used > 0) {
+            VK_WARN("DescriptorBuffer::Destroy() : not all descriptor buffer sets have been freed! Used: " + std::to_string(m_used));
+        }
+
+        if (m_buffer) {
+            m_buffer->Unmap();
+            EVSafeFreeObject(m_buffer);
+        }
+
+        m_mapped = nullptr;
+        m_address = 0;
+
+        m_freeRanges.clear();
+        m_layoutSizes.clear();
+    }
+
+    void DescriptorBuffer::Free() {
+        delete this;
+    }
+}
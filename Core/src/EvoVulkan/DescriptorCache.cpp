@@ -0,0 +1,473 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/DescriptorCache.h>
+#include <EvoVulkan/DescriptorManager.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Tools/HashUtils.h>
+
+namespace EvoVulkan::Core {
+    bool DescriptorWrite::IsImage() const {
+        switch (m_type) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool DescriptorWrite::Uses(uint64_t handle) const {
+        if (IsImage()) {
+            return reinterpret_cast<uint64_t>(m_image.sampler) == handle || reinterpret_cast<uint64_t>(m_image.imageView) == handle;
+        }
+
+        return reinterpret_cast<uint64_t>(m_buffer.buffer) == handle;
+    }
+
+    bool DescriptorWrite::Replace(uint64_t oldHandle, uint64_t newHandle) {
+        bool replaced = false;
+
+        if (IsImage()) {
+            if (reinterpret_cast<uint64_t>(m_image.sampler) == oldHandle) {
+                m_image.sampler = reinterpret_cast<VkSampler>(newHandle);
+                replaced = true;
+            }
+
+            if (reinterpret_cast<uint64_t>(m_image.imageView) == oldHandle) {
+                m_image.imageView = reinterpret_cast<VkImageView>(newHandle);
+                replaced = true;
+            }
+        }
+        else if (reinterpret_cast<uint64_t>(m_buffer.buffer) == oldHandle) {
+            m_buffer.buffer = reinterpret_cast<VkBuffer>(newHandle);
+            replaced = true;
+        }
+
+        return replaced;
+    }
+
+    bool DescriptorWrite::operator==(const DescriptorWrite& other) const {
+        if (m_binding != other.m_binding || m_arrayElement != other.m_arrayElement || m_type != other.m_type) {
+            return false;
+        }
+
+        if (IsImage()) {
+            return m_image.sampler     == other.m_image.sampler &&
+                   m_image.imageView   == other.m_image.imageView &&
+                   m_image.imageLayout == other.m_image.imageLayout;
+        }
+
+        return m_buffer.buffer == other.m_buffer.buffer &&
+               m_buffer.offset == other.m_buffer.offset &&
+               m_buffer.range  == other.m_buffer.range;
+    }
+
+    //!=================================================================================================================
+
+    DescriptorWrites& DescriptorWrites::AddImage(uint32_t binding, VkDescriptorType type, const VkDescriptorImageInfo& info, uint32_t arrayElement) {
+        DescriptorWrite write;
+        write.m_binding      = binding;
+        write.m_arrayElement = arrayElement;
+        write.m_type         = type;
+        write.m_image        = info;
+
+        Insert(write);
+
+        return *this;
+    }
+
+    DescriptorWrites& DescriptorWrites::AddBuffer(uint32_t binding, VkDescriptorType type, const VkDescriptorBufferInfo& info, uint32_t arrayElement) {
+        DescriptorWrite write;
+        write.m_binding      = binding;
+        write.m_arrayElement = arrayElement;
+        write.m_type         = type;
+        write.m_buffer       = info;
+
+        Insert(write);
+
+        return *this;
+    }
+
+    void DescriptorWrites::Insert(const DescriptorWrite& write) {
+        auto&& it = std::lower_bound(m_writes.begin(), m_writes.end(), write, [](const DescriptorWrite& lhs, const DescriptorWrite& rhs) {
+            return lhs.m_binding != rhs.m_binding ? lhs.m_binding < rhs.m_binding : lhs.m_arrayElement < rhs.m_arrayElement;
+        });
+
+        /// повторная запись в тот же элемент заменяет предыдущую
+        if (it != m_writes.end() && it->m_binding == write.m_binding && it->m_arrayElement == write.m_arrayElement) {
+            *it = write;
+        }
+        else
+            m_writes.insert(it, write);
+    }
+
+    bool DescriptorWrites::Replace(uint64_t oldHandle, uint64_t newHandle) {
+        bool replaced = false;
+
+        for (auto&& write : m_writes) {
+            replaced |= write.Replace(oldHandle, newHandle);
+        }
+
+        return replaced;
+    }
+
+    std::set<VkDescriptorType> DescriptorWrites::GetTypes() const {
+        std::set<VkDescriptorType> types;
+
+        for (auto&& write : m_writes) {
+            types.insert(write.m_type);
+        }
+
+        return types;
+    }
+
+    size_t DescriptorCacheKeyHash::operator()(const DescriptorCacheKey& key) const {
+        size_t hash = 0;
+
+        Tools::HashCombine(hash, reinterpret_cast<uintptr_t>(key.m_layout));
+
+        for (auto&& write : key.m_writes.GetWrites()) {
+            Tools::HashCombine(hash, write.m_binding, write.m_arrayElement, static_cast<uint32_t>(write.m_type));
+
+            if (write.IsImage()) {
+                Tools::HashCombine(hash,
+                        reinterpret_cast<uintptr_t>(write.m_image.sampler),
+                        reinterpret_cast<uintptr_t>(write.m_image.imageView),
+                        static_cast<uint32_t>(write.m_image.imageLayout));
+            }
+            else {
+                Tools::HashCombine(hash,
+                        reinterpret_cast<uintptr_t>(write.m_buffer.buffer),
+                        write.m_buffer.offset,
+                        write.m_buffer.range);
+            }
+        }
+
+        return hash;
+    }
+
+    //!=================================================================================================================
+
+    DescriptorCache* DescriptorCache::Create(const VkDevice& device, DescriptorManager* manager, uint32_t unusedLimit) {
+        if (!manager) {
+            VK_ERROR("DescriptorCache::Create() : descriptor manager is nullptr!");
+            return nullptr;
+        }
+
+        auto&& cache = new DescriptorCache();
+
+        cache->m_device      = device;
+        cache->m_manager     = manager;
+        cache->m_unusedLimit = unusedLimit;
+
+        return cache;
+    }
+
+    Types::DescriptorSet DescriptorCache::Acquire(VkDescriptorSetLayout layout, const DescriptorWrites& writes) {
+        if (layout == VK_NULL_HANDLE || writes.Empty()) {
+            VK_ERROR("DescriptorCache::Acquire() : invalid layout or writes!");
+            return Types::DescriptorSet();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        DescriptorCacheKey key = { layout, writes };
+
+        if (auto&& entryIt = m_entries.find(key); entryIt != m_entries.end()) {
+            auto&& entry = entryIt->second;
+
+            if (entry.m_references == 0) {
+                m_unused.erase(entry.m_unusedIt);
+                entry.m_unusedIt = m_unused.end();
+            }
+
+            ++entry.m_references;
+            ++m_hits;
+
+            return entry.m_set;
+        }
+
+        ++m_misses;
+
+        auto&& set = m_manager->AllocateDescriptorSet(layout, writes.GetTypes());
+        if (!set.Valid()) {
+            VK_ERROR("DescriptorCache::Acquire() : failed to allocate descriptor set!");
+            return Types::DescriptorSet();
+        }
+
+        std::vector<VkWriteDescriptorSet> vkWrites;
+        vkWrites.reserve(writes.GetWrites().size());
+
+        for (auto&& write : writes.GetWrites()) {
+            VkWriteDescriptorSet vkWrite = {};
+            vkWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            vkWrite.dstSet          = set;
+            vkWrite.dstBinding      = write.m_binding;
+            vkWrite.dstArrayElement = write.m_arrayElement;
+            vkWrite.descriptorType  = write.m_type;
+            vkWrite.descriptorCount = 1;
+
+            if (write.IsImage())
+                vkWrite.pImageInfo = &write.m_image;
+            else
+                vkWrite.pBufferInfo = &write.m_buffer;
+
+            vkWrites.emplace_back(vkWrite);
+        }
+
+        vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(vkWrites.size()), vkWrites.data(), 0, nullptr);
+
+        auto&& [entryIt, inserted] = m_entries.emplace(key, Entry { set, 1, m_unused.end() });
+        m_sets[set] = &entryIt->first;
+        Index(&entryIt->first);
+
+        return set;
+    }
+
+    bool DescriptorCache::Release(const Types::DescriptorSet& set) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto&& setIt = m_sets.find(set.m_self);
+        if (setIt == m_sets.end()) {
+            VK_ERROR("DescriptorCache::Release() : descriptor set isn't cached!");
+            return false;
+        }
+
+        auto&& entryIt = m_entries.find(*setIt->second);
+        auto&& entry = entryIt->second;
+
+        if (entry.m_references == 0) {
+            VK_ERROR("DescriptorCache::Release() : descriptor set is already released!");
+            return false;
+        }
+
+        if (--entry.m_references > 0) {
+            return true;
+        }
+
+        entry.m_unusedIt = m_unused.insert(m_unused.end(), set.m_self);
+
+        /// вытесняем самые старые неиспользуемые сеты
+        while (m_unused.size() > m_unusedLimit) {
+            Erase(m_entries.find(*m_sets[m_unused.front()]));
+        }
+
+        return true;
+    }
+
+    void DescriptorCache::Evict(uint64_t handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto&& key : GetKeys(handle)) {
+            auto&& entryIt = m_entries.find(*key);
+
+            if (entryIt->second.m_references > 0) {
+                VK_WARN("DescriptorCache::Evict() : resource is destroyed while descriptor set is still in use!");
+                continue;
+            }
+
+            Erase(entryIt);
+        }
+    }
+
+    void DescriptorCache::Relocate(uint64_t oldHandle, uint64_t newHandle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        /// ключ кэша зависит от хендлов, поэтому записи вынимаются целиком и вставляются под новыми ключами
+        std::vector<std::pair<DescriptorCacheKey, Entry>> relocated;
+
+        for (auto&& key : GetKeys(oldHandle)) {
+            auto&& entryIt = m_entries.find(*key);
+
+            Unindex(key);
+            relocated.emplace_back(entryIt->first, entryIt->second);
+            m_entries.erase(entryIt);
+        }
+
+        for (auto&& [key, entry] : relocated) {
+            key.m_writes.Replace(oldHandle, newHandle);
+
+            std::vector<Types::DescriptorSet> sets = { entry.m_set };
+            sets.insert(sets.end(), entry.m_aliases.begin(), entry.m_aliases.end());
+
+            std::vector<VkWriteDescriptorSet> vkWrites;
+            vkWrites.reserve(key.m_writes.GetWrites().size() * sets.size());
+
+            for (auto&& set : sets) {
+                for (auto&& write : key.m_writes.GetWrites()) {
+                    if (!write.Uses(newHandle)) {
+                        continue;
+                    }
+
+                    VkWriteDescriptorSet vkWrite = {};
+                    vkWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    vkWrite.dstSet          = set;
+                    vkWrite.dstBinding      = write.m_binding;
+                    vkWrite.dstArrayElement = write.m_arrayElement;
+                    vkWrite.descriptorType  = write.m_type;
+                    vkWrite.descriptorCount = 1;
+
+                    if (write.IsImage())
+                        vkWrite.pImageInfo = &write.m_image;
+                    else
+                        vkWrite.pBufferInfo = &write.m_buffer;
+
+                    vkWrites.emplace_back(vkWrite);
+                }
+            }
+
+            vkUpdateDescriptorSets(m_device, static_cast<uint32_t>(vkWrites.size()), vkWrites.data(), 0, nullptr);
+
+            auto&& [entryIt, inserted] = m_entries.emplace(key, entry);
+            if (inserted) {
+                for (auto&& set : sets) {
+                    m_sets[set.m_self] = &entryIt->first;
+                }
+                Index(&entryIt->first);
+                continue;
+            }
+
+            /// такой ключ уже есть: сет с новым хендлом успели запросить до переноса
+            if (entry.m_references == 0) {
+                /// перенесенный сет никто не держит, возвращаем его менеджеру
+                if (entry.m_unusedIt != m_unused.end()) {
+                    m_unused.erase(entry.m_unusedIt);
+                }
+
+                for (auto&& set : sets) {
+                    m_sets.erase(set.m_self);
+                    m_manager->FreeDescriptorSet(&set);
+                }
+
+                continue;
+            }
+
+            /// сеты еще используются, они становятся псевдонимами существующей записи и делят ее ссылки
+            auto&& existing = entryIt->second;
+
+            if (existing.m_references == 0) {
+                m_unused.erase(existing.m_unusedIt);
+                existing.m_unusedIt = m_unused.end();
+            }
+
+            existing.m_references += entry.m_references;
+
+            for (auto&& set : sets) {
+                existing.m_aliases.emplace_back(set);
+                m_sets[set.m_self] = &entryIt->first;
+            }
+        }
+    }
+
+    void DescriptorCache::EvictUnused() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        while (!m_unused.empty()) {
+            Erase(m_entries.find(*m_sets[m_unused.front()]));
+        }
+    }
+
+    void DescriptorCache::Erase(Entries::iterator entryIt) {
+        auto&& entry = entryIt->second;
+
+        if (entry.m_unusedIt != m_unused.end()) {
+            m_unused.erase(entry.m_unusedIt);
+        }
+
+        Unindex(&entryIt->first);
+
+        for (auto&& alias : entry.m_aliases) {
+            m_sets.erase(alias.m_self);
+            m_manager->FreeDescriptorSet(&alias);
+        }
+
+        m_sets.erase(entry.m_set.m_self);
+        m_manager->FreeDescriptorSet(&entry.m_set);
+        m_entries.erase(entryIt);
+    }
+
+    void DescriptorCache::Index(const DescriptorCacheKey* key) {
+        for (auto&& write : key->m_writes.GetWrites()) {
+            if (write.IsImage()) {
+                if (write.m_image.sampler != VK_NULL_HANDLE)
+                    m_handles[reinterpret_cast<uint64_t>(write.m_image.sampler)].insert(key);
+
+                if (write.m_image.imageView != VK_NULL_HANDLE)
+                    m_handles[reinterpret_cast<uint64_t>(write.m_image.imageView)].insert(key);
+            }
+            else if (write.m_buffer.buffer != VK_NULL_HANDLE)
+                m_handles[reinterpret_cast<uint64_t>(write.m_buffer.buffer)].insert(key);
+        }
+    }
+
+    void DescriptorCache::Unindex(const DescriptorCacheKey* key) {
+        auto&& unindex = [this, key](uint64_t handle) {
+            if (auto&& handleIt = m_handles.find(handle); handleIt != m_handles.end()) {
+                handleIt->second.erase(key);
+                if (handleIt->second.empty()) {
+                    m_handles.erase(handleIt);
+                }
+            }
+        };
+
+        for (auto&& write : key->m_writes.GetWrites()) {
+            if (write.IsImage()) {
+                unindex(reinterpret_cast<uint64_t>(write.m_image.sampler));
+                unindex(reinterpret_cast<uint64_t>(write.m_image.imageView));
+            }
+            else
+                unindex(reinterpret_cast<uint64_t>(write.m_buffer.buffer));
+        }
+    }
+
+    std::vector<const DescriptorCacheKey*> DescriptorCache::GetKeys(uint64_t handle) const {
+        /// копия: Erase и Relocate меняют индекс во время обхода
+        if (auto&& handleIt = m_handles.find(handle); handleIt != m_handles.end()) {
+            return std::vector<const DescriptorCacheKey*>(handleIt->second.begin(), handleIt->second.end());
+        }
+
+        return { };
+    }
+
+    uint32_t DescriptorCache::GetSetsCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<uint32_t>(m_entries.size());
+    }
+
+    uint32_t DescriptorCache::GetUnusedCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<uint32_t>(m_unused.size());
+    }
+
+    uint64_t DescriptorCache::GetHits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hits;
+    }
+
+    uint64_t DescriptorCache::GetMisses() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_misses;
+    }
+
+    void DescriptorCache::Destroy() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_entries.size() != m_unused.size()) {
+            VK_WARN("DescriptorCache::Destroy() : not all cached descriptor sets have been released! Count: " +
+                    std::to_string(m_entries.size() - m_unused.size()));
+        }
+
+        while (!m_entries.empty()) {
+            Erase(m_entries.begin());
+        }
+    }
+
+    void DescriptorCache::Free() {
+        delete this;
+    }
+}
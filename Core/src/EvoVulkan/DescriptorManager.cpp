@@ -5,32 +5,162 @@
 #include <EvoVulkan/DescriptorManager.h>
 #include <EvoVulkan/Types/Device.h>
 #include <EvoVulkan/Types/DescriptorPool.h>
+#include <EvoVulkan/BindlessTextureTable.h>
+#include <EvoVulkan/DescriptorCache.h>
 #include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Tools/HashUtils.h>
 
 namespace EvoVulkan::Core {
+    namespace {
+        /// живые менеджеры, чтобы поток при завершении не обратился к уже удаленному
+        std::mutex                             g_descriptorManagersMutex;
+        std::unordered_set<DescriptorManager*> g_descriptorManagers;
+
+        /// возвращает пулы потока во все менеджеры, из которых он выделял сеты
+        struct ThreadCacheGuard {
+            std::unordered_set<DescriptorManager*> m_managers;
+
+            ~ThreadCacheGuard() {
+                std::lock_guard<std::mutex> lock(g_descriptorManagersMutex);
+
+                for (auto&& manager : m_managers) {
+                    if (g_descriptorManagers.count(manager) != 0) {
+                        manager->ReleaseThreadCache();
+                    }
+                }
+            }
+        };
+
+        thread_local ThreadCacheGuard g_threadCacheGuard;
+    }
+
+    size_t DescriptorPoolKeyHash::operator()(const DescriptorPoolKey& key) const {
+        size_t hash = 0;
+        Tools::HashCombine(hash, reinterpret_cast<uintptr_t>(key.m_layout), key.m_typeMask);
+        return hash;
+    }
+
+    void DescriptorManager::LayoutInfo::OnAllocate() {
+        const uint32_t live = ++m_liveSets;
+        ++m_allocations;
+
+        uint32_t peak = m_peakSets.load();
+        while (live > peak && !m_peakSets.compare_exchange_weak(peak, live)) { }
+    }
+
+    void DescriptorManager::LayoutInfo::OnFree() {
+        uint32_t live = m_liveSets.load();
+        while (live > 0 && !m_liveSets.compare_exchange_weak(live, live - 1)) { }
+    }
+
+    DescriptorLayoutStats DescriptorManager::LayoutInfo::GetStats() const {
+        DescriptorLayoutStats stats;
+
+        stats.m_liveSets    = m_liveSets;
+        stats.m_peakSets    = m_peakSets;
+        stats.m_pools       = m_pools;
+        stats.m_capacity    = m_capacity;
+        stats.m_allocations = m_allocations;
+
+        return stats;
+    }
+
     Types::DescriptorSet DescriptorManager::AllocateDescriptorSet(VkDescriptorSetLayout layout, const RequestTypes& requestTypes, bool reallocate) {
-        auto&& pool = reallocate ? nullptr : FindDescriptorPool(layout, requestTypes);
+        const DescriptorPoolKey key = { layout, Types::DescriptorPool::GetTypeMask(requestTypes) };
 
-        if (!pool) {
-            pool = AllocateDescriptorPool(layout, requestTypes);
+        if (!reallocate) {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+            if (auto&& set = AllocateFromThreadCache(key); set.Valid()) {
+                return set;
+            }
         }
 
-        if (!pool) {
-            VK_ERROR("DescriptorManager::AllocateDescriptorSets() : failed to allocate descriptor pool!");
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        return AllocateDescriptorSet(key, requestTypes, reallocate);
+    }
+
+    Types::DescriptorSet DescriptorManager::AllocateFromThreadCache(const DescriptorPoolKey& key) {
+        auto&& cacheIt = m_threadCaches.find(std::this_thread::get_id());
+        if (cacheIt == m_threadCaches.end()) {
+            return Types::DescriptorSet();
+        }
+
+        auto&& poolIt = cacheIt->second.find(key);
+        if (poolIt == cacheIt->second.end() || poolIt->second->IsOutOfMemory()) {
+            return Types::DescriptorSet();
+        }
+
+        /// пул закреплен за этим потоком, параллельно в него могут только возвращать сеты
+        auto&& [result, set] = poolIt->second->Allocate();
+        if (result != VK_SUCCESS) {
+            return Types::DescriptorSet();
+        }
+
+        if (auto&& layoutIt = m_layouts.find(key.m_layout); layoutIt != m_layouts.end()) {
+            layoutIt->second.OnAllocate();
+        }
+
+        return set;
+    }
+
+    Types::DescriptorSet DescriptorManager::AllocateDescriptorSet(const DescriptorPoolKey& key, const RequestTypes& requestTypes, bool reallocate) {
+        g_threadCacheGuard.m_managers.insert(this);
+
+        /// размеры пулов считаются по биндингам лейаута, без регистрации их взять неоткуда
+        auto&& layoutIt = m_layouts.find(key.m_layout);
+        if (layoutIt == m_layouts.end()) {
+            VK_ERROR("DescriptorManager::AllocateDescriptorSet() : layout isn't registered! Layout: " +
+                     std::to_string(reinterpret_cast<uintptr_t>(key.m_layout)));
             return Types::DescriptorSet();
         }
 
+        auto&& info = layoutIt->second;
+
+        auto&& pool = m_threadCaches[std::this_thread::get_id()][key];
+
+        /// текущий пул потока закончился, отдаем его обратно в корзину и закрепляем другой
+        if (pool && (reallocate || pool->IsOutOfMemory())) {
+            m_claimedPools.erase(pool);
+            ReturnDescriptorPool(pool);
+            pool = nullptr;
+        }
+
+        if (!pool) {
+            auto&& bucket = m_buckets[key];
+
+            pool = reallocate ? nullptr : FindDescriptorPool(bucket);
+
+            if (!pool) {
+                pool = AllocateDescriptorPool(bucket, key.m_layout, info, requestTypes);
+            }
+
+            if (!pool) {
+                if (bucket.m_pools.empty()) {
+                    m_buckets.erase(key);
+                }
+
+                m_threadCaches[std::this_thread::get_id()].erase(key);
+
+                VK_ERROR("DescriptorManager::AllocateDescriptorSets() : failed to allocate descriptor pool!");
+                return Types::DescriptorSet();
+            }
+
+            m_claimedPools.insert(pool);
+        }
+
         auto&& [result, set] = pool->Allocate();
 
         switch (result) {
             case VK_SUCCESS:
+                info.OnAllocate();
                 /// all good, return
                 return set;
             case VK_ERROR_FRAGMENTED_POOL:
             case VK_ERROR_OUT_OF_POOL_MEMORY:
                 if (!reallocate) {
                     /// reallocate pool
-                    return AllocateDescriptorSet(layout, requestTypes, true);
+                    return AllocateDescriptorSet(key, requestTypes, true);
                 }
                 EVK_FALLTHROUGH;
             default:
@@ -43,11 +173,27 @@ namespace EvoVulkan::Core {
     }
 
     void EvoVulkan::Core::DescriptorManager::Reset() {
-        for (auto&& pool : m_pools) {
-            delete pool;
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        ResetUnlocked();
+    }
+
+    void DescriptorManager::ResetUnlocked() {
+        m_threadCaches.clear();
+        m_claimedPools.clear();
+
+        for (auto&& [key, bucket] : m_buckets) {
+            for (auto&& pool : bucket.m_pools) {
+                DestroyDescriptorPool(pool);
+            }
         }
 
-        m_pools.clear();
+        m_buckets.clear();
+
+        for (auto&& [layout, info] : m_layouts) {
+            info.m_liveSets = 0;
+            info.m_pools    = 0;
+            info.m_capacity = 0;
+        }
     }
 
     bool EvoVulkan::Core::DescriptorManager::FreeDescriptorSet(Types::DescriptorSet* descriptorSet) {
@@ -64,36 +210,143 @@ namespace EvoVulkan::Core {
             return false;
         }
 
-        if (pool->Free(*descriptorSet) != VK_SUCCESS) {
-            VK_ERROR("DescriptorManager::FreeDescriptorSet() : failed to free descriptor set!");
+        if (!pool->IsFreeable()) {
+            VK_ERROR("DescriptorManager::FreeDescriptorSet() : descriptor set belongs to a frame allocator, it will be released on frame reset!");
+            return false;
+        }
+
+        const DescriptorPoolKey key = { pool->GetLayout(), pool->GetTypeMask() };
+        const uint64_t poolId = pool->GetId();
+        bool wasFull = false;
+        bool isEmpty = false;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+            wasFull = pool->IsOutOfMemory();
+
+            if (pool->Free(*descriptorSet) != VK_SUCCESS) {
+                VK_ERROR("DescriptorManager::FreeDescriptorSet() : failed to free descriptor set!");
+            }
+
+            if (auto&& layoutIt = m_layouts.find(pool->GetLayout()); layoutIt != m_layouts.end()) {
+                layoutIt->second.OnFree();
+            }
+
+            isEmpty = pool->GetUsageCount() == 0;
         }
 
         descriptorSet->Reset();
 
-        if (pool->GetUsageCount() == 0) {
-            delete pool;
-            m_pools.erase(pool);
-            VK_LOG("DescriptorManager::FreeDescriptorSet() : free descriptor pool...");
+        /// корзины трогаем только если пул опустел или в нем снова появилось место
+        if (wasFull || isEmpty) {
+            std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+            /// между блокировками пул мог опустеть и уже быть уничтожен другим потоком,
+            /// а его адрес - достаться новому пулу, поэтому ищем по идентификатору
+            auto&& bucketIt = m_buckets.find(key);
+            if (bucketIt == m_buckets.end()) {
+                return true;
+            }
+
+            auto&& pools = bucketIt->second.m_pools;
+            auto&& poolIt = std::find_if(pools.begin(), pools.end(), [poolId](Types::DescriptorPool* bucketPool) {
+                return bucketPool->GetId() == poolId;
+            });
+
+            if (poolIt == pools.end()) {
+                return true;
+            }
+
+            /// закрепленный пул остается у своего потока
+            if (m_claimedPools.count(pool) == 0) {
+                ReturnDescriptorPool(pool);
+            }
         }
 
         return true;
     }
 
+    void DescriptorManager::ReleaseThreadCache() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto&& cacheIt = m_threadCaches.find(std::this_thread::get_id());
+        if (cacheIt == m_threadCaches.end()) {
+            return;
+        }
+
+        for (auto&& [key, pool] : cacheIt->second) {
+            if (pool) {
+                m_claimedPools.erase(pool);
+                ReturnDescriptorPool(pool);
+            }
+        }
+
+        m_threadCaches.erase(cacheIt);
+    }
+
+    void DescriptorManager::ReturnDescriptorPool(Types::DescriptorPool* pool) {
+        auto&& bucketIt = m_buckets.find(DescriptorPoolKey { pool->GetLayout(), pool->GetTypeMask() });
+        if (bucketIt == m_buckets.end()) {
+            VK_ERROR("DescriptorManager::ReturnDescriptorPool() : pool bucket not found! Something went wrong!");
+            return;
+        }
+
+        auto&& bucket = bucketIt->second;
+        auto&& freeIt = std::find(bucket.m_freePools.begin(), bucket.m_freePools.end(), pool);
+
+        if (pool->GetUsageCount() == 0) {
+            /// пулов в одной корзине немного, линейное удаление тут допустимо
+            bucket.m_pools.erase(std::remove(bucket.m_pools.begin(), bucket.m_pools.end(), pool), bucket.m_pools.end());
+            if (freeIt != bucket.m_freePools.end()) {
+                bucket.m_freePools.erase(freeIt);
+            }
+
+            DestroyDescriptorPool(pool);
+
+            if (bucket.m_pools.empty()) {
+                m_buckets.erase(bucketIt);
+            }
+
+            VK_LOG("DescriptorManager::ReturnDescriptorPool() : free descriptor pool...");
+        }
+        else if (!pool->IsOutOfMemory() && freeIt == bucket.m_freePools.end()) {
+            /// в пуле снова есть место, ставим его в начало, чтобы сначала дозаполнять остальные
+            bucket.m_freePools.insert(bucket.m_freePools.begin(), pool);
+        }
+    }
+
     void DescriptorManager::Free() {
         VK_LOG("DescriptorManager::Free() : free descriptor manager pointer...");
 
-        if (!m_pools.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(g_descriptorManagersMutex);
+            g_descriptorManagers.erase(this);
+        }
+
+        /// кэш возвращает свои сеты через менеджер, поэтому освобождается первым
+        EVSafeFreeObject(m_cache);
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        if (!m_buckets.empty()) {
             std::string str;
             uint32_t index = 0;
-            for (const auto& pool : m_pools) {
-                str += "\n\t[" + std::to_string(index) + "] = " + std::to_string(pool->GetUsageCount()) + " descriptor sets";
-                ++index;
+            for (const auto& [key, bucket] : m_buckets) {
+                for (const auto& pool : bucket.m_pools) {
+                    str += "\n\t[" + std::to_string(index) + "] = " + std::to_string(pool->GetUsageCount()) + " descriptor sets";
+                    ++index;
+                }
             }
 
             VK_WARN("DescriptorManager::Free() : not all descriptor pools have been freed!" + str);
         }
 
-        Reset();
+        ResetUnlocked();
+
+        lock.unlock();
+
+        EVSafeFreeObject(m_bindlessTable);
 
         delete this;
     }
@@ -101,26 +354,150 @@ namespace EvoVulkan::Core {
     DescriptorManager *DescriptorManager::Create(const EvoVulkan::Types::Device *device) {
         auto&& manager = new DescriptorManager();
         manager->m_device = device;
+        manager->m_cache  = DescriptorCache::Create(*device, manager);
+
+        {
+            std::lock_guard<std::mutex> lock(g_descriptorManagersMutex);
+            g_descriptorManagers.insert(manager);
+        }
+
+        if (device->GetFeatures().m_descriptorIndexing) {
+            manager->m_bindlessTable = BindlessTextureTable::Create(device, EVK_BINDLESS_TEXTURES_COUNT);
+            if (!manager->m_bindlessTable) {
+                VK_WARN("DescriptorManager::Create() : failed to create bindless texture table!");
+            }
+        }
+
         return manager;
     }
 
-    Types::DescriptorPool *DescriptorManager::AllocateDescriptorPool(VkDescriptorSetLayout layout, const RequestTypes &requestTypes) {
-        auto&& pool = Types::DescriptorPool::Create(*m_device, 1000, layout, requestTypes);
+    Types::DescriptorPool *DescriptorManager::AllocateDescriptorPool(PoolBucket& bucket, VkDescriptorSetLayout layout, LayoutInfo& info, const RequestTypes &requestTypes) {
+        uint32_t maxSets = bucket.m_nextPoolSets;
+        if (maxSets == 0) {
+            /// корзина новая: сразу берем половину пика, который этот лейаут уже набирал раньше
+            maxSets = MinPoolSets;
+            while (maxSets < info.m_peakSets / 2 && maxSets < MaxPoolSets) {
+                maxSets *= 2;
+            }
+        }
+
+        bucket.m_nextPoolSets = EVK_MIN(maxSets * 2, MaxPoolSets);
+
+        std::vector<VkDescriptorPoolSize> sizes;
+        sizes.reserve(info.m_setSizes.size());
+        for (auto&& [type, count] : info.m_setSizes) {
+            sizes.push_back({ type, count * maxSets });
+        }
+
+        auto&& pool = Types::DescriptorPool::Create(*m_device, maxSets, layout, requestTypes, sizes, info.m_inlineBindings * maxSets);
 
+        /// новый пул сразу закрепляется за потоком, в список свободных он попадет при возврате
         if (pool) {
-            m_pools.insert(pool);
+            bucket.m_pools.emplace_back(pool);
+
+            ++info.m_pools;
+            info.m_capacity += maxSets;
         }
 
         return pool;
     }
 
-    Types::DescriptorPool *DescriptorManager::FindDescriptorPool(VkDescriptorSetLayout layout, const RequestTypes &requestTypes) {
-        for (auto&& pool : m_pools) {
-            if (!pool->IsOutOfMemory() && layout == pool->GetLayout() && pool->Equal(requestTypes)) {
-                return pool;
+    void DescriptorManager::DestroyDescriptorPool(Types::DescriptorPool* pool) {
+        if (auto&& layoutIt = m_layouts.find(pool->GetLayout()); layoutIt != m_layouts.end()) {
+            auto&& info = layoutIt->second;
+            info.m_pools    -= EVK_MIN(info.m_pools, 1u);
+            info.m_capacity -= EVK_MIN(info.m_capacity, pool->GetMaxSets());
+        }
+
+        delete pool;
+    }
+
+    bool DescriptorManager::RegisterLayout(VkDescriptorSetLayout layout, const std::vector<VkDescriptorSetLayoutBinding>& bindings) {
+        if (layout == VK_NULL_HANDLE || bindings.empty()) {
+            VK_ERROR("DescriptorManager::RegisterLayout() : invalid layout or bindings!");
+            return false;
+        }
+
+        std::map<VkDescriptorType, uint32_t> counts;
+        uint32_t inlineBindings = 0;
+
+        for (auto&& binding : bindings) {
+            counts[binding.descriptorType] += binding.descriptorCount;
+
+            if (binding.descriptorType == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
+                ++inlineBindings;
             }
         }
 
-        return nullptr;
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto&& info = m_layouts[layout];
+
+        info.m_inlineBindings = inlineBindings;
+        info.m_setSizes.clear();
+        for (auto&& [type, count] : counts) {
+            info.m_setSizes.push_back({ type, count });
+        }
+
+        return true;
+    }
+
+    void DescriptorManager::UnregisterLayout(VkDescriptorSetLayout layout) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+        auto&& layoutIt = m_layouts.find(layout);
+        if (layoutIt == m_layouts.end()) {
+            return;
+        }
+
+        /// пока живы сеты, их пулы ссылаются на лейаут, статистику оставляем
+        if (layoutIt->second.m_liveSets > 0) {
+            VK_WARN("DescriptorManager::UnregisterLayout() : layout still has " +
+                    std::to_string(layoutIt->second.m_liveSets) + " live descriptor sets!");
+            return;
+        }
+
+        m_layouts.erase(layoutIt);
+    }
+
+    DescriptorLayoutStats DescriptorManager::GetLayoutStats(VkDescriptorSetLayout layout) const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        if (auto&& layoutIt = m_layouts.find(layout); layoutIt != m_layouts.end()) {
+            return layoutIt->second.GetStats();
+        }
+
+        return DescriptorLayoutStats();
+    }
+
+    void DescriptorManager::PrintStats() const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        std::string str;
+
+        for (auto&& [layout, info] : m_layouts) {
+            auto&& stats = info.GetStats();
+
+            str += "\n\t" + std::to_string(reinterpret_cast<uintptr_t>(layout)) +
+                   ": sets = " + std::to_string(stats.m_liveSets) +
+                   " (peak " + std::to_string(stats.m_peakSets) + ")" +
+                   ", pools = " + std::to_string(stats.m_pools) +
+                   ", capacity = " + std::to_string(stats.m_capacity) +
+                   ", utilization = " + std::to_string(static_cast<uint32_t>(stats.GetUtilization() * 100.f)) + "%";
+        }
+
+        VK_LOG("DescriptorManager::PrintStats() : descriptor layouts statistics:" + str);
+    }
+
+    Types::DescriptorPool *DescriptorManager::FindDescriptorPool(PoolBucket& bucket) {
+        if (bucket.m_freePools.empty()) {
+            return nullptr;
+        }
+
+        /// пул снимается со списка свободных и закрепляется за вызывающим потоком
+        auto&& pool = bucket.m_freePools.back();
+        bucket.m_freePools.pop_back();
+
+        return pool;
     }
 }
\ No newline at end of file
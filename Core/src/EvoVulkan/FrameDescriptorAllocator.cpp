@@ -0,0 +1,121 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/FrameDescriptorAllocator.h>
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Types/DescriptorPool.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Core {
+    FrameDescriptorAllocator* FrameDescriptorAllocator::Create(const Types::Device* device, uint32_t framesCount, uint32_t setsPerPool) {
+        if (!device || framesCount == 0 || setsPerPool == 0) {
+            VK_ERROR("FrameDescriptorAllocator::Create() : invalid arguments!");
+            return nullptr;
+        }
+
+        auto&& allocator = new FrameDescriptorAllocator();
+
+        allocator->m_device      = device;
+        allocator->m_setsPerPool = setsPerPool;
+        allocator->m_frames.resize(framesCount, Frame { { }, 0 });
+
+        return allocator;
+    }
+
+    bool FrameDescriptorAllocator::BeginFrame(uint32_t frameIndex) {
+        if (frameIndex >= m_frames.size()) {
+            VK_ERROR("FrameDescriptorAllocator::BeginFrame() : frame index out of range! Index: " + std::to_string(frameIndex));
+            return false;
+        }
+
+        m_frameIndex = frameIndex;
+
+        auto&& frame = m_frames[m_frameIndex];
+
+        for (auto&& pool : frame.m_pools) {
+            if (pool->GetUsageCount() == 0)
+                continue;
+
+            VkResult result = pool->Reset();
+            if (result != VK_SUCCESS) {
+                VK_ERROR("FrameDescriptorAllocator::BeginFrame() : failed to reset descriptor pool!"
+                         "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                         "\n\tDescription: " + Tools::Convert::result_to_description(result));
+                return false;
+            }
+        }
+
+        frame.m_current = 0;
+
+        return true;
+    }
+
+    Types::DescriptorSet FrameDescriptorAllocator::Allocate(VkDescriptorSetLayout layout) {
+        auto&& frame = m_frames[m_frameIndex];
+
+        /// двух попыток достаточно: если свежий пул тоже не смог, значит лейаут в него не помещается
+        for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+            while (frame.m_current < frame.m_pools.size() && frame.m_pools[frame.m_current]->IsOutOfMemory()) {
+                ++frame.m_current;
+            }
+
+            if (frame.m_current == frame.m_pools.size()) {
+                auto&& pool = CreatePool();
+                if (!pool) {
+                    VK_ERROR("FrameDescriptorAllocator::Allocate() : failed to create descriptor pool!");
+                    return Types::DescriptorSet();
+                }
+                frame.m_pools.emplace_back(pool);
+            }
+
+            auto&& [result, set] = frame.m_pools[frame.m_current]->Allocate(layout);
+
+            switch (result) {
+                case VK_SUCCESS:
+                    return set;
+                case VK_ERROR_FRAGMENTED_POOL:
+                case VK_ERROR_OUT_OF_POOL_MEMORY:
+                    /// пул помечен как заполненный, переходим к следующему
+                    continue;
+                default:
+                    VK_ERROR("FrameDescriptorAllocator::Allocate() : failed to allocate vulkan descriptor set!"
+                             "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                             "\n\tDescription: " + Tools::Convert::result_to_description(result));
+                    return Types::DescriptorSet();
+            }
+        }
+
+        VK_ERROR("FrameDescriptorAllocator::Allocate() : descriptor set layout doesn't fit into a frame pool!");
+
+        return Types::DescriptorSet();
+    }
+
+    Types::DescriptorPool* FrameDescriptorAllocator::CreatePool() const {
+        Types::PoolSizes poolSizes;
+
+        std::vector<VkDescriptorPoolSize> sizes;
+        sizes.reserve(poolSizes.sizes.size());
+
+        for (auto&& [type, multiplier] : poolSizes.sizes) {
+            sizes.push_back({ type, static_cast<uint32_t>(multiplier * m_setsPerPool) });
+        }
+
+        /// без флага освобождения драйвер выделяет сеты линейно и не фрагментирует пул
+        return Types::DescriptorPool::Create(*m_device, m_setsPerPool, sizes, 0);
+    }
+
+    void FrameDescriptorAllocator::Destroy() {
+        for (auto&& frame : m_frames) {
+            for (auto&& pool : frame.m_pools) {
+                delete pool;
+            }
+            frame.m_pools.clear();
+            frame.m_current = 0;
+        }
+    }
+
+    void FrameDescriptorAllocator::Free() {
+        delete this;
+    }
+}
@@ -0,0 +1,229 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Memory/AliasingPool.h>
+#include <EvoVulkan/Types/Image.h>
+#include <EvoVulkan/Types/Device.h>
+
+namespace EvoVulkan::Memory {
+    AliasingPool* AliasingPool::Create(Types::Device* device, Allocator* allocator, VkDeviceSize blockSize) {
+        if (!device || !allocator || blockSize == 0) {
+            VK_ERROR("AliasingPool::Create() : invalid arguments!");
+            return nullptr;
+        }
+
+        auto&& pool = new AliasingPool();
+
+        pool->m_device    = device;
+        pool->m_allocator = allocator;
+        pool->m_blockSize = blockSize;
+
+        return pool;
+    }
+
+    void AliasingPool::InsertAliasingBarrier(VkCommandBuffer cmd) {
+        /// прежний владелец памяти мог еще писать в нее как вложение или читать в шейдере
+        VkMemoryBarrier barrier = {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT  | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+
+        vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    VkDeviceSize AliasingPool::FindOffset(const Block& block, const VkMemoryRequirements& requirements, const AliasingLifetime& lifetime) {
+        if (!(requirements.memoryTypeBits & (1u << block.m_memoryType)) || requirements.size > block.m_size) {
+            return UINT64_MAX;
+        }
+
+        /// изображения, которые живут одновременно с новым, занимают свои адреса, остальные не мешают
+        std::vector<const Placement*> alive;
+        for (auto&& placement : block.m_placements) {
+            if (placement.m_lifetime.Intersects(lifetime)) {
+                alive.emplace_back(&placement);
+            }
+        }
+
+        std::sort(alive.begin(), alive.end(), [](const Placement* left, const Placement* right) {
+            return left->m_offset < right->m_offset;
+        });
+
+        VkDeviceSize offset = 0;
+
+        for (auto&& placement : alive) {
+            offset = (offset + requirements.alignment - 1) / requirements.alignment * requirements.alignment;
+
+            if (offset + requirements.size <= placement->m_offset) {
+                return offset;
+            }
+
+            offset = EVK_MAX(offset, placement->m_offset + placement->m_size);
+        }
+
+        offset = (offset + requirements.alignment - 1) / requirements.alignment * requirements.alignment;
+
+        return offset + requirements.size <= block.m_size ? offset : UINT64_MAX;
+    }
+
+    Types::Image AliasingPool::CreateImage(const VkImageCreateInfo& info, const AliasingLifetime& lifetime) {
+        if (lifetime.m_first > lifetime.m_last) {
+            VK_ERROR("AliasingPool::CreateImage() : invalid lifetime!");
+            return Types::Image();
+        }
+
+        /// в блоках лежат только OPTIMAL изображения, поэтому bufferImageGranularity не учитывается
+        if (info.tiling != VK_IMAGE_TILING_OPTIMAL) {
+            VK_ERROR("AliasingPool::CreateImage() : only optimal tiling is supported!");
+            return Types::Image();
+        }
+
+        VkImage vkImage = VK_NULL_HANDLE;
+        if (auto result = vkCreateImage(*m_device, &info, Memory::GetAllocationCallbacks(), &vkImage); result != VK_SUCCESS) {
+            VK_ERROR("AliasingPool::CreateImage() : failed to create image!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            return Types::Image();
+        }
+
+        VkMemoryRequirements requirements = {};
+        vkGetImageMemoryRequirements(*m_device, vkImage, &requirements);
+
+        Block* target = nullptr;
+        VkDeviceSize offset = UINT64_MAX;
+
+        for (auto&& block : m_blocks) {
+            if ((offset = FindOffset(block, requirements, lifetime)) != UINT64_MAX) {
+                target = &block;
+                break;
+            }
+        }
+
+        if (!target) {
+            VkMemoryRequirements blockRequirements = requirements;
+            blockRequirements.size = EVK_MAX(m_blockSize, requirements.size);
+
+            VmaAllocationCreateInfo allocInfo = {};
+            allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+            allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+            Block block;
+            VmaAllocationInfo allocationInfo = {};
+
+            if (auto result = vmaAllocateMemory(*m_allocator, &blockRequirements, &allocInfo, &block.m_allocation, &allocationInfo); result != VK_SUCCESS) {
+                VK_ERROR("AliasingPool::CreateImage() : failed to allocate memory block!"
+                         "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                         "\n\tDescription: " + Tools::Convert::result_to_description(result));
+                vkDestroyImage(*m_device, vkImage, Memory::GetAllocationCallbacks());
+                return Types::Image();
+            }
+
+            block.m_size       = blockRequirements.size;
+            block.m_memoryType = allocationInfo.memoryType;
+
+            VK_LOG("AliasingPool::CreateImage() : allocate new memory block, size: " + std::to_string(block.m_size));
+
+            target = &m_blocks.emplace_back(std::move(block));
+            offset = 0;
+        }
+
+        if (auto result = vmaBindImageMemory2(*m_allocator, target->m_allocation, offset, vkImage, nullptr); result != VK_SUCCESS) {
+            VK_ERROR("AliasingPool::CreateImage() : failed to bind image memory!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            vkDestroyImage(*m_device, vkImage, Memory::GetAllocationCallbacks());
+            return Types::Image();
+        }
+
+        target->m_placements.emplace_back(Placement { vkImage, offset, requirements.size, lifetime });
+
+        Types::Image image;
+
+        image.m_image      = vkImage;
+        image.m_allocation = target->m_allocation;
+        image.m_allocator  = *m_allocator;
+        image.m_aliased    = true;
+
+        return image;
+    }
+
+    void AliasingPool::DestroyImage(Types::Image& image) {
+        if (!image.m_aliased) {
+            VK_ERROR("AliasingPool::DestroyImage() : image isn't aliased!");
+            return;
+        }
+
+        for (auto&& blockIt = m_blocks.begin(); blockIt != m_blocks.end(); ++blockIt) {
+            auto&& placements = blockIt->m_placements;
+
+            auto&& placementIt = std::find_if(placements.begin(), placements.end(), [&image](const Placement& placement) {
+                return placement.m_image == image.m_image;
+            });
+
+            if (placementIt == placements.end()) {
+                continue;
+            }
+
+            vkDestroyImage(*m_device, placementIt->m_image, Memory::GetAllocationCallbacks());
+            placements.erase(placementIt);
+
+            /// пустой блок отдается обратно, при ReCreate размеры вложений обычно меняются
+            if (placements.empty()) {
+                vmaFreeMemory(*m_allocator, blockIt->m_allocation);
+                m_blocks.erase(blockIt);
+            }
+
+            image = Types::Image();
+
+            return;
+        }
+
+        VK_ERROR("AliasingPool::DestroyImage() : image isn't found!");
+    }
+
+    VkDeviceSize AliasingPool::GetMemorySize() const {
+        VkDeviceSize size = 0;
+
+        for (auto&& block : m_blocks) {
+            size += block.m_size;
+        }
+
+        return size;
+    }
+
+    VkDeviceSize AliasingPool::GetRequestedSize() const {
+        VkDeviceSize size = 0;
+
+        for (auto&& block : m_blocks) {
+            for (auto&& placement : block.m_placements) {
+                size += placement.m_size;
+            }
+        }
+
+        return size;
+    }
+
+    void AliasingPool::Destroy() {
+        if (!m_blocks.empty()) {
+            VK_WARN("AliasingPool::Destroy() : not all aliased images have been destroyed!");
+        }
+
+        for (auto&& block : m_blocks) {
+            for (auto&& placement : block.m_placements) {
+                vkDestroyImage(*m_device, placement.m_image, Memory::GetAllocationCallbacks());
+            }
+
+            vmaFreeMemory(*m_allocator, block.m_allocation);
+        }
+
+        m_blocks.clear();
+    }
+
+    void AliasingPool::Free() {
+        delete this;
+    }
+}
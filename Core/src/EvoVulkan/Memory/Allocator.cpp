@@ -9,8 +9,8 @@
 #define VMA_ASSERT(expr) VK_ASSERT(expr)
 #include "vk_mem_alloc.h"
 
-EvoVulkan::Memory::Allocator *EvoVulkan::Memory::Allocator::Create(EvoVulkan::Types::Device *device) {
-    auto allocator = new Allocator(device);
+EvoVulkan::Memory::Allocator *EvoVulkan::Memory::Allocator::Create(EvoVulkan::Types::Device *device, AllocatorThreading threading) {
+    auto allocator = new Allocator(device, threading);
 
     if (!allocator->Init()) {
         VK_ERROR("Allocator::Create() : failed to initialize allocator!");
@@ -26,11 +26,20 @@ bool EvoVulkan::Memory::Allocator::Init() {
 
     auto instance = m_device->GetInstance();
 
-    vmaAllocationCreateInfo.flags = VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT /** disable vma mutex */;
+    vmaAllocationCreateInfo.flags = 0;
+
+    if (m_threading == AllocatorThreading::External)
+        vmaAllocationCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT /** disable vma mutex */;
+
+    /// буфер дескрипторов требует адрес буфера, а значит и флаг у блоков памяти
+    if (m_device->GetFeatures().m_descriptorBuffer)
+        vmaAllocationCreateInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+
     vmaAllocationCreateInfo.physicalDevice = *m_device;
     vmaAllocationCreateInfo.device = *m_device;
     vmaAllocationCreateInfo.preferredLargeHeapBlockSize = 256 * 1024 * 1024;
-    vmaAllocationCreateInfo.pAllocationCallbacks = nullptr;
+    /// VMA передает их и во все свои вызовы Vulkan, поэтому ресурсы VMA уничтожаются с теми же обратными вызовами
+    vmaAllocationCreateInfo.pAllocationCallbacks = GetAllocationCallbacks();
     vmaAllocationCreateInfo.pDeviceMemoryCallbacks = nullptr;
     vmaAllocationCreateInfo.instance = *instance;
     vmaAllocationCreateInfo.pHeapSizeLimit = nullptr;
@@ -46,17 +55,101 @@ bool EvoVulkan::Memory::Allocator::Init() {
         return false;
     }
 
+    DetectDeviceLocalHostVisibleMemory();
+    DetectLazilyAllocatedMemory();
+
+    VK_LOG(std::string("Allocator::Init() : threading model is ") +
+           (m_threading == AllocatorThreading::Internal ? "internally synchronized" : "externally synchronized"));
+
+    /// staging буферы живут один кадр и освобождаются по порядку, для них подходит линейный алгоритм
+    constexpr VkDeviceSize MiB = 1024 * 1024;
+
+    m_pools[static_cast<size_t>(MemoryPool::Attachments)].m_info  = PoolCreateInfo { 64 * MiB,  0, false };
+    m_pools[static_cast<size_t>(MemoryPool::StaticMeshes)].m_info = PoolCreateInfo { 64 * MiB,  0, false };
+    m_pools[static_cast<size_t>(MemoryPool::Textures)].m_info     = PoolCreateInfo { 128 * MiB, 0, false };
+    m_pools[static_cast<size_t>(MemoryPool::Staging)].m_info      = PoolCreateInfo { 32 * MiB,  0, true  };
+    m_pools[static_cast<size_t>(MemoryPool::Uniforms)].m_info     = PoolCreateInfo { 16 * MiB,  0, false };
+
     return true;
 }
 
-EvoVulkan::Types::Image EvoVulkan::Memory::Allocator::AllocImage(const VkImageCreateInfo &info, bool CPUUsage) {
+void EvoVulkan::Memory::Allocator::DetectDeviceLocalHostVisibleMemory() {
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(m_vmaAllocator, &properties);
+
+    /// coherent здесь не требуется: его наличие проверяет AllocHostWritableBuffer через requiredFlags
+    constexpr VkMemoryPropertyFlags deviceHostVisible = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+
+    /// без Resizable BAR видимая с хоста часть видеопамяти ограничена окном в 256 МБ
+    constexpr VkDeviceSize barWindowSize = 256 * 1024 * 1024;
+
+    VkDeviceSize largestHeap = 0;
+
+    for (uint32_t i = 0; i < properties->memoryTypeCount; ++i) {
+        auto&& type = properties->memoryTypes[i];
+
+        if ((type.propertyFlags & deviceHostVisible) != deviceHostVisible)
+            continue;
+
+        /// такие типы памяти для обычных ресурсов не годятся
+        if (type.propertyFlags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT))
+            continue;
+
+        m_deviceHostVisibleTypeBits |= 1u << i;
+        largestHeap = EVK_MAX(largestHeap, properties->memoryHeaps[type.heapIndex].size);
+    }
+
+    m_resizableBAR = largestHeap > barWindowSize;
+
+    if (m_resizableBAR) {
+        VK_LOG("Allocator::DetectDeviceLocalHostVisibleMemory() : resizable BAR detected, heap size: " + std::to_string(largestHeap));
+    }
+    else if (m_deviceHostVisibleTypeBits != 0) {
+        VK_LOG("Allocator::DetectDeviceLocalHostVisibleMemory() : host visible device local memory detected, heap size: " + std::to_string(largestHeap));
+    }
+}
+
+void EvoVulkan::Memory::Allocator::DetectLazilyAllocatedMemory() {
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(m_vmaAllocator, &properties);
+
+    for (uint32_t i = 0; i < properties->memoryTypeCount; ++i) {
+        if (properties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+            m_lazilyAllocatedTypeBits |= 1u << i;
+        }
+    }
+
+    if (m_lazilyAllocatedTypeBits != 0) {
+        VK_LOG("Allocator::DetectLazilyAllocatedMemory() : lazily allocated memory detected, transient attachments will use it");
+    }
+}
+
+EvoVulkan::Types::Image EvoVulkan::Memory::Allocator::AllocImage(const VkImageCreateInfo &info, bool CPUUsage, MemoryPool pool) {
+    /// содержимое transient вложений живет только внутри рендер пасса, на тайловых GPU под них память вообще не выделяется.
+    /// Такая память - отдельный тип, поэтому пулы классов здесь не участвуют
+    if (!CPUUsage && (info.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) && m_lazilyAllocatedTypeBits != 0) {
+        VmaAllocationCreateInfo lazyCreateInfo = {};
+        lazyCreateInfo.usage          = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+        lazyCreateInfo.memoryTypeBits = m_lazilyAllocatedTypeBits;
+
+        Types::Image image = {};
+
+        image.m_allocator = m_vmaAllocator;
+
+        if (vmaCreateImage(m_vmaAllocator, &info, &lazyCreateInfo, &image.m_image, &image.m_allocation, nullptr) == VK_SUCCESS) {
+            return image;
+        }
+
+        VK_WARN("Allocator::AllocImage() : failed to allocate lazily allocated memory, fallback to device local memory...");
+    }
+
     VmaAllocationCreateInfo allocCreateInfo = {};
     allocCreateInfo.flags = 0;
     allocCreateInfo.usage = CPUUsage ? VMA_MEMORY_USAGE_CPU_ONLY : VMA_MEMORY_USAGE_GPU_ONLY;
     allocCreateInfo.requiredFlags = 0;
     allocCreateInfo.preferredFlags = 0;
     allocCreateInfo.memoryTypeBits = 0;
-    allocCreateInfo.pool = nullptr;
+    allocCreateInfo.pool = FindPool(pool, info, allocCreateInfo);
     allocCreateInfo.pUserData = nullptr;
 
     Types::Image image = {};
@@ -67,6 +160,7 @@ EvoVulkan::Types::Image EvoVulkan::Memory::Allocator::AllocImage(const VkImageCr
 
     if (result != VK_SUCCESS) {
         VK_ERROR("Allocator::AllocImage() : failed to create image! "
+                 "\n\tPool: " + std::string(GetPoolName(pool)) +
                  "\n\tReason: " + Tools::Convert::result_to_string(result) +
                  "\n\tDescription: " + Tools::Convert::result_to_description(result)
         );
@@ -79,6 +173,13 @@ EvoVulkan::Types::Image EvoVulkan::Memory::Allocator::AllocImage(const VkImageCr
 EvoVulkan::Memory::Allocator::~Allocator() {
     m_device = nullptr;
 
+    for (auto&& pool : m_pools) {
+        if (pool.m_pool != VK_NULL_HANDLE) {
+            vmaDestroyPool(m_vmaAllocator, pool.m_pool);
+            pool.m_pool = VK_NULL_HANDLE;
+        }
+    }
+
     if (m_vmaAllocator) {
         vmaDestroyAllocator(m_vmaAllocator);
         m_vmaAllocator = VK_NULL_HANDLE;
@@ -96,6 +197,11 @@ void EvoVulkan::Memory::Allocator::FreeImage(Types::Image& image) {
         return;
     }
 
+    if (image.m_aliased) {
+        VK_ERROR("Allocator::FreeImage() : aliased image must be destroyed by its aliasing pool!");
+        return;
+    }
+
     vmaDestroyImage(m_vmaAllocator, image.m_image, image.m_allocation);
 
     image.m_image      = VK_NULL_HANDLE;
@@ -103,10 +209,120 @@ void EvoVulkan::Memory::Allocator::FreeImage(Types::Image& image) {
     image.m_allocator  = VK_NULL_HANDLE;
 }
 
+uint32_t EvoVulkan::Memory::Relocatable::AddRelocationListener(RelocationListener listener) {
+    const uint32_t id = m_nextListenerId++;
+    m_relocationListeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void EvoVulkan::Memory::Relocatable::RemoveRelocationListener(uint32_t id) {
+    auto&& pIt = std::find_if(m_relocationListeners.begin(), m_relocationListeners.end(), [id](auto&& listener) {
+        return listener.first == id;
+    });
+
+    if (pIt == m_relocationListeners.end()) {
+        VK_WARN("Relocatable::RemoveRelocationListener() : listener " + std::to_string(id) + " not found!");
+        return;
+    }
+
+    m_relocationListeners.erase(pIt);
+}
+
+void EvoVulkan::Memory::Relocatable::NotifyRelocation(uint64_t oldHandle, uint64_t newHandle) {
+    for (auto&& [id, listener] : m_relocationListeners) {
+        listener(oldHandle, newHandle);
+    }
+}
+
+void EvoVulkan::Memory::Allocator::SetRelocatable(const Buffer& buffer, Relocatable* owner) {
+    if (buffer.m_allocation == VK_NULL_HANDLE) {
+        VK_ERROR("Allocator::SetRelocatable() : buffer allocation is nullptr!");
+        return;
+    }
+
+    vmaSetAllocationUserData(m_vmaAllocator, buffer.m_allocation, owner);
+}
+
+void EvoVulkan::Memory::Allocator::SetRelocatable(const Types::Image& image, Relocatable* owner) {
+    if (image.m_allocation == VK_NULL_HANDLE) {
+        VK_ERROR("Allocator::SetRelocatable() : image allocation is nullptr!");
+        return;
+    }
+
+    vmaSetAllocationUserData(m_vmaAllocator, image.m_allocation, owner);
+}
+
+VkBuffer EvoVulkan::Memory::Allocator::CreateRelocationBuffer(const VkBufferCreateInfo& info, VmaAllocation dstAllocation) {
+    VkBuffer buffer = VK_NULL_HANDLE;
+
+    if (auto result = vmaCreateAliasingBuffer(m_vmaAllocator, dstAllocation, &info, &buffer); result != VK_SUCCESS) {
+        VK_ERROR("Allocator::CreateRelocationBuffer() : failed to create buffer! "
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result)
+        );
+        return VK_NULL_HANDLE;
+    }
+
+    return buffer;
+}
+
+VkImage EvoVulkan::Memory::Allocator::CreateRelocationImage(const VkImageCreateInfo& info, VmaAllocation dstAllocation) {
+    VkImage image = VK_NULL_HANDLE;
+
+    if (auto result = vmaCreateAliasingImage(m_vmaAllocator, dstAllocation, &info, &image); result != VK_SUCCESS) {
+        VK_ERROR("Allocator::CreateRelocationImage() : failed to create image! "
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result)
+        );
+        return VK_NULL_HANDLE;
+    }
+
+    return image;
+}
+
+void EvoVulkan::Memory::Allocator::DestroyRelocationBuffer(VkBuffer buffer) {
+    if (buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(*m_device, buffer, Memory::GetAllocationCallbacks());
+    }
+}
+
+void EvoVulkan::Memory::Allocator::DestroyRelocationImage(VkImage image) {
+    if (image != VK_NULL_HANDLE) {
+        vkDestroyImage(*m_device, image, Memory::GetAllocationCallbacks());
+    }
+}
+
+void EvoVulkan::Memory::Allocator::ReplaceBuffer(Buffer& buffer, VkBuffer newBuffer) {
+    /// память старого буфера VMA уже освободила сама, поэтому уничтожается только хендл
+    if (buffer.m_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(*m_device, buffer.m_buffer, Memory::GetAllocationCallbacks());
+    }
+
+    buffer.m_buffer = newBuffer;
+
+    /// постоянное отображение переезжает вместе с аллокацией
+    VmaAllocationInfo allocationInfo = {};
+    vmaGetAllocationInfo(m_vmaAllocator, buffer.m_allocation, &allocationInfo);
+    buffer.m_mapped = allocationInfo.pMappedData;
+}
+
+void EvoVulkan::Memory::Allocator::ReplaceImage(Types::Image& image, VkImage newImage) {
+    if (image.m_allocator != m_vmaAllocator) {
+        VK_ERROR("Allocator::ReplaceImage() : allocators is different!");
+        return;
+    }
+
+    if (image.m_image != VK_NULL_HANDLE) {
+        vkDestroyImage(*m_device, image.m_image, Memory::GetAllocationCallbacks());
+    }
+
+    image.m_image = newImage;
+}
+
 EvoVulkan::Memory::RawMemory EvoVulkan::Memory::Allocator::AllocateMemory(VkMemoryAllocateInfo memoryAllocateInfo) {
     auto memory = RawMemory();
     memory.m_size = memoryAllocateInfo.allocationSize;
-    auto result = vkAllocateMemory(*m_device, &memoryAllocateInfo, nullptr, &memory.m_memory);
+    auto result = vkAllocateMemory(*m_device, &memoryAllocateInfo, Memory::GetAllocationCallbacks(), &memory.m_memory);
     if (result != VK_SUCCESS || memory == VK_NULL_HANDLE) {
         VK_ERROR("Allocator::AllocateMemory : failed to allocate memory! Reason: "
                  + Tools::Convert::result_to_description(result));
@@ -124,7 +340,7 @@ bool EvoVulkan::Memory::Allocator::FreeMemory(EvoVulkan::Memory::RawMemory *memo
     }
 
     if (memory->m_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(*m_device, *memory, nullptr);
+        vkFreeMemory(*m_device, *memory, Memory::GetAllocationCallbacks());
         memory->m_memory = VK_NULL_HANDLE;
         memory->m_size   = 0;
         return true;
@@ -152,24 +368,27 @@ uint64_t EvoVulkan::Memory::Allocator::GetGPUMemoryUsage() const {
 }
 
 uint64_t EvoVulkan::Memory::Allocator::GetCPUMemoryUsage() const {
-    return 0;
+    /// память драйвера и VMA на CPU, учитывается по всем областям выделения
+    return HostAllocator::Instance().GetUsage();
 }
 
-EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocBuffer(const VkBufferCreateInfo &info, VmaMemoryUsage usage) {
+EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocBuffer(const VkBufferCreateInfo &info, VmaMemoryUsage usage, VmaAllocationCreateFlags flags, MemoryPool pool) {
     EvoVulkan::Memory::Buffer buffer = {};
 
     VmaAllocationCreateInfo allocInfo;
-    allocInfo.flags = 0;
+    allocInfo.flags = flags;
     allocInfo.usage = usage;
     allocInfo.requiredFlags = 0;
     allocInfo.preferredFlags = 0;
     allocInfo.memoryTypeBits = 0;
     allocInfo.pool = nullptr;
     allocInfo.pUserData = nullptr;
+    allocInfo.priority = 0.f;
 
-    const auto result = vmaCreateBuffer(m_vmaAllocator, &info, &allocInfo, &buffer.m_buffer, &buffer.m_allocation, nullptr);
+    const auto result = CreateBuffer(info, allocInfo, pool, buffer);
     if (result != VK_SUCCESS) {
         VK_ERROR("Allocator::AllocBuffer() : failed to create buffer! "
+                 "\n\tPool: " + std::string(GetPoolName(pool)) +
                  "\n\tReason: " + Tools::Convert::result_to_string(result) +
                  "\n\tDescription: " + Tools::Convert::result_to_description(result)
         );
@@ -179,9 +398,260 @@ EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocBuffer(const VkBuff
     return buffer;
 }
 
+EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocBuffer(const VkBufferCreateInfo &info, VkMemoryPropertyFlags requiredFlags, VmaAllocationCreateFlags flags, MemoryPool pool) {
+    EvoVulkan::Memory::Buffer buffer = {};
+
+    VmaAllocationCreateInfo allocInfo;
+    allocInfo.flags = flags;
+    allocInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+    allocInfo.requiredFlags = requiredFlags;
+    allocInfo.preferredFlags = 0;
+    allocInfo.memoryTypeBits = 0;
+    allocInfo.pool = nullptr;
+    allocInfo.pUserData = nullptr;
+    allocInfo.priority = 0.f;
+
+    const auto result = CreateBuffer(info, allocInfo, pool, buffer);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("Allocator::AllocBuffer() : failed to create buffer! "
+                 "\n\tPool: " + std::string(GetPoolName(pool)) +
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result)
+        );
+        return EvoVulkan::Memory::Buffer();
+    }
+
+    return buffer;
+}
+
+EvoVulkan::Memory::Buffer EvoVulkan::Memory::Allocator::AllocHostWritableBuffer(const VkBufferCreateInfo &info, MemoryPool pool, bool coherent) {
+    EvoVulkan::Memory::Buffer buffer = {};
+
+    const VkMemoryPropertyFlags coherentFlags = coherent ? VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.usage = VMA_MEMORY_USAGE_UNKNOWN;
+    allocInfo.pool = nullptr;
+    allocInfo.pUserData = nullptr;
+    allocInfo.priority = 0.f;
+
+    if (m_deviceHostVisibleTypeBits != 0) {
+        /// WITHIN_BUDGET не дает вытеснить из видеопамяти то, что там действительно должно лежать,
+        /// особенно когда доступно только окно BAR на 256 МБ
+        allocInfo.flags |= VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT;
+        allocInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | coherentFlags;
+        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        allocInfo.memoryTypeBits = m_deviceHostVisibleTypeBits;
+
+        if (CreateBuffer(info, allocInfo, pool, buffer) == VK_SUCCESS) {
+            return buffer;
+        }
+
+        buffer = EvoVulkan::Memory::Buffer();
+    }
+
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | coherentFlags;
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    allocInfo.memoryTypeBits = 0;
+
+    const auto result = CreateBuffer(info, allocInfo, pool, buffer);
+    if (result != VK_SUCCESS) {
+        VK_ERROR("Allocator::AllocHostWritableBuffer() : failed to create buffer! "
+                 "\n\tPool: " + std::string(GetPoolName(pool)) +
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result)
+        );
+        return EvoVulkan::Memory::Buffer();
+    }
+
+    return buffer;
+}
+
+VkResult EvoVulkan::Memory::Allocator::CreateBuffer(const VkBufferCreateInfo &info, VmaAllocationCreateInfo allocInfo, MemoryPool pool, Buffer &buffer) {
+    allocInfo.pool = FindPool(pool, info, allocInfo);
+
+    VmaAllocationInfo allocationInfo = {};
+
+    const auto result = vmaCreateBuffer(m_vmaAllocator, &info, &allocInfo, &buffer.m_buffer, &buffer.m_allocation, &allocationInfo);
+    if (result == VK_SUCCESS) {
+        buffer.m_mapped = allocationInfo.pMappedData;
+    }
+
+    return result;
+}
+
+VmaPool EvoVulkan::Memory::Allocator::FindPool(MemoryPool pool, const VkBufferCreateInfo &info, const VmaAllocationCreateInfo &allocInfo) {
+    if (pool == MemoryPool::Default) {
+        return VK_NULL_HANDLE;
+    }
+
+    uint32_t memoryType = UINT32_MAX;
+    if (vmaFindMemoryTypeIndexForBufferInfo(m_vmaAllocator, &info, &allocInfo, &memoryType) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    return FindPool(pool, memoryType);
+}
+
+VmaPool EvoVulkan::Memory::Allocator::FindPool(MemoryPool pool, const VkImageCreateInfo &info, const VmaAllocationCreateInfo &allocInfo) {
+    if (pool == MemoryPool::Default) {
+        return VK_NULL_HANDLE;
+    }
+
+    uint32_t memoryType = UINT32_MAX;
+    if (vmaFindMemoryTypeIndexForImageInfo(m_vmaAllocator, &info, &allocInfo, &memoryType) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    return FindPool(pool, memoryType);
+}
+
+VmaPool EvoVulkan::Memory::Allocator::FindPool(MemoryPool pool, uint32_t memoryType) {
+    auto lock = LockPools();
+
+    auto&& entry = m_pools[static_cast<size_t>(pool)];
+
+    if (entry.m_pool != VK_NULL_HANDLE) {
+        if (entry.m_memoryType == memoryType) {
+            return entry.m_pool;
+        }
+
+        /// ресурс этого класса, которому нужен другой тип памяти, уходит в общую память, а не ломает пул.
+        /// Такие ресурсы не попадают под бюджет пула и его статистику, поэтому об этом нужно знать
+        const uint32_t typeBit = memoryType < 32 ? (1u << memoryType) : 0;
+        if (!(entry.m_fallbackTypes & typeBit)) {
+            entry.m_fallbackTypes |= typeBit;
+            VK_WARN("Allocator::FindPool() : resource requires another memory type, it is allocated outside of the pool!"
+                    "\n\tPool: " + std::string(GetPoolName(pool)) +
+                    "\n\tPool memory type: " + std::to_string(entry.m_memoryType) +
+                    "\n\tRequired memory type: " + std::to_string(memoryType)
+            );
+        }
+
+        return VK_NULL_HANDLE;
+    }
+
+    VmaPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.memoryTypeIndex = memoryType;
+    poolCreateInfo.blockSize       = entry.m_info.m_blockSize;
+    poolCreateInfo.flags           = entry.m_info.m_linear ? VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT : 0;
+
+    if (entry.m_info.m_budget > 0 && entry.m_info.m_blockSize > 0) {
+        poolCreateInfo.maxBlockCount = static_cast<size_t>((entry.m_info.m_budget + entry.m_info.m_blockSize - 1) / entry.m_info.m_blockSize);
+    }
+
+    if (auto result = vmaCreatePool(m_vmaAllocator, &poolCreateInfo, &entry.m_pool); result != VK_SUCCESS) {
+        VK_ERROR("Allocator::FindPool() : failed to create pool! "
+                 "\n\tPool: " + std::string(GetPoolName(pool)) +
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result)
+        );
+        entry.m_pool = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+
+    vmaSetPoolName(m_vmaAllocator, entry.m_pool, GetPoolName(pool));
+    entry.m_memoryType = memoryType;
+
+    VK_LOG("Allocator::FindPool() : pool \"" + std::string(GetPoolName(pool)) + "\" created in memory type " + std::to_string(memoryType));
+
+    return entry.m_pool;
+}
+
+std::unique_lock<std::mutex> EvoVulkan::Memory::Allocator::LockPools() const {
+    /// в режиме External все вызовы идут из одного потока, таблица пулов не блокируется ни в одном методе
+    std::unique_lock<std::mutex> lock(m_poolsMutex, std::defer_lock);
+    if (m_threading == AllocatorThreading::Internal) {
+        lock.lock();
+    }
+
+    return lock;
+}
+
+bool EvoVulkan::Memory::Allocator::SetPoolCreateInfo(MemoryPool pool, const PoolCreateInfo &info) {
+    if (pool == MemoryPool::Default || pool == MemoryPool::Count) {
+        VK_ERROR("Allocator::SetPoolCreateInfo() : default pool can't be configured!");
+        return false;
+    }
+
+    auto lock = LockPools();
+
+    auto&& entry = m_pools[static_cast<size_t>(pool)];
+
+    if (entry.m_pool != VK_NULL_HANDLE) {
+        VK_ERROR("Allocator::SetPoolCreateInfo() : pool is already created! Pool: " + std::string(GetPoolName(pool)));
+        return false;
+    }
+
+    entry.m_info = info;
+
+    return true;
+}
+
+EvoVulkan::Memory::PoolStatistics EvoVulkan::Memory::Allocator::GetPoolStatistics(MemoryPool pool) const {
+    PoolStatistics statistics = {};
+
+    if (pool == MemoryPool::Count) {
+        return statistics;
+    }
+
+    auto lock = LockPools();
+
+    auto&& entry = m_pools[static_cast<size_t>(pool)];
+    if (entry.m_pool == VK_NULL_HANDLE) {
+        return statistics;
+    }
+
+    VmaStatistics vmaStatistics = {};
+    vmaGetPoolStatistics(m_vmaAllocator, entry.m_pool, &vmaStatistics);
+
+    statistics.m_blockCount      = vmaStatistics.blockCount;
+    statistics.m_allocationCount = vmaStatistics.allocationCount;
+    statistics.m_blockBytes      = vmaStatistics.blockBytes;
+    statistics.m_allocationBytes = vmaStatistics.allocationBytes;
+
+    return statistics;
+}
+
+EvoVulkan::Memory::PoolCreateInfo EvoVulkan::Memory::Allocator::GetPoolCreateInfo(MemoryPool pool) const {
+    if (pool == MemoryPool::Count) {
+        return PoolCreateInfo();
+    }
+
+    auto lock = LockPools();
+
+    return m_pools[static_cast<size_t>(pool)].m_info;
+}
+
+VmaPool EvoVulkan::Memory::Allocator::GetVmaPool(MemoryPool pool) const {
+    if (pool == MemoryPool::Count) {
+        return VK_NULL_HANDLE;
+    }
+
+    auto lock = LockPools();
+
+    return m_pools[static_cast<size_t>(pool)].m_pool;
+}
+
+const char* EvoVulkan::Memory::Allocator::GetPoolName(MemoryPool pool) {
+    switch (pool) {
+        case MemoryPool::Default:      return "Default";
+        case MemoryPool::Attachments:  return "Attachments";
+        case MemoryPool::StaticMeshes: return "StaticMeshes";
+        case MemoryPool::Textures:     return "Textures";
+        case MemoryPool::Staging:      return "Staging";
+        case MemoryPool::Uniforms:     return "Uniforms";
+        default:
+            return "Unknown";
+    }
+}
+
 void EvoVulkan::Memory::Allocator::FreeBuffer(EvoVulkan::Memory::Buffer &info) {
     vmaDestroyBuffer(m_vmaAllocator, info.m_buffer, info.m_allocation);
 
     info.m_buffer = VK_NULL_HANDLE;
     info.m_allocation = VK_NULL_HANDLE;
+    info.m_mapped = nullptr;
 }
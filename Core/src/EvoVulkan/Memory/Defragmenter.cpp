@@ -0,0 +1,234 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Memory/Defragmenter.h>
+#include <EvoVulkan/Types/CmdBuffer.h>
+#include <EvoVulkan/Types/Device.h>
+
+namespace EvoVulkan::Memory {
+    Defragmenter* Defragmenter::Create(Types::Device* device, Allocator* allocator, Types::CmdPool* cmdPool) {
+        if (!device || !allocator || !cmdPool) {
+            VK_ERROR("Defragmenter::Create() : invalid arguments!");
+            return nullptr;
+        }
+
+        auto&& defragmenter = new Defragmenter();
+
+        defragmenter->m_device    = device;
+        defragmenter->m_allocator = allocator;
+        defragmenter->m_cmdPool   = cmdPool;
+
+        return defragmenter;
+    }
+
+    void Defragmenter::SetPassBudget(VkDeviceSize bytes, uint32_t allocations) {
+        m_maxBytes       = bytes;
+        m_maxAllocations = allocations;
+    }
+
+    bool Defragmenter::Begin() {
+        if (IsActive()) {
+            return false;
+        }
+
+        m_pools.clear();
+        m_poolIndex = 0;
+
+        m_pools.emplace_back(VK_NULL_HANDLE);
+
+        for (size_t i = 0; i < static_cast<size_t>(MemoryPool::Count); ++i) {
+            auto&& pool = static_cast<MemoryPool>(i);
+
+            /// VMA не дефрагментирует пулы с линейным алгоритмом
+            if (auto&& vmaPool = m_allocator->GetVmaPool(pool); vmaPool != VK_NULL_HANDLE && !m_allocator->GetPoolCreateInfo(pool).m_linear) {
+                m_pools.emplace_back(vmaPool);
+            }
+        }
+
+        m_idleFrames = 0;
+
+        VK_LOG("Defragmenter::Begin() : begin defragmentation of " + std::to_string(m_pools.size()) + " pools...");
+
+        return true;
+    }
+
+    bool Defragmenter::BeginPool() {
+        while (m_poolIndex < m_pools.size()) {
+            VmaDefragmentationInfo info = {};
+            info.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+            info.pool                  = m_pools[m_poolIndex];
+            info.maxBytesPerPass       = m_maxBytes;
+            info.maxAllocationsPerPass = m_maxAllocations;
+
+            if (auto result = vmaBeginDefragmentation(*m_allocator, &info, &m_context); result != VK_SUCCESS) {
+                VK_ERROR("Defragmenter::BeginPool() : failed to begin defragmentation!"
+                         "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                         "\n\tDescription: " + Tools::Convert::result_to_description(result));
+                m_context = VK_NULL_HANDLE;
+                ++m_poolIndex;
+                continue;
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void Defragmenter::EndPool() {
+        VmaDefragmentationStats stats = {};
+        vmaEndDefragmentation(*m_allocator, m_context, &stats);
+
+        m_context = VK_NULL_HANDLE;
+        ++m_poolIndex;
+
+        m_statistics.m_bytesMoved       += stats.bytesMoved;
+        m_statistics.m_bytesFreed       += stats.bytesFreed;
+        m_statistics.m_allocationsMoved += stats.allocationsMoved;
+        m_statistics.m_blocksFreed      += stats.deviceMemoryBlocksFreed;
+
+        if (m_poolIndex >= m_pools.size()) {
+            m_pools.clear();
+            m_poolIndex = 0;
+
+            VK_LOG("Defragmenter::EndPool() : defragmentation completed! "
+                   "\n\tMoved: " + std::to_string(m_statistics.m_allocationsMoved) + " allocations, " + std::to_string(m_statistics.m_bytesMoved) + " bytes" +
+                   "\n\tFreed: " + std::to_string(m_statistics.m_blocksFreed) + " blocks, " + std::to_string(m_statistics.m_bytesFreed) + " bytes");
+        }
+    }
+
+    bool Defragmenter::Step() {
+        if (!IsActive()) {
+            if (m_autoInterval == 0 || ++m_idleFrames < m_autoInterval || !Begin()) {
+                return false;
+            }
+        }
+
+        if (m_context == VK_NULL_HANDLE && !BeginPool()) {
+            m_pools.clear();
+            m_poolIndex = 0;
+            return false;
+        }
+
+        VmaDefragmentationPassMoveInfo pass = {};
+
+        VkResult result = vmaBeginDefragmentationPass(*m_allocator, m_context, &pass);
+        if (result == VK_SUCCESS) {
+            EndPool();
+            return false;
+        }
+        else if (result != VK_INCOMPLETE) {
+            VK_ERROR("Defragmenter::Step() : failed to begin defragmentation pass!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            EndPool();
+            return false;
+        }
+
+        ++m_statistics.m_passes;
+
+        const auto begin = std::chrono::steady_clock::now();
+
+        std::vector<Relocatable*> relocated;
+        Types::CmdBuffer* copyCmd = nullptr;
+
+        for (uint32_t i = 0; i < pass.moveCount; ++i) {
+            auto&& move = pass.pMoves[i];
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count();
+
+            VmaAllocationInfo allocationInfo = {};
+            vmaGetAllocationInfo(*m_allocator, move.srcAllocation, &allocationInfo);
+
+            /// ресурсы без владельца и все, что не влезло в бюджет времени, остаются на месте
+            auto&& owner = static_cast<Relocatable*>(allocationInfo.pUserData);
+            if (!owner || static_cast<uint64_t>(elapsed) > m_timeBudget) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            if (!copyCmd && !(copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_cmdPool))) {
+                VK_ERROR("Defragmenter::Step() : failed to begin command buffer!");
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            if (!owner->BeginRelocation(*copyCmd, move.dstTmpAllocation)) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            relocated.emplace_back(owner);
+        }
+
+        if (copyCmd) {
+            /// копии буферов становятся видимыми для любых последующих чтений
+            VkMemoryBarrier barrier = {};
+            barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+            vkCmdPipelineBarrier(*copyCmd,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                    0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+            /// End отправляет буфер и ждет простоя очереди
+            if (!copyCmd->End()) {
+                VK_ERROR("Defragmenter::Step() : failed to submit copy commands!");
+
+                for (auto&& owner : relocated) {
+                    owner->CancelRelocation();
+                }
+
+                relocated.clear();
+
+                for (uint32_t i = 0; i < pass.moveCount; ++i) {
+                    pass.pMoves[i].operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                }
+            }
+
+            copyCmd->Destroy();
+            copyCmd->Free();
+        }
+
+        result = vmaEndDefragmentationPass(*m_allocator, m_context, &pass);
+
+        /// после конца прохода аллокации указывают на новое место, старые хендлы уничтожаются уже без своей памяти
+        for (auto&& owner : relocated) {
+            owner->EndRelocation();
+        }
+
+        if (result != VK_INCOMPLETE) {
+            if (result != VK_SUCCESS) {
+                VK_ERROR("Defragmenter::Step() : failed to end defragmentation pass!"
+                         "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                         "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            }
+
+            EndPool();
+        }
+
+        return !relocated.empty();
+    }
+
+    void Defragmenter::Cancel() {
+        if (m_context != VK_NULL_HANDLE) {
+            VmaDefragmentationStats stats = {};
+            vmaEndDefragmentation(*m_allocator, m_context, &stats);
+            m_context = VK_NULL_HANDLE;
+        }
+
+        m_pools.clear();
+        m_poolIndex  = 0;
+        m_idleFrames = 0;
+    }
+
+    void Defragmenter::Destroy() {
+        Cancel();
+    }
+
+    void Defragmenter::Free() {
+        delete this;
+    }
+}
@@ -0,0 +1,263 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Memory/HostAllocator.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Memory {
+    namespace {
+        class MallocHostAllocatorBackend : public HostAllocatorBackend {
+        public:
+            void* Allocate(size_t size, VkSystemAllocationScope) override {
+                return malloc(size);
+            }
+
+            void Free(void* memory, size_t, VkSystemAllocationScope) override {
+                free(memory);
+            }
+
+        };
+
+        MallocHostAllocatorBackend g_mallocBackend;
+
+        /// Singleton::Instance() не потокобезопасен, а обратные вызовы запрашиваются при каждом vkCreate*/vkDestroy*,
+        /// поэтому указатель кешируется один раз под мьютексом и сбрасывается при уничтожении синглтона
+        std::atomic<const VkAllocationCallbacks*> g_allocationCallbacks = nullptr;
+        std::mutex g_allocationCallbacksMutex;
+    }
+
+    const VkAllocationCallbacks* GetAllocationCallbacks() {
+        if (auto&& pCallbacks = g_allocationCallbacks.load(std::memory_order_acquire)) {
+            return pCallbacks;
+        }
+
+        std::lock_guard<std::mutex> lock(g_allocationCallbacksMutex);
+
+        if (auto&& pCallbacks = g_allocationCallbacks.load(std::memory_order_relaxed)) {
+            return pCallbacks;
+        }
+
+        auto&& pCallbacks = HostAllocator::Instance().GetCallbacks();
+        g_allocationCallbacks.store(pCallbacks, std::memory_order_release);
+
+        return pCallbacks;
+    }
+
+    void HostAllocator::OnSingletonDestroy() {
+        std::lock_guard<std::mutex> lock(g_allocationCallbacksMutex);
+        g_allocationCallbacks.store(nullptr, std::memory_order_release);
+    }
+
+    HostAllocator::HostAllocator()
+        : Tools::Singleton<HostAllocator>()
+    {
+        m_callbacks.pUserData             = this;
+        m_callbacks.pfnAllocation         = &HostAllocator::AllocationCallback;
+        m_callbacks.pfnReallocation       = &HostAllocator::ReallocationCallback;
+        m_callbacks.pfnFree               = &HostAllocator::FreeCallback;
+        m_callbacks.pfnInternalAllocation = &HostAllocator::InternalAllocationCallback;
+        m_callbacks.pfnInternalFree       = &HostAllocator::InternalFreeCallback;
+
+        m_backend = &g_mallocBackend;
+    }
+
+    bool HostAllocator::SetBackend(HostAllocatorBackend* backend) {
+        /// память освобождается тем же бэкендом, которым была выделена
+        if (m_liveAllocations != 0) {
+            VK_ERROR("HostAllocator::SetBackend() : there are live allocations! Count: " + std::to_string(m_liveAllocations));
+            return false;
+        }
+
+        m_backend = backend ? backend : &g_mallocBackend;
+
+        return true;
+    }
+
+    bool HostAllocator::Reserve(size_t size) {
+        const uint64_t total = m_totalBytes.fetch_add(size) + size;
+        const uint64_t budget = m_budget;
+
+        if (budget != 0 && total > budget) {
+            m_totalBytes.fetch_sub(size);
+            ++m_failedAllocations;
+            return false;
+        }
+
+        return true;
+    }
+
+    void HostAllocator::Release(size_t size) {
+        m_totalBytes.fetch_sub(size);
+    }
+
+    HostAllocator::Header* HostAllocator::GetHeader(void* memory) {
+        return reinterpret_cast<Header*>(static_cast<uint8_t*>(memory) - sizeof(Header));
+    }
+
+    void* HostAllocator::Allocate(size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        if (size == 0 || static_cast<uint32_t>(scope) >= ScopesCount) {
+            return nullptr;
+        }
+
+        if (!Reserve(size)) {
+            return nullptr;
+        }
+
+        /// заголовок лежит прямо перед выровненным указателем, поэтому выравнивание не меньше, чем у заголовка
+        alignment = EVK_MAX(alignment, alignof(Header));
+
+        const size_t rawSize = size + alignment + sizeof(Header);
+
+        void* raw = m_backend->Allocate(rawSize, scope);
+        if (!raw) {
+            Release(size);
+            ++m_failedAllocations;
+            return nullptr;
+        }
+
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(raw) + sizeof(Header);
+        void* memory = reinterpret_cast<void*>((begin + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+
+        auto&& header = GetHeader(memory);
+        header->m_raw     = raw;
+        header->m_size    = size;
+        header->m_rawSize = rawSize;
+        header->m_scope   = static_cast<uint64_t>(scope);
+
+        auto&& statistics = m_scopes[scope];
+
+        const uint64_t bytes = statistics.m_bytes.fetch_add(size) + size;
+        ++statistics.m_allocations;
+        ++m_liveAllocations;
+
+        uint64_t peak = statistics.m_peakBytes;
+        while (bytes > peak && !statistics.m_peakBytes.compare_exchange_weak(peak, bytes)) { }
+
+        return memory;
+    }
+
+    void* HostAllocator::Reallocate(void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        if (!original) {
+            return Allocate(size, alignment, scope);
+        }
+
+        if (size == 0) {
+            Free(original);
+            return nullptr;
+        }
+
+        /// при неудаче исходная память должна остаться нетронутой
+        void* memory = Allocate(size, alignment, scope);
+        if (!memory) {
+            return nullptr;
+        }
+
+        memcpy(memory, original, EVK_MIN(GetHeader(original)->m_size, size));
+        Free(original);
+
+        return memory;
+    }
+
+    void HostAllocator::Free(void* memory) {
+        if (!memory) {
+            return;
+        }
+
+        auto&& header = GetHeader(memory);
+
+        const size_t size = header->m_size;
+        const auto scope = static_cast<VkSystemAllocationScope>(header->m_scope);
+
+        auto&& statistics = m_scopes[scope];
+        statistics.m_bytes.fetch_sub(size);
+        --statistics.m_allocations;
+        --m_liveAllocations;
+
+        Release(size);
+
+        m_backend->Free(header->m_raw, header->m_rawSize, scope);
+    }
+
+    HostScopeStatistics HostAllocator::GetStatistics(VkSystemAllocationScope scope) const {
+        if (static_cast<uint32_t>(scope) >= ScopesCount) {
+            return HostScopeStatistics();
+        }
+
+        auto&& statistics = m_scopes[scope];
+
+        HostScopeStatistics result;
+
+        result.m_bytes         = statistics.m_bytes;
+        result.m_peakBytes     = statistics.m_peakBytes;
+        result.m_allocations   = statistics.m_allocations;
+        result.m_internalBytes = statistics.m_internalBytes;
+
+        return result;
+    }
+
+    void HostAllocator::LogStatistics() const {
+        std::string message = "HostAllocator::LogStatistics() : driver host memory usage: " + std::to_string(GetUsage());
+
+        for (uint32_t i = 0; i < ScopesCount; ++i) {
+            auto&& statistics = GetStatistics(static_cast<VkSystemAllocationScope>(i));
+
+            message += "\n\t" + std::string(GetScopeName(static_cast<VkSystemAllocationScope>(i))) +
+                       ": " + std::to_string(statistics.m_bytes) +
+                       " bytes in " + std::to_string(statistics.m_allocations) +
+                       " allocations, peak " + std::to_string(statistics.m_peakBytes) +
+                       ", internal " + std::to_string(statistics.m_internalBytes);
+        }
+
+        if (m_failedAllocations != 0) {
+            message += "\n\tFailed allocations: " + std::to_string(m_failedAllocations);
+        }
+
+        VK_LOG(message);
+    }
+
+    const char* HostAllocator::GetScopeName(VkSystemAllocationScope scope) {
+        switch (scope) {
+            case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND:  return "Command";
+            case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:   return "Object";
+            case VK_SYSTEM_ALLOCATION_SCOPE_CACHE:    return "Cache";
+            case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE:   return "Device";
+            case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "Instance";
+            default:
+                return "Unknown";
+        }
+    }
+
+    void* HostAllocator::AllocationCallback(void* userData, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        return static_cast<HostAllocator*>(userData)->Allocate(size, alignment, scope);
+    }
+
+    void* HostAllocator::ReallocationCallback(void* userData, void* original, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+        return static_cast<HostAllocator*>(userData)->Reallocate(original, size, alignment, scope);
+    }
+
+    void HostAllocator::FreeCallback(void* userData, void* memory) {
+        static_cast<HostAllocator*>(userData)->Free(memory);
+    }
+
+    void HostAllocator::InternalAllocationCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        auto&& allocator = static_cast<HostAllocator*>(userData);
+
+        /// внутреннюю память драйвер уже выделил сам, ее можно только учесть, но не отказать
+        if (static_cast<uint32_t>(scope) < ScopesCount) {
+            allocator->m_scopes[scope].m_internalBytes.fetch_add(size);
+        }
+
+        allocator->m_totalBytes.fetch_add(size);
+    }
+
+    void HostAllocator::InternalFreeCallback(void* userData, size_t size, VkInternalAllocationType, VkSystemAllocationScope scope) {
+        auto&& allocator = static_cast<HostAllocator*>(userData);
+
+        if (static_cast<uint32_t>(scope) < ScopesCount) {
+            allocator->m_scopes[scope].m_internalBytes.fetch_sub(size);
+        }
+
+        allocator->m_totalBytes.fetch_sub(size);
+    }
+}
@@ -59,6 +59,7 @@ namespace EvoVulkan::Tools {
 
 #include <EvoVulkan/Tools/VulkanDebug.h>
 #include <EvoVulkan/Complexes/Shader.h>
+#include <EvoVulkan/Memory/HostAllocator.h>
 
 /**
  * глупый компилятор может решить что некоторые из этих функций не нужны и выпилит их,
@@ -71,5 +72,7 @@ namespace EvoVulkan {
         EvoVulkan::Tools::VkDebug::Destroy();
         EvoVulkan::Complexes::GLSLCompiler::Instance();
         EvoVulkan::Complexes::GLSLCompiler::Destroy();
+        EvoVulkan::Memory::HostAllocator::Instance();
+        EvoVulkan::Memory::HostAllocator::Destroy();
     }
 }
\ No newline at end of file
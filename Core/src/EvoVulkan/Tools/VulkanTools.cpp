@@ -26,7 +26,7 @@ namespace EvoVulkan::Tools {
             moduleCreateInfo.codeSize = size;
             moduleCreateInfo.pCode = (uint32_t*)shaderCode;
 
-            auto result = vkCreateShaderModule(device, &moduleCreateInfo, NULL, &shaderModule);
+            auto result = vkCreateShaderModule(device, &moduleCreateInfo, Memory::GetAllocationCallbacks(), &shaderModule);
             if (result != VK_SUCCESS) {
                 VK_ERROR("Tools::LoadShaderModule() : failed to create vulkan shader module! \nPath: " + std::string(fileName));
                 return VK_NULL_HANDLE;
@@ -46,7 +46,7 @@ namespace EvoVulkan::Tools {
         VkPipelineLayoutCreateInfo pPipelineLayoutCreateInfo = Initializers::PipelineLayoutCreateInfo(&descriptorSetLayout, 1);
 
         VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-        auto result = vkCreatePipelineLayout(device, &pPipelineLayoutCreateInfo, nullptr, &pipelineLayout);
+        auto result = vkCreatePipelineLayout(device, &pPipelineLayoutCreateInfo, Memory::GetAllocationCallbacks(), &pipelineLayout);
 
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreatePipelineLayout() : failed to create pipeline layout!");
@@ -56,12 +56,36 @@ namespace EvoVulkan::Tools {
             return pipelineLayout;
     }
 
+    VkPipelineLayout CreatePipelineLayout(
+            const VkDevice& device,
+            const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+            const std::vector<VkPushConstantRange>& pushConstantRanges)
+    {
+        VkPipelineLayoutCreateInfo pPipelineLayoutCreateInfo = Initializers::PipelineLayoutCreateInfo(
+                descriptorSetLayouts.data(), static_cast<uint32_t>(descriptorSetLayouts.size()));
+
+        pPipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+        pPipelineLayoutCreateInfo.pPushConstantRanges    = pushConstantRanges.data();
+
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        auto result = vkCreatePipelineLayout(device, &pPipelineLayoutCreateInfo, Memory::GetAllocationCallbacks(), &pipelineLayout);
+
+        if (result != VK_SUCCESS) {
+            VK_ERROR("Tools::CreatePipelineLayout() : failed to create pipeline layout!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+            return VK_NULL_HANDLE;
+        }
+        else
+            return pipelineLayout;
+    }
+
     VkDescriptorSetLayout CreateDescriptorSetLayout(const VkDevice& device, const std::vector<VkDescriptorSetLayoutBinding>& setLayoutBindings) {
         VkDescriptorSetLayoutCreateInfo descriptorLayout = Initializers::DescriptorSetLayoutCreateInfo(setLayoutBindings);
 
         VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
 
-        auto result = vkCreateDescriptorSetLayout(device, &descriptorLayout, nullptr, &descriptorSetLayout);
+        auto result = vkCreateDescriptorSetLayout(device, &descriptorLayout, Memory::GetAllocationCallbacks(), &descriptorSetLayout);
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreateDescriptorSetLayout() : failed to create descriptor set layout!");
             return VK_NULL_HANDLE;
@@ -108,7 +132,7 @@ namespace EvoVulkan::Tools {
             return;
         }
 
-        vkDestroyPipelineCache(device, *cache, nullptr);
+        vkDestroyPipelineCache(device, *cache, Memory::GetAllocationCallbacks());
         *cache = VK_NULL_HANDLE;
     }
 
@@ -117,7 +141,7 @@ namespace EvoVulkan::Tools {
         pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
         VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-        auto result = vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &pipelineCache);
+        auto result = vkCreatePipelineCache(device, &pipelineCacheCreateInfo, Memory::GetAllocationCallbacks(), &pipelineCache);
 
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreatePipelineCache() : failed to create pipeline cache! Reason:" +
@@ -136,8 +160,8 @@ namespace EvoVulkan::Tools {
             return;
         }
 
-        vkDestroySemaphore(device, sync->m_presentComplete, nullptr);
-        vkDestroySemaphore(device, sync->m_renderComplete, nullptr);
+        vkDestroySemaphore(device, sync->m_presentComplete, Memory::GetAllocationCallbacks());
+        vkDestroySemaphore(device, sync->m_renderComplete, Memory::GetAllocationCallbacks());
 
         sync->m_presentComplete = VK_NULL_HANDLE;
         sync->m_renderComplete  = VK_NULL_HANDLE;
@@ -152,14 +176,14 @@ namespace EvoVulkan::Tools {
         VkSemaphoreCreateInfo semaphoreCreateInfo = Initializers::SemaphoreCreateInfo();
         // Create a semaphore used to synchronize image presentation
         // Ensures that the image is displayed before we start submitting new commands to the queue
-        auto result = vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &sync.m_presentComplete);
+        auto result = vkCreateSemaphore(device, &semaphoreCreateInfo, Memory::GetAllocationCallbacks(), &sync.m_presentComplete);
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreateSynchronization() : failed to create present semaphore!");
             return {};
         }
         // Create a semaphore used to synchronize command submission
         // Ensures that the image is not presented until all commands have been submitted and executed
-        result = vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &sync.m_renderComplete);
+        result = vkCreateSemaphore(device, &semaphoreCreateInfo, Memory::GetAllocationCallbacks(), &sync.m_renderComplete);
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreateSynchronization() : failed to create render semaphore!");
             return {};
@@ -187,13 +211,18 @@ namespace EvoVulkan::Tools {
         };
     }
 
-    VkDescriptorSetLayout CreateDescriptorLayout(VkDevice const &device, const std::vector<VkDescriptorSetLayoutBinding> &setLayoutBindings) {
+    VkDescriptorSetLayout CreateDescriptorLayout(
+            VkDevice const &device,
+            const std::vector<VkDescriptorSetLayoutBinding> &setLayoutBindings,
+            VkDescriptorSetLayoutCreateFlags flags)
+    {
         auto descriptorSetLayoutCreateInfo = Initializers::DescriptorSetLayoutCreateInfo(
                 setLayoutBindings.data(),
                 static_cast<uint32_t>(setLayoutBindings.size()));
+        descriptorSetLayoutCreateInfo.flags = flags;
 
         VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
-        auto result = vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, nullptr, &descriptorSetLayout);
+        auto result = vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, Memory::GetAllocationCallbacks(), &descriptorSetLayout);
         if (result != VK_SUCCESS) {
             VK_ERROR("Tools::CreateDescriptorLayout() : failed to create descriptor set layout!");
             return VK_NULL_HANDLE;
@@ -18,7 +18,7 @@ void EvoVulkan::Types::CmdPool::Destroy() {
     if (!IsReady())
         return;
 
-    vkDestroyCommandPool(*m_device, m_pool, nullptr);
+    vkDestroyCommandPool(*m_device, m_pool, Memory::GetAllocationCallbacks());
     m_device = nullptr;
     m_pool   = VK_NULL_HANDLE;
 }
@@ -44,7 +44,7 @@ EvoVulkan::Types::CmdPool *EvoVulkan::Types::CmdPool::Create(EvoVulkan::Types::D
     cmdPoolInfo.queueFamilyIndex        = device->GetQueues()->GetGraphicsIndex();
     cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
 
-    VkResult vkRes = vkCreateCommandPool(*device, &cmdPoolInfo, nullptr, &cmdPool);
+    VkResult vkRes = vkCreateCommandPool(*device, &cmdPoolInfo, Memory::GetAllocationCallbacks(), &cmdPool);
     if (vkRes != VK_SUCCESS) {
         VK_ERROR("CmdPool::CreateCmd() : failed to create command pool! Reason: "
             + Tools::Convert::result_to_description(vkRes));
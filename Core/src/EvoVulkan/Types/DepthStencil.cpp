@@ -42,11 +42,11 @@ bool EvoVulkan::Types::DepthStencil::ReCreate(uint32_t width, uint32_t height) {
     VK_GRAPH("DepthStencil::ReCreate() : re-create vulkan depth stencil...");
 
     if (m_view != VK_NULL_HANDLE)
-        vkDestroyImageView(*m_device, m_view, nullptr);
+        vkDestroyImageView(*m_device, m_view, Memory::GetAllocationCallbacks());
     if (m_image != VK_NULL_HANDLE)
-        vkDestroyImage(*m_device, m_image, nullptr);
+        vkDestroyImage(*m_device, m_image, Memory::GetAllocationCallbacks());
     if (m_mem != VK_NULL_HANDLE)
-        vkFreeMemory(*m_device, m_mem, nullptr);
+        vkFreeMemory(*m_device, m_mem, Memory::GetAllocationCallbacks());
 
     VkImageCreateInfo imageCI = {};
     imageCI.sType             = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -60,7 +60,7 @@ bool EvoVulkan::Types::DepthStencil::ReCreate(uint32_t width, uint32_t height) {
     imageCI.tiling            = VK_IMAGE_TILING_OPTIMAL;
     imageCI.usage             = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 
-    auto result = vkCreateImage(*m_device, &imageCI, nullptr, &m_image);
+    auto result = vkCreateImage(*m_device, &imageCI, Memory::GetAllocationCallbacks(), &m_image);
     if (result != VK_SUCCESS) {
         VK_ERROR("DepthStencil::ReCreate() : failed to create vulkan image! Reason: "
             + Tools::Convert::result_to_description(result));
@@ -100,7 +100,7 @@ bool EvoVulkan::Types::DepthStencil::ReCreate(uint32_t width, uint32_t height) {
     if (m_swapchain->GetDepthFormat() >= VK_FORMAT_D16_UNORM_S8_UINT)
         imageViewCI.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
 
-    result = vkCreateImageView(*m_device, &imageViewCI, nullptr, &m_view);
+    result = vkCreateImageView(*m_device, &imageViewCI, Memory::GetAllocationCallbacks(), &m_view);
     if (result != VK_SUCCESS) {
         VK_ERROR("DepthStencil::ReCreate() : failed to create image view! Reason: "
                  + Tools::Convert::result_to_description(result));
@@ -125,8 +125,8 @@ void EvoVulkan::Types::DepthStencil::Destroy() {
         return;
     }
 
-    vkDestroyImageView(*m_device, m_view, nullptr);
-    vkDestroyImage(*m_device, m_image, nullptr);
+    vkDestroyImageView(*m_device, m_view, Memory::GetAllocationCallbacks());
+    vkDestroyImage(*m_device, m_image, Memory::GetAllocationCallbacks());
     m_device->FreeMemory(&m_mem);
 
     m_view  = VK_NULL_HANDLE;
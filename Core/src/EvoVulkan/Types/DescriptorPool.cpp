@@ -8,11 +8,16 @@
 namespace EvoVulkan::Types {
     DescriptorPool::~DescriptorPool()  {
         if (m_pool != VK_NULL_HANDLE) {
-            vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+            vkDestroyDescriptorPool(m_device, m_pool, Memory::GetAllocationCallbacks());
             m_pool = VK_NULL_HANDLE;
         }
     }
 
+    uint64_t DescriptorPool::GenerateId() {
+        static std::atomic<uint64_t> nextId = 0;
+        return ++nextId;
+    }
+
     bool DescriptorPool::Contains(const std::set<VkDescriptorType> &types, const VkDescriptorType &type) {
         std::set<VkDescriptorType>::iterator it;
         for (it = types.begin(); it != types.end(); ++it)
@@ -22,19 +27,47 @@ namespace EvoVulkan::Types {
         return false;
     }
 
-    DescriptorPool *DescriptorPool::Create(VkDevice device, uint32_t maxSets, std::vector<VkDescriptorPoolSize> sizes) {
+    uint64_t DescriptorPool::GetTypeMask(const RequestTypes& requestTypes) {
+        uint64_t mask = 0;
+
+        for (auto&& type : requestTypes) {
+            /// базовые типы идут подряд от нуля, расширения раскидываем по старшим битам
+            switch (type) {
+                case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+                    mask |= 1ull << 32;
+                    break;
+                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                    mask |= 1ull << 33;
+                    break;
+                case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV:
+                    mask |= 1ull << 34;
+                    break;
+                default:
+                    if (static_cast<uint32_t>(type) < 32)
+                        mask |= 1ull << static_cast<uint32_t>(type);
+                    else {
+                        VK_WARN("DescriptorPool::GetTypeMask() : unknown descriptor type! Type: " + std::to_string(type));
+                        mask |= 1ull << 63;
+                    }
+                    break;
+            }
+        }
+
+        return mask;
+    }
+
+    DescriptorPool *DescriptorPool::Create(VkDevice device, uint32_t maxSets, std::vector<VkDescriptorPoolSize> sizes, VkDescriptorPoolCreateFlags flags) {
         auto&& pool = new DescriptorPool(maxSets);
 
         pool->m_layout       = VK_NULL_HANDLE;
         pool->m_device       = device;
         pool->m_requestTypes = {};
+        pool->m_flags        = flags;
 
         auto&& descriptorPoolCI = Tools::Initializers::DescriptorPoolCreateInfo(sizes.size(), sizes.data(), maxSets);
+        descriptorPoolCI.flags = flags;
 
-        /// этот флаг позволяет осовбождать сеты дескрипторов по отдельности
-        descriptorPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-
-        VkResult vkRes = vkCreateDescriptorPool(device, &descriptorPoolCI, nullptr, &pool->m_pool);
+        VkResult vkRes = vkCreateDescriptorPool(device, &descriptorPoolCI, Memory::GetAllocationCallbacks(), &pool->m_pool);
         if (vkRes != VK_SUCCESS) {
             VK_ERROR("DescriptorPool::Create() : failed to create vulkan descriptor pool!");
             return VK_NULL_HANDLE;
@@ -43,7 +76,9 @@ namespace EvoVulkan::Types {
         return pool;
     }
 
-    DescriptorPool* DescriptorPool::Create(VkDevice device, uint32_t maxSets, VkDescriptorSetLayout layout, const RequestTypes& requestTypes) {
+    DescriptorPool* DescriptorPool::Create(VkDevice device, uint32_t maxSets, VkDescriptorSetLayout layout, const RequestTypes& requestTypes,
+                                           const std::vector<VkDescriptorPoolSize>& poolSizes, uint32_t inlineBlockBindings)
+    {
         if (requestTypes.empty()) {
             VK_ERROR("DescriptorPool::Create() : request types is empty!");
             return nullptr;
@@ -54,12 +89,16 @@ namespace EvoVulkan::Types {
         pool->m_layout       = layout;
         pool->m_device       = device;
         pool->m_requestTypes = requestTypes;
-
-        std::vector<VkDescriptorPoolSize> sizes = {};
-        sizes.reserve(pool->m_poolSizes.sizes.size());
-        for (auto&& [type, multiplier] : pool->m_poolSizes.sizes) {
-            if (Contains(requestTypes, type)) {
-                sizes.push_back({ type, static_cast<uint32_t>(multiplier * maxSets) });
+        pool->m_typeMask     = GetTypeMask(requestTypes);
+        pool->m_flags        = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+
+        std::vector<VkDescriptorPoolSize> sizes = poolSizes;
+        if (sizes.empty()) {
+            sizes.reserve(pool->m_poolSizes.sizes.size());
+            for (auto&& [type, multiplier] : pool->m_poolSizes.sizes) {
+                if (Contains(requestTypes, type)) {
+                    sizes.push_back({ type, static_cast<uint32_t>(multiplier * maxSets) });
+                }
             }
         }
 
@@ -68,7 +107,14 @@ namespace EvoVulkan::Types {
         /// этот флаг позволяет осовбождать сеты дескрипторов по отдельности
         descriptorPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
-        VkResult vkRes = vkCreateDescriptorPool(device, &descriptorPoolCI, nullptr, &pool->m_pool);
+        VkDescriptorPoolInlineUniformBlockCreateInfoEXT inlineBlockCI = {};
+        if (inlineBlockBindings > 0) {
+            inlineBlockCI.sType                         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_INLINE_UNIFORM_BLOCK_CREATE_INFO_EXT;
+            inlineBlockCI.maxInlineUniformBlockBindings = inlineBlockBindings;
+            descriptorPoolCI.pNext = &inlineBlockCI;
+        }
+
+        VkResult vkRes = vkCreateDescriptorPool(device, &descriptorPoolCI, Memory::GetAllocationCallbacks(), &pool->m_pool);
         if (vkRes != VK_SUCCESS) {
             VK_ERROR("DescriptorPool::Create() : failed to create vulkan descriptor pool!");
             return VK_NULL_HANDLE;
@@ -86,6 +132,13 @@ namespace EvoVulkan::Types {
     }
 
     VkResult DescriptorPool::Free(VkDescriptorSet set) {
+        if (!IsFreeable()) {
+            VK_ERROR("DescriptorPool::Free() : pool was created without free descriptor set flag!");
+            return VK_ERROR_FEATURE_NOT_PRESENT;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
         if (m_used != 0) {
             --m_used;
             m_outOfMemory = false;
@@ -97,7 +150,22 @@ namespace EvoVulkan::Types {
         return vkFreeDescriptorSets(m_device, m_pool, 1, &set);
     }
 
+    VkResult DescriptorPool::Reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_used        = 0;
+        m_outOfMemory = false;
+
+        return vkResetDescriptorPool(m_device, m_pool, 0);
+    }
+
     std::pair<VkResult, DescriptorSet> DescriptorPool::Allocate() {
+        return Allocate(m_layout);
+    }
+
+    std::pair<VkResult, DescriptorSet> DescriptorPool::Allocate(VkDescriptorSetLayout layout) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
         if (m_used >= m_maxSets) {
             m_outOfMemory = true;
             VK_ERROR("DescriptorPool::Allocate() : descriptor pool overflow!");
@@ -106,7 +174,7 @@ namespace EvoVulkan::Types {
 
         VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 
-        auto&& descriptorSetAllocInfo = Tools::Initializers::DescriptorSetAllocateInfo(m_pool, &m_layout, 1);
+        auto&& descriptorSetAllocInfo = Tools::Initializers::DescriptorSetAllocateInfo(m_pool, &layout, 1);
         auto&& result = vkAllocateDescriptorSets(m_device, &descriptorSetAllocInfo, &descriptorSet);
 
         switch (result) {
@@ -123,7 +191,7 @@ namespace EvoVulkan::Types {
 
         return std::make_pair(
                 result,
-                DescriptorSet(descriptorSet, m_layout, this)
+                DescriptorSet(descriptorSet, layout, this)
         );
     }
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 //
 
 #include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Types/SamplerCache.h>
+#include <EvoVulkan/Types/LayoutCache.h>
 
 #include <EvoVulkan/Tools/VulkanDebug.h>
 #include <EvoVulkan/Tools/DeviceTools.h>
@@ -30,6 +32,7 @@ EvoVulkan::Types::Device *EvoVulkan::Types::Device::Create(const EvoDeviceCreate
     device->m_logicalDevice       = info.logicalDevice;
     device->m_familyQueues        = info.familyQueues;
     device->m_enableSampleShading = info.enableSampleShading;
+    device->m_features            = info.features;
 
     /// Gather physical device memory properties
     vkGetPhysicalDeviceMemoryProperties(info.physicalDevice, &device->m_memoryProperties);
@@ -44,10 +47,109 @@ EvoVulkan::Types::Device *EvoVulkan::Types::Device::Create(const EvoDeviceCreate
     vkGetPhysicalDeviceProperties(device->m_physicalDevice, &deviceProperties);
     {
         device->m_maxSamplerAnisotropy = deviceProperties.limits.maxSamplerAnisotropy;
+        device->m_minUniformBufferOffsetAlignment = deviceProperties.limits.minUniformBufferOffsetAlignment;
+        device->m_nonCoherentAtomSize = deviceProperties.limits.nonCoherentAtomSize;
+    }
+
+    if (device->m_features.m_descriptorIndexing) {
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties = {};
+        indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 deviceProperties2 = {};
+        deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties2.pNext = &indexingProperties;
+
+        vkGetPhysicalDeviceProperties2(device->m_physicalDevice, &deviceProperties2);
+
+        /// комбинированный семплер учитывается и как семплер, и как изображение
+        device->m_maxBindlessTextures = EVK_MIN(
+                EVK_MIN(indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers),
+                EVK_MIN(indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers));
+    }
+
+    if (device->m_features.m_pushDescriptors) {
+        VkPhysicalDevicePushDescriptorPropertiesKHR pushDescriptorProperties = {};
+        pushDescriptorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+
+        VkPhysicalDeviceProperties2 deviceProperties2 = {};
+        deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties2.pNext = &pushDescriptorProperties;
+
+        vkGetPhysicalDeviceProperties2(device->m_physicalDevice, &deviceProperties2);
+
+        device->m_maxPushDescriptors = pushDescriptorProperties.maxPushDescriptors;
+
+        device->m_cmdPushDescriptorSet = reinterpret_cast<PFN_vkCmdPushDescriptorSetKHR>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkCmdPushDescriptorSetKHR"));
+        device->m_cmdPushDescriptorSetWithTemplate = reinterpret_cast<PFN_vkCmdPushDescriptorSetWithTemplateKHR>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkCmdPushDescriptorSetWithTemplateKHR"));
+
+        /// шейдеры пушат дескрипторы через шаблон обновления, поэтому нужны обе функции
+        if (!device->m_cmdPushDescriptorSet || !device->m_cmdPushDescriptorSetWithTemplate) {
+            VK_WARN("Device::Create() : failed to load push descriptor functions, push descriptors are disabled!");
+            device->m_features.m_pushDescriptors = false;
+        }
+    }
+
+    if (device->m_features.m_inlineUniformBlock) {
+        VkPhysicalDeviceInlineUniformBlockPropertiesEXT inlineBlockProperties = {};
+        inlineBlockProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INLINE_UNIFORM_BLOCK_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2 deviceProperties2 = {};
+        deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties2.pNext = &inlineBlockProperties;
+
+        vkGetPhysicalDeviceProperties2(device->m_physicalDevice, &deviceProperties2);
+
+        device->m_maxInlineUniformBlockSize = inlineBlockProperties.maxInlineUniformBlockSize;
+    }
+
+    if (device->m_features.m_descriptorBuffer) {
+        device->m_descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2 deviceProperties2 = {};
+        deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties2.pNext = &device->m_descriptorBufferProperties;
+
+        vkGetPhysicalDeviceProperties2(device->m_physicalDevice, &deviceProperties2);
+
+        device->m_descriptorBufferProperties.pNext = nullptr;
+
+        auto&& functions = device->m_descriptorBufferFunctions;
+
+        functions.m_getLayoutSize = reinterpret_cast<PFN_vkGetDescriptorSetLayoutSizeEXT>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkGetDescriptorSetLayoutSizeEXT"));
+        functions.m_getBindingOffset = reinterpret_cast<PFN_vkGetDescriptorSetLayoutBindingOffsetEXT>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkGetDescriptorSetLayoutBindingOffsetEXT"));
+        functions.m_getDescriptor = reinterpret_cast<PFN_vkGetDescriptorEXT>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkGetDescriptorEXT"));
+        functions.m_cmdBindBuffers = reinterpret_cast<PFN_vkCmdBindDescriptorBuffersEXT>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkCmdBindDescriptorBuffersEXT"));
+        functions.m_cmdSetBufferOffsets = reinterpret_cast<PFN_vkCmdSetDescriptorBufferOffsetsEXT>(
+                vkGetDeviceProcAddr(device->m_logicalDevice, "vkCmdSetDescriptorBufferOffsetsEXT"));
+
+        if (!functions.Valid()) {
+            VK_WARN("Device::Create() : failed to load descriptor buffer functions, descriptor buffer is disabled!");
+            device->m_features.m_descriptorBuffer = false;
+        }
     }
 
     device->m_deviceName = Tools::GetDeviceName(info.physicalDevice);
 
+    /// начиная с этого момента устройство владеет логическим устройством и очередями,
+    /// поэтому при ошибке их нужно освободить через Destroy
+    if (!(device->m_samplerCache = SamplerCache::Create(info.logicalDevice))) {
+        VK_ERROR("Device::Create() : failed to create sampler cache!");
+        EVSafeFreeObject(device);
+        return nullptr;
+    }
+
+    if (!(device->m_layoutCache = LayoutCache::Create(info.logicalDevice))) {
+        VK_ERROR("Device::Create() : failed to create layout cache!");
+        EVSafeFreeObject(device);
+        return nullptr;
+    }
+
     /// device->m_maxCountMSAASamples = calculate...
     if (info.multisampling) {
         if (info.sampleCount <= 0)
@@ -55,16 +157,19 @@ EvoVulkan::Types::Device *EvoVulkan::Types::Device::Create(const EvoDeviceCreate
         else {
             if (info.sampleCount == 1) {
                 VK_ERROR("Device::Create() : incorrect sample count!");
+                EVSafeFreeObject(device);
                 return nullptr;
             }
 
             if (info.sampleCount > Tools::Convert::SampleCountToInt(Tools::GetMaxUsableSampleCount(device->m_physicalDevice))) {
                 VK_ERROR("Device::Create() : incorrect sample count!");
+                EVSafeFreeObject(device);
                 return nullptr;
             } else {
                 device->m_maxCountMSAASamples = Tools::Convert::IntToSampleCount(info.sampleCount);
                 if (device->m_maxCountMSAASamples == VK_SAMPLE_COUNT_FLAG_BITS_MAX_ENUM) {
                     VK_ERROR("Device::Create() : incorrect sample count!");
+                    EVSafeFreeObject(device);
                     return nullptr;
                 }
             }
@@ -95,11 +200,14 @@ bool EvoVulkan::Types::Device::Destroy() {
         return false;
     }
 
+    EVSafeFreeObject(m_layoutCache);
+    EVSafeFreeObject(m_samplerCache);
+
     this->m_familyQueues->Destroy();
     this->m_familyQueues->Free();
     this->m_familyQueues = nullptr;
 
-    vkDestroyDevice(m_logicalDevice, nullptr);
+    vkDestroyDevice(m_logicalDevice, Memory::GetAllocationCallbacks());
     this->m_logicalDevice = VK_NULL_HANDLE;
 
     return true;
@@ -152,7 +260,7 @@ VkCommandPool EvoVulkan::Types::Device::CreateCommandPool(VkCommandPoolCreateFla
         };
 
     VkCommandPool cmdPool = VK_NULL_HANDLE;
-    if (vkCreateCommandPool(*this, &commandPoolCreateInfo, nullptr, &cmdPool) != VK_SUCCESS) {
+    if (vkCreateCommandPool(*this, &commandPoolCreateInfo, Memory::GetAllocationCallbacks(), &cmdPool) != VK_SUCCESS) {
         VK_ERROR("Device::CreateCommandPool() : failed to create command pool!");
         return VK_NULL_HANDLE;
     }
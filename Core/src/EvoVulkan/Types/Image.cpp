@@ -25,25 +25,9 @@ EvoVulkan::Types::Image EvoVulkan::Types::Image::Create(const ImageCreateInfo &i
         return Image();
     }
 
-    VkImageCreateInfo imageInfo = {};
-    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width  = info.width;
-    imageInfo.extent.height = info.height;
-    imageInfo.extent.depth  = 1;
-    imageInfo.mipLevels     = info.mipLevels;
-    imageInfo.arrayLayers   = info.arrayLayers;
-    imageInfo.format        = info.format;
-    imageInfo.tiling        = info.tiling;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage         = info.usage;
-    imageInfo.samples       = (info.mipLevels > 1 || !info.multisampling) ? VK_SAMPLE_COUNT_1_BIT : info.device->GetMSAASamples();
-    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    const VkImageCreateInfo imageInfo = info.ToVulkanCreateInfo();
 
-    if (info.createFlagBits != VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM)
-        imageInfo.flags = info.createFlagBits;
-
-    Image image = info.allocator->AllocImage(imageInfo, info.CPUUsage);
+    Image image = info.allocator->AllocImage(imageInfo, info.CPUUsage, info.pool);
 
     if (!image.Valid()) {
         VK_ERROR("Image::Image() : failed to create vulkan image!");
@@ -58,6 +42,28 @@ EvoVulkan::Types::Image EvoVulkan::Types::Image::Create(const ImageCreateInfo &i
     return image;
 }
 
+VkImageCreateInfo EvoVulkan::Types::ImageCreateInfo::ToVulkanCreateInfo() const {
+    VkImageCreateInfo imageInfo = {};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = imageType;
+    imageInfo.extent.width  = width;
+    imageInfo.extent.height = imageType == VK_IMAGE_TYPE_1D ? 1 : height;
+    imageInfo.extent.depth  = imageType == VK_IMAGE_TYPE_3D ? depth : 1;
+    imageInfo.mipLevels     = mipLevels;
+    imageInfo.arrayLayers   = arrayLayers;
+    imageInfo.format        = format;
+    imageInfo.tiling        = tiling;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage         = usage;
+    imageInfo.samples       = (mipLevels > 1 || !multisampling) ? VK_SAMPLE_COUNT_1_BIT : device->GetMSAASamples();
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (createFlagBits != VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM)
+        imageInfo.flags = createFlagBits;
+
+    return imageInfo;
+}
+
 bool EvoVulkan::Types::Image::Valid() const {
     return m_image && m_allocation && m_allocator;
 }
@@ -68,6 +74,7 @@ EvoVulkan::Types::Image EvoVulkan::Types::Image::Copy() const {
     image.m_image = m_image;
     image.m_allocation = m_allocation;
     image.m_allocator = m_allocator;
+    image.m_aliased = m_aliased;
 
     return image;
 }
@@ -4,6 +4,7 @@
 
 #include <EvoVulkan/Types/Instance.h>
 #include <EvoVulkan/Tools/StringUtils.h>
+#include <EvoVulkan/Memory/HostAllocator.h>
 
 namespace EvoVulkan::Types {
     Instance* Instance::Create(const std::string& appName, const std::string& engineName,
@@ -77,7 +78,7 @@ namespace EvoVulkan::Types {
             instInfo.pNext = nullptr;
         }
 
-        VkResult result = vkCreateInstance(&instInfo, NULL, &instance->m_instance);
+        VkResult result = vkCreateInstance(&instInfo, Memory::GetAllocationCallbacks(), &instance->m_instance);
         if (result != VK_SUCCESS) {
             VK_ERROR("Instance::Create() : failed create vulkan instance! Reason: " + Tools::Convert::result_to_description(result));
             return nullptr;
@@ -97,7 +98,7 @@ namespace EvoVulkan::Types {
     }
 
     void Instance::Destroy() {
-        vkDestroyInstance(m_instance, nullptr);
+        vkDestroyInstance(m_instance, Memory::GetAllocationCallbacks());
         m_instance = VK_NULL_HANDLE;
     }
 
@@ -0,0 +1,239 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Types/LayoutCache.h>
+#include <EvoVulkan/Tools/VulkanTools.h>
+#include <EvoVulkan/Tools/HashUtils.h>
+
+bool EvoVulkan::Types::SetLayoutBindingKey::operator==(const EvoVulkan::Types::SetLayoutBindingKey &other) const {
+    return binding           == other.binding &&
+           descriptorType    == other.descriptorType &&
+           descriptorCount   == other.descriptorCount &&
+           stageFlags        == other.stageFlags &&
+           immutableSamplers == other.immutableSamplers;
+}
+
+EvoVulkan::Types::SetLayoutKey::SetLayoutKey(const std::vector<VkDescriptorSetLayoutBinding> &layoutBindings, VkDescriptorSetLayoutCreateFlags createFlags)
+    : flags(createFlags)
+{
+    bindings.reserve(layoutBindings.size());
+
+    for (auto&& layoutBinding : layoutBindings) {
+        SetLayoutBindingKey key;
+
+        key.binding         = layoutBinding.binding;
+        key.descriptorType  = layoutBinding.descriptorType;
+        key.descriptorCount = layoutBinding.descriptorCount;
+        key.stageFlags      = layoutBinding.stageFlags;
+
+        if (layoutBinding.pImmutableSamplers) {
+            key.immutableSamplers.assign(layoutBinding.pImmutableSamplers, layoutBinding.pImmutableSamplers + layoutBinding.descriptorCount);
+        }
+
+        bindings.emplace_back(std::move(key));
+    }
+
+    std::sort(bindings.begin(), bindings.end(), [](const SetLayoutBindingKey& a, const SetLayoutBindingKey& b) {
+        return a.binding < b.binding;
+    });
+}
+
+bool EvoVulkan::Types::SetLayoutKey::operator==(const EvoVulkan::Types::SetLayoutKey &other) const {
+    return flags == other.flags && bindings == other.bindings;
+}
+
+bool EvoVulkan::Types::PipelineLayoutKey::operator==(const EvoVulkan::Types::PipelineLayoutKey &other) const {
+    if (setLayouts != other.setLayouts || pushConstants.size() != other.pushConstants.size())
+        return false;
+
+    return std::equal(pushConstants.begin(), pushConstants.end(), other.pushConstants.begin(),
+        [](const VkPushConstantRange& a, const VkPushConstantRange& b) {
+            return a.stageFlags == b.stageFlags && a.offset == b.offset && a.size == b.size;
+        });
+}
+
+size_t EvoVulkan::Types::SetLayoutKeyHash::operator()(const EvoVulkan::Types::SetLayoutKey &key) const {
+    size_t hash = 0;
+
+    Tools::HashCombine(hash, key.flags);
+
+    for (auto&& binding : key.bindings) {
+        Tools::HashCombine(hash, binding.binding, static_cast<uint32_t>(binding.descriptorType), binding.descriptorCount, binding.stageFlags);
+
+        for (auto&& sampler : binding.immutableSamplers)
+            Tools::HashCombine(hash, sampler);
+    }
+
+    return hash;
+}
+
+size_t EvoVulkan::Types::PipelineLayoutKeyHash::operator()(const EvoVulkan::Types::PipelineLayoutKey &key) const {
+    size_t hash = 0;
+
+    for (auto&& layout : key.setLayouts)
+        Tools::HashCombine(hash, layout);
+
+    for (auto&& range : key.pushConstants)
+        Tools::HashCombine(hash, range.stageFlags, range.offset, range.size);
+
+    return hash;
+}
+
+EvoVulkan::Types::LayoutCache *EvoVulkan::Types::LayoutCache::Create(VkDevice device) {
+    if (device == VK_NULL_HANDLE) {
+        VK_ERROR("LayoutCache::Create() : device is nullptr!");
+        return nullptr;
+    }
+
+    auto&& cache = new LayoutCache();
+    cache->m_device = device;
+
+    return cache;
+}
+
+VkDescriptorSetLayout EvoVulkan::Types::LayoutCache::AcquireSetLayout(const std::vector<VkDescriptorSetLayoutBinding> &bindings, VkDescriptorSetLayoutCreateFlags flags) {
+    SetLayoutKey key = SetLayoutKey(bindings, flags);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto&& pIt = m_setLayouts.find(key); pIt != m_setLayouts.end()) {
+        ++m_setEntries.at(pIt->second).m_references;
+        return pIt->second;
+    }
+
+    /// создаем по ключу, указатели на неизменяемые семплеры смотрят в его векторы
+    std::vector<VkDescriptorSetLayoutBinding> sorted;
+    sorted.reserve(key.bindings.size());
+
+    for (auto&& binding : key.bindings) {
+        sorted.push_back({
+            binding.binding,
+            binding.descriptorType,
+            binding.descriptorCount,
+            binding.stageFlags,
+            binding.immutableSamplers.empty() ? nullptr : binding.immutableSamplers.data()
+        });
+    }
+
+    VkDescriptorSetLayout layout = Tools::CreateDescriptorLayout(m_device, sorted, flags);
+    if (layout == VK_NULL_HANDLE) {
+        VK_ERROR("LayoutCache::AcquireSetLayout() : failed to create descriptor set layout!");
+        return VK_NULL_HANDLE;
+    }
+
+    m_setLayouts.insert(std::make_pair(key, layout));
+    m_setEntries.insert(std::make_pair(layout, Entry<SetLayoutKey> { std::move(key), 1 }));
+
+    return layout;
+}
+
+bool EvoVulkan::Types::LayoutCache::ReleaseSetLayout(VkDescriptorSetLayout layout, const std::function<void(VkDescriptorSetLayout)>& onDestroy) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto&& pIt = m_setEntries.find(layout);
+    if (pIt == m_setEntries.end()) {
+        VK_ERROR("LayoutCache::ReleaseSetLayout() : descriptor set layout not found!");
+        return false;
+    }
+
+    if (--pIt->second.m_references > 0)
+        return true;
+
+    m_setLayouts.erase(pIt->second.m_key);
+    m_setEntries.erase(pIt);
+
+    if (onDestroy) {
+        onDestroy(layout);
+    }
+
+    vkDestroyDescriptorSetLayout(m_device, layout, Memory::GetAllocationCallbacks());
+
+    return true;
+}
+
+VkPipelineLayout EvoVulkan::Types::LayoutCache::AcquirePipelineLayout(const std::vector<VkDescriptorSetLayout> &setLayouts, const std::vector<VkPushConstantRange> &pushConstants) {
+    PipelineLayoutKey key = { setLayouts, pushConstants };
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto&& pIt = m_pipelineLayouts.find(key); pIt != m_pipelineLayouts.end()) {
+        ++m_pipelineEntries.at(pIt->second).m_references;
+        return pIt->second;
+    }
+
+    VkPipelineLayout layout = Tools::CreatePipelineLayout(m_device, setLayouts, pushConstants);
+    if (layout == VK_NULL_HANDLE) {
+        VK_ERROR("LayoutCache::AcquirePipelineLayout() : failed to create pipeline layout!");
+        return VK_NULL_HANDLE;
+    }
+
+    m_pipelineLayouts.insert(std::make_pair(key, layout));
+    m_pipelineEntries.insert(std::make_pair(layout, Entry<PipelineLayoutKey> { std::move(key), 1 }));
+
+    return layout;
+}
+
+bool EvoVulkan::Types::LayoutCache::ReleasePipelineLayout(VkPipelineLayout layout) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto&& pIt = m_pipelineEntries.find(layout);
+    if (pIt == m_pipelineEntries.end()) {
+        VK_ERROR("LayoutCache::ReleasePipelineLayout() : pipeline layout not found!");
+        return false;
+    }
+
+    if (--pIt->second.m_references > 0)
+        return true;
+
+    m_pipelineLayouts.erase(pIt->second.m_key);
+    m_pipelineEntries.erase(pIt);
+
+    vkDestroyPipelineLayout(m_device, layout, Memory::GetAllocationCallbacks());
+
+    return true;
+}
+
+uint32_t EvoVulkan::Types::LayoutCache::GetReferences(VkDescriptorSetLayout layout) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto&& pIt = m_setEntries.find(layout); pIt != m_setEntries.end())
+        return pIt->second.m_references;
+
+    return 0;
+}
+
+void EvoVulkan::Types::LayoutCache::Destroy() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_setEntries.empty() || !m_pipelineEntries.empty()) {
+        VK_WARN("LayoutCache::Destroy() : " + std::to_string(m_setEntries.size()) + " set layouts and " +
+                std::to_string(m_pipelineEntries.size()) + " pipeline layouts were not released!");
+    }
+
+    /// пайплайн лейауты ссылаются на лейауты сетов, поэтому уничтожаются первыми
+    for (auto&& [layout, entry] : m_pipelineEntries)
+        vkDestroyPipelineLayout(m_device, layout, Memory::GetAllocationCallbacks());
+
+    for (auto&& [layout, entry] : m_setEntries)
+        vkDestroyDescriptorSetLayout(m_device, layout, Memory::GetAllocationCallbacks());
+
+    m_pipelineEntries.clear();
+    m_pipelineLayouts.clear();
+    m_setEntries.clear();
+    m_setLayouts.clear();
+}
+
+void EvoVulkan::Types::LayoutCache::Free() {
+    delete this;
+}
+
+uint32_t EvoVulkan::Types::LayoutCache::GetSetLayoutsCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_setEntries.size());
+}
+
+uint32_t EvoVulkan::Types::LayoutCache::GetPipelineLayoutsCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_pipelineEntries.size());
+}
@@ -13,7 +13,9 @@ EvoVulkan::Types::MultisampleTarget *EvoVulkan::Types::MultisampleTarget::Create
         Swapchain* swapchain,
         uint32_t w, uint32_t h,
         const std::vector<VkFormat>& formats,
-        bool multisampling)
+        bool multisampling,
+        Memory::AliasingPool* aliasingPool,
+        uint32_t pass)
 {
     auto multisample = new MultisampleTarget();
     multisample->m_device        = device;
@@ -23,6 +25,8 @@ EvoVulkan::Types::MultisampleTarget *EvoVulkan::Types::MultisampleTarget::Create
     multisample->m_countResolves = formats.size();
     multisample->m_formats       = formats;
     multisample->m_multisampling = multisampling;
+    multisample->m_aliasingPool  = aliasingPool;
+    multisample->m_pass          = pass;
 
     if (!multisample->ReCreate(w, h)) {
         VK_ERROR("MultisampleTarget::Create() : failed to re-create multisample!");
@@ -47,15 +51,18 @@ bool EvoVulkan::Types::MultisampleTarget::ReCreate(uint32_t w, uint32_t h) {
 
     m_resolves = (Image*)malloc(sizeof(Image) * m_countResolves);
 
+    /// MSAA цвет нужен только до resolve в конце рендер пасса, поэтому он transient и на тайловых GPU не занимает память
     auto imageCI = Types::ImageCreateInfo(
             m_device, m_allocator, w, h,
-            VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (m_multisampling ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT : VK_IMAGE_USAGE_SAMPLED_BIT),
             m_multisampling);
 
+    imageCI.pool = Memory::MemoryPool::Attachments;
+
     for (uint32_t i = 0; i < m_countResolves; ++i) {
         imageCI.format = m_formats[i];
 
-        if (!(m_resolves[i].m_image = Types::Image::Create(imageCI)).Valid()) {
+        if (!(m_resolves[i].m_image = CreateTransientImage(imageCI)).Valid()) {
             VK_ERROR("MultisampleTarget::ReCreate() : failed to create resolve image!");
             return false;
         }
@@ -73,7 +80,7 @@ bool EvoVulkan::Types::MultisampleTarget::ReCreate(uint32_t w, uint32_t h) {
     imageCI.format = m_swapchain->GetDepthFormat();
     imageCI.usage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 
-    if (!(m_depth.m_image = Types::Image::Create(imageCI)).Valid()) {
+    if (!(m_depth.m_image = CreateTransientImage(imageCI)).Valid()) {
         VK_ERROR("MultisampleTarget::ReCreate() : failed to create depth image!");
         return false;
     }
@@ -92,8 +99,8 @@ void EvoVulkan::Types::MultisampleTarget::Destroy() {
     if (m_resolves) {
         for (uint32_t i = 0; i < m_countResolves; ++i) {
             if (m_resolves[i].m_image && m_resolves[i].m_view && m_resolves[i].m_image.Valid()) {
-                vkDestroyImageView(*m_device, m_resolves[i].m_view, nullptr);
-                m_allocator->FreeImage(m_resolves[i].m_image);
+                vkDestroyImageView(*m_device, m_resolves[i].m_view, Memory::GetAllocationCallbacks());
+                FreeTransientImage(m_resolves[i].m_image);
                 m_resolves[i].m_view = VK_NULL_HANDLE;
             }
         }
@@ -103,8 +110,29 @@ void EvoVulkan::Types::MultisampleTarget::Destroy() {
     }
 
     if (m_depth.m_image && m_depth.m_view && m_depth.m_image.Valid()) {
-        vkDestroyImageView(*m_device, m_depth.m_view, nullptr);
-        m_allocator->FreeImage(m_depth.m_image);
+        vkDestroyImageView(*m_device, m_depth.m_view, Memory::GetAllocationCallbacks());
+        FreeTransientImage(m_depth.m_image);
         m_depth.m_view = VK_NULL_HANDLE;
     }
 }
+
+EvoVulkan::Types::Image EvoVulkan::Types::MultisampleTarget::CreateTransientImage(const ImageCreateInfo& info) const {
+    /// transient вложения живут только внутри своего прохода. Если есть lazily allocated память,
+    /// она выгоднее алиасинга, так как на тайловых GPU вообще не выделяется
+    const bool transient = info.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
+    if (transient && m_aliasingPool && !m_allocator->HasLazilyAllocatedMemory()) {
+        return m_aliasingPool->CreateImage(info.ToVulkanCreateInfo(), { m_pass, m_pass });
+    }
+
+    return Types::Image::Create(info);
+}
+
+void EvoVulkan::Types::MultisampleTarget::FreeTransientImage(Types::Image& image) const {
+    if (image.IsAliased()) {
+        m_aliasingPool->DestroyImage(image);
+    }
+    else {
+        m_allocator->FreeImage(image);
+    }
+}
@@ -0,0 +1,170 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Types/SamplerCache.h>
+#include <EvoVulkan/Tools/VulkanInitializers.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+#include <EvoVulkan/Tools/VulkanConverter.h>
+#include <EvoVulkan/Tools/HashUtils.h>
+#include <EvoVulkan/Memory/HostAllocator.h>
+
+EvoVulkan::Types::SamplerKey::SamplerKey(const VkSamplerCreateInfo &info)
+    : flags(info.flags)
+    , magFilter(info.magFilter)
+    , minFilter(info.minFilter)
+    , mipmapMode(info.mipmapMode)
+    , addressModeU(info.addressModeU)
+    , addressModeV(info.addressModeV)
+    , addressModeW(info.addressModeW)
+    , mipLodBias(info.mipLodBias)
+    , anisotropyEnable(info.anisotropyEnable)
+    , maxAnisotropy(info.maxAnisotropy)
+    , compareEnable(info.compareEnable)
+    , compareOp(info.compareOp)
+    , minLod(info.minLod)
+    , maxLod(info.maxLod)
+    , borderColor(info.borderColor)
+    , unnormalizedCoordinates(info.unnormalizedCoordinates)
+{ }
+
+bool EvoVulkan::Types::SamplerKey::operator==(const EvoVulkan::Types::SamplerKey &other) const {
+    return flags                   == other.flags &&
+           magFilter               == other.magFilter &&
+           minFilter               == other.minFilter &&
+           mipmapMode              == other.mipmapMode &&
+           addressModeU            == other.addressModeU &&
+           addressModeV            == other.addressModeV &&
+           addressModeW            == other.addressModeW &&
+           mipLodBias              == other.mipLodBias &&
+           anisotropyEnable        == other.anisotropyEnable &&
+           maxAnisotropy           == other.maxAnisotropy &&
+           compareEnable           == other.compareEnable &&
+           compareOp               == other.compareOp &&
+           minLod                  == other.minLod &&
+           maxLod                  == other.maxLod &&
+           borderColor             == other.borderColor &&
+           unnormalizedCoordinates == other.unnormalizedCoordinates;
+}
+
+VkSamplerCreateInfo EvoVulkan::Types::SamplerKey::ToCreateInfo() const {
+    VkSamplerCreateInfo info = Tools::Initializers::SamplerCreateInfo();
+
+    info.flags                   = flags;
+    info.magFilter               = magFilter;
+    info.minFilter               = minFilter;
+    info.mipmapMode              = mipmapMode;
+    info.addressModeU            = addressModeU;
+    info.addressModeV            = addressModeV;
+    info.addressModeW            = addressModeW;
+    info.mipLodBias              = mipLodBias;
+    info.anisotropyEnable        = anisotropyEnable;
+    info.maxAnisotropy           = maxAnisotropy;
+    info.compareEnable           = compareEnable;
+    info.compareOp               = compareOp;
+    info.minLod                  = minLod;
+    info.maxLod                  = maxLod;
+    info.borderColor             = borderColor;
+    info.unnormalizedCoordinates = unnormalizedCoordinates;
+
+    return info;
+}
+
+size_t EvoVulkan::Types::SamplerKeyHash::operator()(const EvoVulkan::Types::SamplerKey &key) const {
+    size_t hash = 0;
+
+    Tools::HashCombine(hash,
+        key.flags, static_cast<uint32_t>(key.magFilter), static_cast<uint32_t>(key.minFilter),
+        static_cast<uint32_t>(key.mipmapMode), static_cast<uint32_t>(key.addressModeU),
+        static_cast<uint32_t>(key.addressModeV), static_cast<uint32_t>(key.addressModeW),
+        key.mipLodBias, key.anisotropyEnable, key.maxAnisotropy, key.compareEnable,
+        static_cast<uint32_t>(key.compareOp), key.minLod, key.maxLod,
+        static_cast<uint32_t>(key.borderColor), key.unnormalizedCoordinates);
+
+    return hash;
+}
+
+EvoVulkan::Types::SamplerCache *EvoVulkan::Types::SamplerCache::Create(VkDevice device) {
+    if (device == VK_NULL_HANDLE) {
+        VK_ERROR("SamplerCache::Create() : device is nullptr!");
+        return nullptr;
+    }
+
+    auto&& cache = new SamplerCache();
+    cache->m_device = device;
+
+    return cache;
+}
+
+VkSampler EvoVulkan::Types::SamplerCache::Acquire(const VkSamplerCreateInfo &info) {
+    if (info.pNext) {
+        VK_WARN("SamplerCache::Acquire() : pNext chain is ignored by the sampler cache!");
+    }
+
+    const SamplerKey key = SamplerKey(info);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto&& pIt = m_samplers.find(key); pIt != m_samplers.end()) {
+        ++m_entries.at(pIt->second).m_references;
+        return pIt->second;
+    }
+
+    const VkSamplerCreateInfo createInfo = key.ToCreateInfo();
+
+    VkSampler sampler = VK_NULL_HANDLE;
+    if (auto result = vkCreateSampler(m_device, &createInfo, Memory::GetAllocationCallbacks(), &sampler); result != VK_SUCCESS) {
+        VK_ERROR("SamplerCache::Acquire() : failed to create vulkan sampler!"
+                 "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                 "\n\tDescription: " + Tools::Convert::result_to_description(result));
+        return VK_NULL_HANDLE;
+    }
+
+    m_samplers.insert(std::make_pair(key, sampler));
+    m_entries.insert(std::make_pair(sampler, Entry { key, 1 }));
+
+    return sampler;
+}
+
+bool EvoVulkan::Types::SamplerCache::Release(VkSampler sampler) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto&& pIt = m_entries.find(sampler);
+    if (pIt == m_entries.end()) {
+        VK_ERROR("SamplerCache::Release() : sampler not found!");
+        return false;
+    }
+
+    if (--pIt->second.m_references > 0)
+        return true;
+
+    m_samplers.erase(pIt->second.m_key);
+    m_entries.erase(pIt);
+
+    vkDestroySampler(m_device, sampler, Memory::GetAllocationCallbacks());
+
+    return true;
+}
+
+void EvoVulkan::Types::SamplerCache::Destroy() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_entries.empty()) {
+        VK_WARN("SamplerCache::Destroy() : " + std::to_string(m_entries.size()) + " samplers were not released!");
+    }
+
+    for (auto&& [sampler, entry] : m_entries)
+        vkDestroySampler(m_device, sampler, Memory::GetAllocationCallbacks());
+
+    m_entries.clear();
+    m_samplers.clear();
+}
+
+void EvoVulkan::Types::SamplerCache::Free() {
+    delete this;
+}
+
+uint32_t EvoVulkan::Types::SamplerCache::GetSamplersCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_entries.size());
+}
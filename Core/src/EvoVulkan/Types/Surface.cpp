@@ -53,7 +53,7 @@ namespace EvoVulkan::Types {
         free(m_surfFormats);
         m_surfFormats = nullptr;
 
-        vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+        vkDestroySurfaceKHR(m_instance, m_surface, Memory::GetAllocationCallbacks());
         m_surface     = VK_NULL_HANDLE;
 
         m_instance    = VK_NULL_HANDLE;
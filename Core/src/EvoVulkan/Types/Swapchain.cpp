@@ -143,7 +143,7 @@ bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height, uint3
 
     VK_GRAPH("Swapchain::ReSetup() : create swapchain struct...");
 
-    if (vkCreateSwapchainKHR(*m_device, &swapchainCI, nullptr, &m_swapchain) != VK_SUCCESS) {
+    if (vkCreateSwapchainKHR(*m_device, &swapchainCI, Memory::GetAllocationCallbacks(), &m_swapchain) != VK_SUCCESS) {
         VK_ERROR("Swapchain::ReSetup() : failed to create swapchain!");
         return false;
     }
@@ -153,7 +153,7 @@ bool EvoVulkan::Types::Swapchain::ReSetup(uint32_t width, uint32_t height, uint3
     //! Note: destroying the swapchain also cleans up all its associated
     //! presentable images once the platform is done with them.
     if (oldSwapchain != VK_NULL_HANDLE)
-        vkDestroySwapchainKHR(*m_device, oldSwapchain, nullptr);
+        vkDestroySwapchainKHR(*m_device, oldSwapchain, Memory::GetAllocationCallbacks());
 
     //!=================================================================================================================
 
@@ -199,7 +199,7 @@ void EvoVulkan::Types::Swapchain::Destroy() {
 
     DestroyBuffers();
 
-    vkDestroySwapchainKHR(*m_device, m_swapchain, nullptr);
+    vkDestroySwapchainKHR(*m_device, m_swapchain, Memory::GetAllocationCallbacks());
     m_swapchain = VK_NULL_HANDLE;
 
     m_device      = nullptr;
@@ -257,7 +257,7 @@ bool EvoVulkan::Types::Swapchain::InitFormats() {
 void EvoVulkan::Types::Swapchain::DestroyBuffers() {
     if (m_countImages > 0 && m_swapchainImages && m_device) {
         for (uint32_t i = 0; i < m_countImages; ++i)
-            vkDestroyImageView(*m_device, m_buffers[i].m_view, nullptr);
+            vkDestroyImageView(*m_device, m_buffers[i].m_view, Memory::GetAllocationCallbacks());
 
         free(m_buffers);
         m_buffers = nullptr;
@@ -333,7 +333,7 @@ bool EvoVulkan::Types::Swapchain::CreateBuffers() {
 
         colorAttachmentView.image = m_buffers[i].m_image;
 
-        auto result = vkCreateImageView(*m_device, &colorAttachmentView, nullptr, &m_buffers[i].m_view);
+        auto result = vkCreateImageView(*m_device, &colorAttachmentView, Memory::GetAllocationCallbacks(), &m_buffers[i].m_view);
         if (result != VK_SUCCESS) {
             VK_ERROR("Swapchain::CreateBuffers() : failed to create images view! Reason: "
                 + Tools::Convert::result_to_description(result));
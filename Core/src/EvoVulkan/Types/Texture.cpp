@@ -7,30 +7,15 @@
 #include <EvoVulkan/Types/VmaBuffer.h>
 #include <EvoVulkan/Types/Device.h>
 #include <EvoVulkan/DescriptorManager.h>
+#include <EvoVulkan/BindlessTextureTable.h>
+#include <EvoVulkan/DescriptorCache.h>
 #include <EvoVulkan/Memory/Allocator.h>
-
-uint64_t GetDataSize(uint32_t w, uint32_t h, uint8_t level) {
-    uint64_t dataSize = 0;
-    for (uint8_t i = 0; i < level; i++) {
-        dataSize += w * h * 4 * 6;
-        w /= 2;
-        h /= 2;
-    }
-    return dataSize;
-}
-
-uint64_t GetImageSize(uint32_t w, uint32_t h, uint8_t level, uint8_t face) {
-    for (uint8_t i = 0; i < level; i++) {
-        w /= 2;
-        h /= 2;
-    }
-
-    return (w * h * 4) * face;
-}
+#include <EvoVulkan/Tools/FormatUtils.h>
 
 EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
     Device *device,
     Memory::Allocator *allocator,
+    Core::DescriptorManager* manager,
     CmdPool *pool,
     VkFormat format,
     int32_t width,
@@ -45,19 +30,24 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
     }
 
     if (mipLevels == 0) {
-        mipLevels = std::floor(std::log2(EVK_MAX(width, height))) + 1;
+        mipLevels = Tools::GetMaxMipLevels(width, height);
     }
 
+    mipLevels = GetSupportedMipLevels(device, format, mipLevels);
+
     VK_LOG("Texture::LoadCubeMap() : loading new cube map texture... \n\tWidth: " +
-           std::to_string(width) + "\n\tHeight: " + std::to_string(height));
+           std::to_string(width) + "\n\tHeight: " + std::to_string(height) +
+           "\n\tFormat: " + Tools::Convert::format_to_string(format) +
+           "\n\tMip levels: " + std::to_string(mipLevels));
 
     auto&& texture = new Texture();
     {
         texture->m_width             = width;
         texture->m_height            = height;
         texture->m_mipLevels         = mipLevels;
+        texture->m_layers            = 6;
         texture->m_format            = format;
-        texture->m_descriptorManager = nullptr;
+        texture->m_descriptorManager = manager;
         texture->m_allocator         = allocator;
         texture->m_device            = device;
         texture->m_canBeDestroyed    = true;
@@ -67,176 +57,193 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadCubeMap(
         texture->m_cpuUsage          = cpuUsage;
     }
 
-    const VkDeviceSize imageSize = width * height * 4 * 6;
+    /// в staging лежит только нулевой мип-уровень каждой грани, остальные уровни генерируются на GPU
+    const VkDeviceSize layerSize = Tools::GetMipLevelSize(format, width, height, 0);
 
-    auto&& stagingBuffer = VmaBuffer::Create(allocator, imageSize * 2); // TODO: imageSize * 2? Check correctly or fix
-    if (void* data = stagingBuffer->MapData(); !data || !stagingBuffer) {
+    auto&& stagingBuffer = VmaBuffer::Create(allocator, layerSize * 6);
+    if (void* data = stagingBuffer ? stagingBuffer->MapData() : nullptr; !data) {
         VK_ERROR("Texture::LoadCubeMap() : failed to map memory!");
+        EVSafeFreeObject(stagingBuffer);
         return nullptr;
     }
     else {
-        const uint64_t layerSize = imageSize / 6;
         for (uint8_t i = 0; i < 6; ++i)
             memcpy(static_cast<uint8_t*>(data) + (layerSize * i), sides[i], layerSize);
         stagingBuffer->Unmap();
     }
 
-    /*texture->m_image = Tools::CreateImage(
-            texture->m_device,
-            texture->m_width, texture->m_height,
-            texture->m_mipLevels,
-            texture->m_format,
-            VK_IMAGE_TILING_OPTIMAL,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            &texture->m_deviceMemory,
-            false, // multisampling
-            VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, // flags
-            6); // cube map*/
+    if (!texture->Create(stagingBuffer)) {
+        VK_ERROR("Texture::LoadCubeMap() : failed to create!");
+        return nullptr;
+    }
 
-    auto imageCI = Types::ImageCreateInfo(
-            texture->m_device, texture->m_allocator, texture->m_width, texture->m_height, texture->m_format,
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            false, false, texture->m_mipLevels, 6, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
+    return texture;
+}
 
-    if (!(texture->m_image = Types::Image::Create(imageCI)).Valid()) {
-        VK_ERROR("Texture::LoadCubeMap() : failed to create image!");
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
+        EvoVulkan::Types::Device *device,
+        Memory::Allocator *allocator,
+        Core::DescriptorManager* manager,
+        EvoVulkan::Types::CmdPool *pool,
+        const unsigned char *pixels,
+        VkFormat format,
+        int32_t width,
+        int32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        bool cpuUsage)
+{
+    if (!pixels) {
+        VK_ERROR("Texture::Load() : pixels is nullptr!");
         return nullptr;
     }
 
-    std::vector<VkBufferImageCopy> bufferCopyRegions = {};
-    for (uint8_t face = 0; face < 6; face++) {
-        for (uint8_t level = 0; level < (uint8_t) mipLevels; level++) {
-            uint64_t offset = GetDataSize(width, height, level);
-
-            if (face != 0)
-                offset += GetImageSize(width, height, level, face);
-
-            VkBufferImageCopy bufferCopyRegion = {};
-            bufferCopyRegion.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-            bufferCopyRegion.imageSubresource.mipLevel       = level;
-            bufferCopyRegion.imageSubresource.baseArrayLayer = face;
-            bufferCopyRegion.imageSubresource.layerCount     = 1;
-            bufferCopyRegion.imageExtent.width               = width >> level;
-            bufferCopyRegion.imageExtent.height              = height >> level;
-            bufferCopyRegion.imageExtent.depth               = 1;
-            bufferCopyRegion.bufferOffset                    = offset;
-            bufferCopyRegions.emplace_back(bufferCopyRegion);
-        }
+    if (width <= 0 || height <= 0) {
+        VK_ERROR("Texture::Load() : incorrect texture size!");
+        return nullptr;
     }
 
-    auto copyCmd = Types::CmdBuffer::BeginSingleTime(device, pool);
+    mipLevels = GetSupportedMipLevels(device, format, mipLevels);
 
-    Tools::TransitionImageLayout(
-            copyCmd, texture->m_image,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            mipLevels, 6);
+    VK_LOG("Texture::Load() : loading new texture... \n\tWidth: " +
+           std::to_string(width) + "\n\tHeight: " +
+           std::to_string(height) + "\n\tFormat: " +
+           Tools::Convert::format_to_string(format) + "\n\tMip levels: " +
+           std::to_string(mipLevels) + "\n\tCPU usage: " + std::string(cpuUsage ? "True" : "False"));
 
+    auto *texture = new Texture();
     {
-        if (!copyCmd->IsBegin())
-            copyCmd->Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+        texture->m_width             = width;
+        texture->m_height            = height;
+        texture->m_mipLevels         = mipLevels;
+        texture->m_layers            = 1;
+        texture->m_format            = format;
+        texture->m_descriptorManager = manager;
+        texture->m_allocator         = allocator;
+        texture->m_device            = device;
+        texture->m_canBeDestroyed    = true;
+        texture->m_pool              = pool;
+        texture->m_filter            = filter;
+        texture->m_cubeMap           = false;
+        texture->m_cpuUsage          = cpuUsage;
+    }
 
-        // Copy the cube map faces from the staging buffer to the optimal tiled image
-        vkCmdCopyBufferToImage(
-                *copyCmd,
-                *stagingBuffer,
-                texture->m_image,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                static_cast<uint32_t>(bufferCopyRegions.size()),
-                bufferCopyRegions.data()
-        );
+    const VkDeviceSize imageSize = Tools::GetMipLevelSize(format, width, height, 0);
 
-        copyCmd->End();
+    auto stagingBuffer = VmaBuffer::Create(allocator, imageSize, (void*)pixels);
+    if (!texture->Create(stagingBuffer)) {
+        VK_ERROR("Texture::Load() : failed to create!");
+        return nullptr;
     }
 
-    Tools::TransitionImageLayout(
-            copyCmd, texture->m_image,
-            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-            mipLevels, 6);
+    return texture;
+}
 
-    texture->m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::LoadArray(
+        EvoVulkan::Types::Device *device,
+        Memory::Allocator *allocator,
+        Core::DescriptorManager* manager,
+        EvoVulkan::Types::CmdPool *pool,
+        const std::vector<const uint8_t*>& layers,
+        VkFormat format,
+        int32_t width,
+        int32_t height,
+        uint32_t mipLevels,
+        VkFilter filter,
+        bool cpuUsage)
+{
+    if (layers.empty()) {
+        VK_ERROR("Texture::LoadArray() : layers is empty!");
+        return nullptr;
+    }
 
-    //!=================================================================================================================
+    if (width <= 0 || height <= 0) {
+        VK_ERROR("Texture::LoadArray() : incorrect texture size!");
+        return nullptr;
+    }
 
-    copyCmd->Destroy();
-    copyCmd->Free();
+    if (std::find(layers.begin(), layers.end(), nullptr) != layers.end()) {
+        VK_ERROR("Texture::LoadArray() : one of the layers is nullptr!");
+        return nullptr;
+    }
 
-    stagingBuffer->Destroy();
-    stagingBuffer->Free();
+    mipLevels = GetSupportedMipLevels(device, format, mipLevels);
 
-    //!=================================================================================================================
+    VK_LOG("Texture::LoadArray() : loading new texture array... \n\tWidth: " +
+           std::to_string(width) + "\n\tHeight: " +
+           std::to_string(height) + "\n\tLayers: " +
+           std::to_string(layers.size()) + "\n\tFormat: " +
+           Tools::Convert::format_to_string(format) + "\n\tMip levels: " +
+           std::to_string(mipLevels));
 
-    texture->m_view = Tools::CreateImageView(
-            *texture->m_device,
-            texture->m_image,
-            texture->m_format,
-            texture->m_mipLevels,
-            VK_IMAGE_ASPECT_COLOR_BIT,
-            true);
-    if (texture->m_view == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::LoadCubeMap() : failed to create image view!");
-        return nullptr;
+    auto *texture = new Texture();
+    {
+        texture->m_width             = width;
+        texture->m_height            = height;
+        texture->m_mipLevels         = mipLevels;
+        texture->m_layers            = static_cast<uint32_t>(layers.size());
+        texture->m_format            = format;
+        texture->m_descriptorManager = manager;
+        texture->m_allocator         = allocator;
+        texture->m_device            = device;
+        texture->m_canBeDestroyed    = true;
+        texture->m_pool              = pool;
+        texture->m_filter            = filter;
+        texture->m_cubeMap           = false;
+        texture->m_array             = true;
+        texture->m_cpuUsage          = cpuUsage;
     }
 
-    //!=================================================================================================================
+    const VkDeviceSize layerSize = Tools::GetMipLevelSize(format, width, height, 0);
 
-    texture->m_sampler = Tools::CreateSampler(
-            texture->m_device,
-            texture->m_mipLevels,
-            texture->m_filter, texture->m_filter,
-            VK_SAMPLER_ADDRESS_MODE_REPEAT,
-            VK_COMPARE_OP_NEVER);
-    if (texture->m_sampler == VK_NULL_HANDLE) {
-        VK_ERROR("Texture::Create() : LoadCubeMap to create sampler image!");
+    auto&& stagingBuffer = VmaBuffer::Create(allocator, layerSize * layers.size());
+    if (void* data = stagingBuffer ? stagingBuffer->MapData() : nullptr; !data) {
+        VK_ERROR("Texture::LoadArray() : failed to map memory!");
+        EVSafeFreeObject(stagingBuffer);
         return nullptr;
     }
+    else {
+        for (uint32_t i = 0; i < layers.size(); ++i)
+            memcpy(static_cast<uint8_t*>(data) + (layerSize * i), layers[i], layerSize);
+        stagingBuffer->Unmap();
+    }
 
-    //!=================================================================================================================
+    if (!texture->Create(stagingBuffer)) {
+        VK_ERROR("Texture::LoadArray() : failed to create!");
+        return nullptr;
+    }
 
-    //! make a texture descriptor
-    texture->m_descriptor = {
-            texture->m_sampler,
-            texture->m_view,
-            texture->m_imageLayout
-    };
     return texture;
 }
 
-EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
+EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::CreateArray(
         EvoVulkan::Types::Device *device,
         Memory::Allocator *allocator,
         Core::DescriptorManager* manager,
         EvoVulkan::Types::CmdPool *pool,
-        const unsigned char *pixels,
         VkFormat format,
         int32_t width,
         int32_t height,
-        uint32_t mipLevels,
-        VkFilter filter,
-        bool cpuUsage)
+        uint32_t layers,
+        VkFilter filter)
 {
-    if (!pixels) {
-        VK_ERROR("Texture::Load() : pixels is nullptr!");
+    if (width <= 0 || height <= 0 || layers == 0) {
+        VK_ERROR("Texture::CreateArray() : incorrect texture size!");
         return nullptr;
     }
 
-    if (!device->IsSupportLinearBlitting(format)) {
-        VK_ERROR("Texture::Load() : device does not support linear blitting!");
-        return nullptr;
-    }
-
-    VK_LOG("Texture::Load() : loading new texture... \n\tWidth: " +
+    VK_LOG("Texture::CreateArray() : create new empty texture array... \n\tWidth: " +
            std::to_string(width) + "\n\tHeight: " +
-           std::to_string(height) + "\n\tMip levels: " +
-           std::to_string(mipLevels) + "\n\tCPU usage: " + std::string(cpuUsage ? "True" : "False"));
+           std::to_string(height) + "\n\tLayers: " +
+           std::to_string(layers) + "\n\tFormat: " +
+           Tools::Convert::format_to_string(format));
 
     auto *texture = new Texture();
     {
         texture->m_width             = width;
         texture->m_height            = height;
-        texture->m_mipLevels         = mipLevels;
+        texture->m_mipLevels         = 1;
+        texture->m_layers            = layers;
         texture->m_format            = format;
         texture->m_descriptorManager = manager;
         texture->m_allocator         = allocator;
@@ -245,18 +252,140 @@ EvoVulkan::Types::Texture* EvoVulkan::Types::Texture::Load(
         texture->m_pool              = pool;
         texture->m_filter            = filter;
         texture->m_cubeMap           = false;
-        texture->m_cpuUsage          = cpuUsage;
+        texture->m_array             = true;
+        texture->m_cpuUsage          = false;
     }
 
-    auto stagingBuffer = VmaBuffer::Create(allocator, texture->m_width * texture->m_height * 4, (void*)pixels);
-    if (!texture->Create(stagingBuffer)) {
-        VK_ERROR("Texture::Load() : failed to create!");
+    if (!texture->Create(nullptr)) {
+        VK_ERROR("Texture::CreateArray() : failed to create!");
         return nullptr;
     }
 
     return texture;
 }
 
+bool EvoVulkan::Types::Texture::CopyRegion(const uint8_t* pixels, uint32_t layer, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    return CopyRegions({ TextureRegion { pixels, layer, x, y, width, height } });
+}
+
+bool EvoVulkan::Types::Texture::CopyRegions(const std::vector<TextureRegion>& regions) {
+    if (regions.empty()) {
+        return true;
+    }
+
+    if (m_mipLevels != 1) {
+        VK_ERROR("Texture::CopyRegions() : texture with mip maps isn't supported!");
+        return false;
+    }
+
+    const uint32_t extent    = Tools::GetFormatBlockExtent(m_format);
+    const uint32_t blockSize = Tools::GetFormatBlockSize(m_format);
+    /// смещение в буфере должно быть кратно и 4, и размеру блока формата
+    const VkDeviceSize alignment = blockSize % 4 == 0 ? blockSize : blockSize * 4;
+
+    std::vector<VkBufferImageCopy> copies;
+    copies.reserve(regions.size());
+
+    VkDeviceSize stagingSize = 0;
+    uint32_t minLayer = UINT32_MAX, maxLayer = 0;
+
+    for (auto&& region : regions) {
+        if (!region.m_pixels || region.m_width == 0 || region.m_height == 0) {
+            VK_ERROR("Texture::CopyRegions() : invalid source data!");
+            return false;
+        }
+
+        if (region.m_layer >= m_layers || region.m_x + region.m_width > m_width || region.m_y + region.m_height > m_height) {
+            VK_ERROR("Texture::CopyRegions() : region is out of texture bounds!");
+            return false;
+        }
+
+        if ((region.m_x % extent) || (region.m_y % extent) || (region.m_width % extent) || (region.m_height % extent)) {
+            VK_ERROR("Texture::CopyRegions() : region isn't aligned to compressed block size!");
+            return false;
+        }
+
+        stagingSize = (stagingSize + alignment - 1) / alignment * alignment;
+
+        VkBufferImageCopy copy = {};
+        copy.bufferOffset                    = stagingSize;
+        copy.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy.imageSubresource.mipLevel       = 0;
+        copy.imageSubresource.baseArrayLayer = region.m_layer;
+        copy.imageSubresource.layerCount     = 1;
+        copy.imageOffset                     = { static_cast<int32_t>(region.m_x), static_cast<int32_t>(region.m_y), 0 };
+        copy.imageExtent                     = { region.m_width, region.m_height, 1 };
+
+        copies.emplace_back(copy);
+
+        stagingSize += Tools::GetMipLevelSize(m_format, region.m_width, region.m_height, 0);
+
+        minLayer = EVK_MIN(minLayer, region.m_layer);
+        maxLayer = EVK_MAX(maxLayer, region.m_layer);
+    }
+
+    auto&& stagingBuffer = VmaBuffer::Create(m_allocator, stagingSize, nullptr);
+    if (!stagingBuffer) {
+        VK_ERROR("Texture::CopyRegions() : failed to create staging buffer!");
+        return false;
+    }
+
+    auto&& mapped = static_cast<uint8_t*>(stagingBuffer->MapData());
+    if (!mapped) {
+        VK_ERROR("Texture::CopyRegions() : failed to map staging buffer!");
+        EVSafeFreeObject(stagingBuffer);
+        return false;
+    }
+
+    for (size_t i = 0; i < regions.size(); ++i) {
+        memcpy(mapped + copies[i].bufferOffset, regions[i].m_pixels,
+               Tools::GetMipLevelSize(m_format, regions[i].m_width, regions[i].m_height, 0));
+    }
+
+    stagingBuffer->Flush();
+    stagingBuffer->Unmap();
+
+    auto&& copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_pool);
+
+    /// один барьер на весь диапазон затронутых слоев, промежуточные слои переходят в тот же лейаут и обратно
+    const VkImageSubresourceRange subresourceRange = {
+            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel   = 0,
+            .levelCount     = 1,
+            .baseArrayLayer = minLayer,
+            .layerCount     = maxLayer - minLayer + 1
+    };
+
+    Tools::Insert::ImageMemoryBarrier(
+            *copyCmd,
+            m_image,
+            VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            m_imageLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            subresourceRange);
+
+    vkCmdCopyBufferToImage(*copyCmd, *stagingBuffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(copies.size()), copies.data());
+
+    Tools::Insert::ImageMemoryBarrier(
+            *copyCmd,
+            m_image,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_imageLayout,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            subresourceRange);
+
+    const bool result = copyCmd->End();
+
+    copyCmd->Destroy();
+    copyCmd->Free();
+
+    stagingBuffer->Destroy();
+    stagingBuffer->Free();
+
+    return result;
+}
+
 bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffer) {
     /*m_image = Tools::CreateImage(
             m_device,
@@ -272,25 +401,39 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
     auto imageCI = Types::ImageCreateInfo(
             m_device, m_allocator, m_width, m_height, m_format,
             VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-            false, m_cpuUsage, m_mipLevels);
+            false, m_cpuUsage, m_mipLevels, m_layers,
+            m_cubeMap ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : VK_IMAGE_CREATE_FLAG_BITS_MAX_ENUM);
+
+    imageCI.pool = Memory::MemoryPool::Textures;
 
     if (!(m_image = Types::Image::Create(imageCI)).Valid()) {
         VK_ERROR("Texture::Create() : failed to create image!");
         return false;
     }
 
+    m_imageInfo = imageCI.ToVulkanCreateInfo();
+
     auto copyCmd = Types::CmdBuffer::BeginSingleTime(m_device, m_pool);
 
-    Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels);
-    Tools::CopyBufferToImage(copyCmd, *stagingBuffer, m_image, m_width, m_height);
-    if (m_mipLevels == 1) {
-        Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels);
+    /// без данных (пустой массив) изображение сразу переводится в layout для чтения
+    if (!stagingBuffer) {
+        Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_UNDEFINED,
+                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, m_layers);
         m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    } else
-    if (!GenerateMipmaps(this, copyCmd)) {
-        VK_ERROR("Texture::Create() : failed to generate mip maps!");
-        return false;
+    }
+    else {
+        Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_mipLevels, m_layers);
+        Tools::CopyBufferToImage(copyCmd, *stagingBuffer, m_image, m_width, m_height, m_layers,
+                                 Tools::GetMipLevelSize(m_format, m_width, m_height, 0));
+        if (m_mipLevels == 1) {
+            Tools::TransitionImageLayout(copyCmd, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_mipLevels, m_layers);
+            m_imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        } else
+        if (!GenerateMipmaps(this, copyCmd)) {
+            VK_ERROR("Texture::Create() : failed to generate mip maps!");
+            return false;
+        }
     }
 
     //!=================================================================================================================
@@ -298,8 +441,7 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
     copyCmd->Destroy();
     copyCmd->Free();
 
-    stagingBuffer->Destroy();
-    stagingBuffer->Free();
+    EVSafeFreeObject(stagingBuffer);
 
     //!=================================================================================================================
 
@@ -309,7 +451,8 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
             m_format,
             m_mipLevels,
             VK_IMAGE_ASPECT_COLOR_BIT,
-            m_cubeMap);
+            GetViewType(),
+            m_layers);
     if (m_view == VK_NULL_HANDLE) {
         VK_ERROR("Texture::Create() : failed to create image view!");
         return false;
@@ -337,9 +480,170 @@ bool EvoVulkan::Types::Texture::Create(EvoVulkan::Types::VmaBuffer *stagingBuffe
             m_imageLayout
     };
 
+    //!=================================================================================================================
+
+    /// в bindless таблице лежит sampler2D[], поэтому кубмапы и массивы туда не попадают
+    if (m_descriptorManager && !m_cubeMap && !m_array) {
+        if (auto&& bindlessTable = m_descriptorManager->GetBindlessTable()) {
+            m_bindlessIndex = bindlessTable->Register(m_descriptor);
+        }
+    }
+
+    return true;
+}
+
+bool EvoVulkan::Types::Texture::EnableRelocation() {
+    /// линейные изображения для чтения с CPU могут быть отображены снаружи, их не переносим
+    if (m_cpuUsage || m_isDestroyed || !m_image.Valid()) {
+        VK_ERROR("Texture::EnableRelocation() : texture can't be relocated!");
+        return false;
+    }
+
+    /// без менеджера сеты из кэша не переписываются, старое вью уничтожится у них из-под ног
+    if (!m_descriptorManager && !HasRelocationListeners()) {
+        VK_ERROR("Texture::EnableRelocation() : texture has neither descriptor manager nor relocation listeners!");
+        return false;
+    }
+
+    m_allocator->SetRelocatable(m_image, this);
+
+    return true;
+}
+
+VkImageViewType EvoVulkan::Types::Texture::GetViewType() const {
+    if (m_cubeMap)
+        return VK_IMAGE_VIEW_TYPE_CUBE;
+
+    if (m_array)
+        return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+
+    return VK_IMAGE_VIEW_TYPE_2D;
+}
+
+bool EvoVulkan::Types::Texture::BeginRelocation(VkCommandBuffer cmd, VmaAllocation dstAllocation) {
+    if (m_isDestroyed || !m_image.Valid()) {
+        return false;
+    }
+
+    if ((m_relocationImage = m_allocator->CreateRelocationImage(m_imageInfo, dstAllocation)) == VK_NULL_HANDLE) {
+        VK_ERROR("Texture::BeginRelocation() : failed to create relocation image!");
+        return false;
+    }
+
+    m_relocationView = Tools::CreateImageView(
+            *m_device,
+            m_relocationImage,
+            m_format,
+            m_mipLevels,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            GetViewType(),
+            m_layers);
+
+    if (m_relocationView == VK_NULL_HANDLE) {
+        VK_ERROR("Texture::BeginRelocation() : failed to create relocation image view!");
+        CancelRelocation();
+        return false;
+    }
+
+    const VkImageSubresourceRange subresourceRange = {
+            .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel   = 0,
+            .levelCount     = m_mipLevels,
+            .baseArrayLayer = 0,
+            .layerCount     = m_layers
+    };
+
+    Tools::Insert::ImageMemoryBarrier(
+            cmd,
+            m_image,
+            VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            m_imageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            subresourceRange);
+
+    Tools::Insert::ImageMemoryBarrier(
+            cmd,
+            m_relocationImage,
+            0, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+            subresourceRange);
+
+    std::vector<VkImageCopy> regions(m_mipLevels);
+
+    for (uint32_t level = 0; level < m_mipLevels; ++level) {
+        auto&& region = regions[level];
+
+        region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, m_layers };
+        region.dstSubresource = region.srcSubresource;
+        region.extent         = { EVK_MAX(m_width >> level, 1u), EVK_MAX(m_height >> level, 1u), 1 };
+    }
+
+    vkCmdCopyImage(cmd,
+            m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            m_relocationImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>(regions.size()), regions.data());
+
+    /// старое изображение возвращается в прежний layout на случай отмены перемещения
+    Tools::Insert::ImageMemoryBarrier(
+            cmd,
+            m_image,
+            VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_imageLayout,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            subresourceRange);
+
+    Tools::Insert::ImageMemoryBarrier(
+            cmd,
+            m_relocationImage,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_imageLayout,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+            subresourceRange);
+
     return true;
 }
 
+void EvoVulkan::Types::Texture::EndRelocation() {
+    if (m_relocationImage == VK_NULL_HANDLE) {
+        return;
+    }
+
+    const VkImageView oldView = std::exchange(m_view, std::exchange(m_relocationView, VK_NULL_HANDLE));
+    m_descriptor.imageView = m_view;
+
+    if (m_descriptorManager) {
+        if (m_bindlessIndex != Core::BindlessTextureTable::InvalidIndex) {
+            if (auto&& bindlessTable = m_descriptorManager->GetBindlessTable()) {
+                bindlessTable->Update(m_bindlessIndex, m_descriptor);
+            }
+        }
+
+        /// сеты остаются теми же, у владельцев ничего не меняется
+        m_descriptorManager->GetDescriptorCache()->Relocate(reinterpret_cast<uint64_t>(oldView), reinterpret_cast<uint64_t>(m_view));
+    }
+
+    NotifyRelocation(reinterpret_cast<uint64_t>(oldView), reinterpret_cast<uint64_t>(m_view));
+
+    /// старое вью ссылается на старое изображение, поэтому уничтожается первым
+    vkDestroyImageView(*m_device, oldView, Memory::GetAllocationCallbacks());
+
+    m_allocator->ReplaceImage(m_image, m_relocationImage);
+    m_relocationImage = VK_NULL_HANDLE;
+}
+
+void EvoVulkan::Types::Texture::CancelRelocation() {
+    if (m_relocationView != VK_NULL_HANDLE) {
+        vkDestroyImageView(*m_device, m_relocationView, Memory::GetAllocationCallbacks());
+        m_relocationView = VK_NULL_HANDLE;
+    }
+
+    if (m_relocationImage != VK_NULL_HANDLE) {
+        m_allocator->DestroyRelocationImage(m_relocationImage);
+        m_relocationImage = VK_NULL_HANDLE;
+    }
+}
+
 bool EvoVulkan::Types::Texture::GenerateMipmaps(
     EvoVulkan::Types::Texture *texture,
     EvoVulkan::Types::CmdBuffer *singleBuffer)
@@ -357,7 +661,7 @@ bool EvoVulkan::Types::Texture::GenerateMipmaps(
             .baseMipLevel   = 0, // default
             .levelCount     = 1,
             .baseArrayLayer = 0,
-            .layerCount     = 1
+            .layerCount     = texture->m_layers
     };
 
     for (uint32_t i = 1; i < texture->m_mipLevels; i++) {
@@ -378,13 +682,13 @@ bool EvoVulkan::Types::Texture::GenerateMipmaps(
             blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             blit.srcSubresource.mipLevel = i - 1;
             blit.srcSubresource.baseArrayLayer = 0;
-            blit.srcSubresource.layerCount = 1;
+            blit.srcSubresource.layerCount = texture->m_layers;
             blit.dstOffsets[0] = {0, 0, 0};
             blit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
             blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             blit.dstSubresource.mipLevel = i;
             blit.dstSubresource.baseArrayLayer = 0;
-            blit.dstSubresource.layerCount = 1;
+            blit.dstSubresource.layerCount = texture->m_layers;
 
             vkCmdBlitImage(*singleBuffer,
                            texture->m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -425,42 +729,57 @@ EvoVulkan::Types::DescriptorSet EvoVulkan::Types::Texture::GetDescriptorSet(VkDe
         return Types::DescriptorSet();
     }
 
-    if (m_descriptorSet == VK_NULL_HANDLE) {
-        static const std::set<VkDescriptorType> type = {
-                VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
-        };
-
-        m_descriptorSet = m_descriptorManager->AllocateDescriptorSet(layout, type);
+    if (auto&& setIt = m_descriptorSets.find(layout); setIt != m_descriptorSets.end()) {
+        return setIt->second;
+    }
 
-        auto writer = EvoVulkan::Tools::Initializers::WriteDescriptorSet(
-                m_descriptorSet,
-                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                0, this->GetDescriptorRef());
+    Core::DescriptorWrites writes;
+    writes.AddImage(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_descriptor);
 
-        vkUpdateDescriptorSets(*m_device, 1, &writer, 0, nullptr);
+    /// одинаковые текстуры с одинаковым лейаутом получат один и тот же сет
+    auto&& descriptorSet = m_descriptorManager->GetDescriptorCache()->Acquire(layout, writes);
+    if (descriptorSet.Valid()) {
+        m_descriptorSets[layout] = descriptorSet;
     }
 
-    return m_descriptorSet;
+    return descriptorSet;
 }
 
 void EvoVulkan::Types::Texture::Destroy()  {
     m_isDestroyed = true;
 
-    if (m_descriptorManager && (m_descriptorSet != VK_NULL_HANDLE)) {
-        m_descriptorManager->FreeDescriptorSet(&m_descriptorSet);
-        m_descriptorManager = nullptr;
+    if (m_descriptorManager && m_bindlessIndex != Core::BindlessTextureTable::InvalidIndex) {
+        if (auto&& bindlessTable = m_descriptorManager->GetBindlessTable()) {
+            bindlessTable->Unregister(m_bindlessIndex);
+        }
+        m_bindlessIndex = Core::BindlessTextureTable::InvalidIndex;
+    }
+
+    if (m_descriptorManager) {
+        auto&& cache = m_descriptorManager->GetDescriptorCache();
+
+        for (auto&& [layout, descriptorSet] : m_descriptorSets) {
+            cache->Release(descriptorSet);
+        }
+
+        /// неиспользуемые сеты из кэша все еще ссылаются на вью, выкидываем их до ее уничтожения
+        if (m_view != VK_NULL_HANDLE) {
+            cache->Evict(reinterpret_cast<uint64_t>(m_view));
+        }
+
+        if (!m_descriptorSets.empty()) {
+            m_descriptorSets.clear();
+            m_descriptorManager = nullptr;
+        }
     }
 
     if (!m_canBeDestroyed)
         return;
 
-    if (m_sampler != VK_NULL_HANDLE) {
-        vkDestroySampler(*m_device, m_sampler, nullptr);
-        m_sampler = VK_NULL_HANDLE;
-    }
+    Tools::DestroySampler(m_device, &m_sampler);
 
     if (m_view != VK_NULL_HANDLE) {
-        vkDestroyImageView(*m_device, m_view, nullptr);
+        vkDestroyImageView(*m_device, m_view, Memory::GetAllocationCallbacks());
         m_view = VK_NULL_HANDLE;
     }
 
@@ -468,6 +787,26 @@ void EvoVulkan::Types::Texture::Destroy()  {
         m_allocator->FreeImage(m_image);
 }
 
+uint32_t EvoVulkan::Types::Texture::GetSupportedMipLevels(const Device* device, VkFormat format, uint32_t mipLevels) {
+    if (mipLevels <= 1)
+        return 1;
+
+    /// сжатые форматы (BC6H и т.д.) нельзя блитить, мипы для них надо подготавливать заранее
+    if (Tools::IsBlockCompressedFormat(format)) {
+        VK_WARN("Texture::GetSupportedMipLevels() : mip maps can not be generated for compressed format! "
+                "Format: " + Tools::Convert::format_to_string(format));
+        return 1;
+    }
+
+    if (!device->IsSupportLinearBlitting(format)) {
+        VK_WARN("Texture::GetSupportedMipLevels() : device does not support linear blitting! "
+                "Format: " + Tools::Convert::format_to_string(format));
+        return 1;
+    }
+
+    return mipLevels;
+}
+
 void EvoVulkan::Types::Texture::RandomizeSeed() {
     m_seed = rand() % 10000;
 }
@@ -0,0 +1,190 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/Types/TrackedUniformBuffer.h>
+#include <EvoVulkan/Types/VulkanBuffer.h>
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Types {
+    TrackedUniformBuffer* TrackedUniformBuffer::Create(Device* device, Memory::Allocator* allocator, VkDeviceSize size) {
+        if (!device || !allocator || size == 0) {
+            VK_ERROR("TrackedUniformBuffer::Create() : invalid arguments!");
+            return nullptr;
+        }
+
+        auto&& uniformBuffer = new TrackedUniformBuffer();
+
+        uniformBuffer->m_device   = device;
+        uniformBuffer->m_atomSize = EVK_MAX(device->GetNonCoherentAtomSize(), static_cast<VkDeviceSize>(1));
+
+        /// VMA выравнивает non-coherent аллокации по nonCoherentAtomSize, а кратный размер позволяет
+        /// округлять конец диапазона вверх, не выходя за пределы своей аллокации
+        const VkDeviceSize alignedSize = (size + uniformBuffer->m_atomSize - 1) / uniformBuffer->m_atomSize * uniformBuffer->m_atomSize;
+
+        /// отображенная память только пишется, сравнение идет с теневой копией, так что подходит и видеопамять через BAR.
+        /// Грязные диапазоны сбрасываются в Flush, поэтому coherent память не обязательна
+        uniformBuffer->m_buffer = Buffer::CreateHostWritable(
+                device,
+                allocator,
+                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                alignedSize,
+                nullptr,
+                Memory::MemoryPool::Uniforms,
+                false /** coherent */);
+
+        if (!uniformBuffer->m_buffer) {
+            VK_ERROR("TrackedUniformBuffer::Create() : failed to create uniform buffer!");
+            delete uniformBuffer;
+            return nullptr;
+        }
+
+        uniformBuffer->m_buffer->SetupDescriptor(size);
+        uniformBuffer->m_mapped = static_cast<uint8_t*>(uniformBuffer->m_buffer->GetPersistentData());
+
+        VmaAllocationInfo allocationInfo = {};
+        vmaGetAllocationInfo(*allocator, uniformBuffer->m_buffer->GetAllocation(), &allocationInfo);
+
+        VkMemoryPropertyFlags memoryFlags = 0;
+        vmaGetAllocationMemoryProperties(*allocator, uniformBuffer->m_buffer->GetAllocation(), &memoryFlags);
+
+        uniformBuffer->m_memory   = allocationInfo.deviceMemory;
+        uniformBuffer->m_offset   = allocationInfo.offset;
+        uniformBuffer->m_coherent = (memoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+        /// теневая копия и память начинаются с нулей, поэтому первая запись ненулевых данных всегда дойдет до GPU
+        uniformBuffer->m_shadow.resize(size, 0);
+        memset(uniformBuffer->m_mapped, 0, size);
+        uniformBuffer->MarkDirty(0, size);
+
+        return uniformBuffer;
+    }
+
+    TrackedUniformBuffer::operator VkBuffer() const {
+        return m_buffer ? static_cast<VkBuffer>(*m_buffer) : VK_NULL_HANDLE;
+    }
+
+    bool TrackedUniformBuffer::Write(const void* data, VkDeviceSize size, VkDeviceSize offset) {
+        if (!data || offset + size > m_shadow.size()) {
+            VK_ERROR("TrackedUniformBuffer::Write() : write out of range! Offset: " + std::to_string(offset) +
+                     ", size: " + std::to_string(size) + ", buffer size: " + std::to_string(m_shadow.size()));
+            return false;
+        }
+
+        auto&& source = static_cast<const uint8_t*>(data);
+        auto&& shadow = m_shadow.data() + offset;
+
+        /// ищем первый и последний изменившиеся байты, все между ними копируется одним memcpy
+        VkDeviceSize first = 0;
+        while (first < size && source[first] == shadow[first])
+            ++first;
+
+        if (first == size)
+            return false;
+
+        VkDeviceSize last = size - 1;
+        while (last > first && source[last] == shadow[last])
+            --last;
+
+        const VkDeviceSize changed = last - first + 1;
+
+        memcpy(shadow + first, source + first, changed);
+        memcpy(m_mapped + offset + first, source + first, changed);
+
+        MarkDirty(offset + first, changed);
+
+        return true;
+    }
+
+    void TrackedUniformBuffer::MarkDirty(VkDeviceSize offset, VkDeviceSize size) {
+        m_dirty.emplace_back(Range { offset, size });
+    }
+
+    void TrackedUniformBuffer::CollectRanges(std::vector<VkMappedMemoryRange>& ranges) const {
+        if (m_dirty.empty())
+            return;
+
+        std::vector<Range> aligned;
+        aligned.reserve(m_dirty.size());
+
+        for (auto&& range : m_dirty) {
+            const VkDeviceSize begin = range.m_offset / m_atomSize * m_atomSize;
+            const VkDeviceSize end   = (range.m_offset + range.m_size + m_atomSize - 1) / m_atomSize * m_atomSize;
+            aligned.emplace_back(Range { begin, end - begin });
+        }
+
+        std::sort(aligned.begin(), aligned.end(), [](const Range& left, const Range& right) {
+            return left.m_offset < right.m_offset;
+        });
+
+        /// соседние и пересекающиеся после выравнивания диапазоны сливаются в один
+        Range current = aligned.front();
+        for (size_t i = 1; i < aligned.size(); ++i) {
+            auto&& range = aligned[i];
+
+            if (range.m_offset <= current.m_offset + current.m_size) {
+                current.m_size = EVK_MAX(current.m_size, range.m_offset + range.m_size - current.m_offset);
+                continue;
+            }
+
+            ranges.emplace_back(VkMappedMemoryRange { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory, m_offset + current.m_offset, current.m_size });
+            current = range;
+        }
+
+        ranges.emplace_back(VkMappedMemoryRange { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory, m_offset + current.m_offset, current.m_size });
+    }
+
+    VkResult TrackedUniformBuffer::Flush() {
+        return Flush(m_device, { this });
+    }
+
+    VkResult TrackedUniformBuffer::Flush(const Device* device, const std::vector<TrackedUniformBuffer*>& buffers) {
+        std::vector<VkMappedMemoryRange> ranges;
+
+        for (auto&& buffer : buffers) {
+            if (!buffer)
+                continue;
+
+            if (!buffer->m_coherent)
+                buffer->CollectRanges(ranges);
+
+            buffer->m_dirty.clear();
+        }
+
+        if (ranges.empty())
+            return VK_SUCCESS;
+
+        if (!device) {
+            VK_ERROR("TrackedUniformBuffer::Flush() : device is nullptr!");
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
+
+        const VkResult result = vkFlushMappedMemoryRanges(*device, static_cast<uint32_t>(ranges.size()), ranges.data());
+        if (result != VK_SUCCESS) {
+            VK_ERROR("TrackedUniformBuffer::Flush() : failed to flush mapped memory ranges!"
+                     "\n\tReason: " + Tools::Convert::result_to_string(result) +
+                     "\n\tDescription: " + Tools::Convert::result_to_description(result));
+        }
+
+        return result;
+    }
+
+    VkDescriptorBufferInfo* TrackedUniformBuffer::GetDescriptorRef() {
+        return m_buffer ? m_buffer->GetDescriptorRef() : nullptr;
+    }
+
+    void TrackedUniformBuffer::Destroy() {
+        EVSafeFreeObject(m_buffer);
+
+        m_mapped = nullptr;
+        m_memory = VK_NULL_HANDLE;
+
+        m_shadow.clear();
+        m_dirty.clear();
+    }
+
+    void TrackedUniformBuffer::Free() {
+        delete this;
+    }
+}
@@ -4,18 +4,39 @@
 
 #include <EvoVulkan/Memory/Allocator.h>
 #include <EvoVulkan/Types/VmaBuffer.h>
+#include <EvoVulkan/DescriptorCache.h>
 
 EvoVulkan::Types::VmaBuffer* EvoVulkan::Types::VmaBuffer::Create(
         EvoVulkan::Memory::Allocator* allocator,
         VkBufferUsageFlags bufferUsage,
         VmaMemoryUsage memoryUsage,
         VkDeviceSize size,
-        void* data)
+        void* data,
+        bool persistentMapped,
+        Memory::MemoryPool pool)
 {
     auto buffer = new VmaBuffer(allocator, size);
+
+    /// staging буферы живут недолго, а на отображенную память могут ссылаться снаружи, такие буферы не переносятся.
+    /// Остальным заранее добавляется копирование, сам перенос включается через EnableRelocation
+    const bool relocatable = pool != Memory::MemoryPool::Staging && !persistentMapped;
+    if (relocatable) {
+        bufferUsage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    }
+
+    buffer->m_usage = bufferUsage;
+
     auto bufferCreateInfo = Tools::Initializers::BufferCreateInfo(bufferUsage, size);
 
-    buffer->m_buffer = allocator->AllocBuffer(bufferCreateInfo, memoryUsage);
+    buffer->m_buffer = allocator->AllocBuffer(bufferCreateInfo, memoryUsage, persistentMapped ? VMA_ALLOCATION_CREATE_MAPPED_BIT : 0, pool);
+
+    if ((buffer->m_persistentMapped = (buffer->m_buffer.m_mapped != nullptr))) {
+        buffer->m_mapped = buffer->m_buffer.m_mapped;
+    }
+    else if (persistentMapped) {
+        /// память не отображается постоянно (например, не HOST_VISIBLE), дальше работаем через Map/Unmap
+        VK_WARN("VmaBuffer::Create() : failed to persistently map buffer, falling back to Map/Unmap! Size: " + std::to_string(size));
+    }
 
     if (data)
         buffer->CopyToDevice(data, memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY);
@@ -26,10 +47,13 @@ EvoVulkan::Types::VmaBuffer* EvoVulkan::Types::VmaBuffer::Create(
 }
 
 EvoVulkan::Types::VmaBuffer* EvoVulkan::Types::VmaBuffer::Create(EvoVulkan::Memory::Allocator* allocator, VkDeviceSize size, void* data) {
-    return Create(allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, size, data);
+    return Create(allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY, size, data, false, Memory::MemoryPool::Staging);
 }
 
 void EvoVulkan::Types::VmaBuffer::Destroy() {
+    m_persistentMapped = false;
+    m_mapped = nullptr;
+
     m_allocator->FreeBuffer(m_buffer);
 }
 
@@ -43,6 +67,13 @@ EvoVulkan::Types::VmaBuffer::VmaBuffer(EvoVulkan::Memory::Allocator *allocator,
 { }
 
 void EvoVulkan::Types::VmaBuffer::CopyToDevice(void *data, bool flush) {
+    if (m_persistentMapped) {
+        memcpy(m_mapped, data, m_size);
+        if (flush)
+            Flush(m_size);
+        return;
+    }
+
     Map();
     memcpy(m_mapped, data, m_size);
     if (flush)
@@ -55,6 +86,10 @@ VkResult EvoVulkan::Types::VmaBuffer::Map() {
         return VkResult::VK_INCOMPLETE;
     }
 
+    if (m_persistentMapped) {
+        return VK_SUCCESS;
+    }
+
     return vmaMapMemory(*m_allocator, m_buffer.m_allocation, &m_mapped);
 }
 
@@ -72,14 +107,18 @@ void *EvoVulkan::Types::VmaBuffer::MapData() {
 }
 
 void EvoVulkan::Types::VmaBuffer::Unmap() {
-    if (m_mapped) {
+    if (m_mapped && !m_persistentMapped) {
         vmaUnmapMemory(*m_allocator, m_buffer.m_allocation);
         m_mapped = nullptr;
     }
 }
 
-VkResult EvoVulkan::Types::VmaBuffer::Flush() {
-    return vmaFlushAllocation(*m_allocator, m_buffer.m_allocation, 0, m_size);
+VkResult EvoVulkan::Types::VmaBuffer::Flush(VkDeviceSize size, VkDeviceSize offset) {
+    return vmaFlushAllocation(*m_allocator, m_buffer.m_allocation, offset, size);
+}
+
+VkResult EvoVulkan::Types::VmaBuffer::Invalidate(VkDeviceSize size, VkDeviceSize offset) {
+    return vmaInvalidateAllocation(*m_allocator, m_buffer.m_allocation, offset, size);
 }
 
 void EvoVulkan::Types::VmaBuffer::SetupDescriptor(VkDeviceSize offset) {
@@ -92,8 +131,63 @@ VkResult EvoVulkan::Types::VmaBuffer::Bind() {
     return vmaBindBufferMemory(*m_allocator, m_buffer.m_allocation, m_buffer.m_buffer);
 }
 
+bool EvoVulkan::Types::VmaBuffer::EnableRelocation(Core::DescriptorCache* cache) {
+    const VkBufferUsageFlags transferUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    if (m_persistentMapped || m_buffer.m_allocation == VK_NULL_HANDLE || (m_usage & transferUsage) != transferUsage) {
+        VK_ERROR("VmaBuffer::EnableRelocation() : buffer can't be relocated!");
+        return false;
+    }
+
+    m_descriptorCache = cache;
+    m_allocator->SetRelocatable(m_buffer, this);
+
+    return true;
+}
+
+bool EvoVulkan::Types::VmaBuffer::BeginRelocation(VkCommandBuffer cmd, VmaAllocation dstAllocation) {
+    /// отображенный в данный момент буфер пишется с CPU, переносить его нельзя
+    if (m_mapped || m_buffer.m_buffer == VK_NULL_HANDLE) {
+        return false;
+    }
 
+    auto bufferCreateInfo = Tools::Initializers::BufferCreateInfo(m_usage, m_size);
 
+    if ((m_relocationBuffer = m_allocator->CreateRelocationBuffer(bufferCreateInfo, dstAllocation)) == VK_NULL_HANDLE) {
+        VK_ERROR("VmaBuffer::BeginRelocation() : failed to create relocation buffer!");
+        return false;
+    }
 
+    const VkBufferCopy region = { 0, 0, m_size };
+    vkCmdCopyBuffer(cmd, m_buffer.m_buffer, m_relocationBuffer, 1, &region);
+
+    return true;
+}
+
+void EvoVulkan::Types::VmaBuffer::EndRelocation() {
+    if (m_relocationBuffer == VK_NULL_HANDLE) {
+        return;
+    }
 
+    const auto oldBuffer = reinterpret_cast<uint64_t>(m_buffer.m_buffer);
+    const auto newBuffer = reinterpret_cast<uint64_t>(m_relocationBuffer);
 
+    m_descriptor.buffer = m_relocationBuffer;
+
+    /// старый буфер еще жив, сеты переписываются до его уничтожения
+    if (m_descriptorCache) {
+        m_descriptorCache->Relocate(oldBuffer, newBuffer);
+    }
+
+    NotifyRelocation(oldBuffer, newBuffer);
+
+    m_allocator->ReplaceBuffer(m_buffer, m_relocationBuffer);
+    m_relocationBuffer = VK_NULL_HANDLE;
+}
+
+void EvoVulkan::Types::VmaBuffer::CancelRelocation() {
+    if (m_relocationBuffer != VK_NULL_HANDLE) {
+        m_allocator->DestroyRelocationBuffer(m_relocationBuffer);
+        m_relocationBuffer = VK_NULL_HANDLE;
+    }
+}
@@ -18,31 +18,36 @@ namespace EvoVulkan::Types {
     *
     * @return VkResult of the buffer mapping call
     */
-    VkResult Buffer::Map(VkDeviceSize size, VkDeviceSize offset) {
-        return vkMapMemory(*m_device, m_memory, offset, size, 0, &m_mapped);
+    VkResult Buffer::Map(VkDeviceSize /* size */, VkDeviceSize offset) {
+        if (m_persistentData) {
+            m_mapped = static_cast<uint8_t*>(m_persistentData) + offset;
+            return VK_SUCCESS;
+        }
+
+        /// VMA отображает аллокацию целиком, поэтому смещение применяется к указателю
+        void* mapped = nullptr;
+        auto result = vmaMapMemory(*m_allocator, m_allocation, &mapped);
+        if (result == VK_SUCCESS)
+            m_mapped = static_cast<uint8_t*>(mapped) + offset;
+
+        return result;
     }
 
     /**
     * Unmap a mapped memory range
     *
-    * @note Does not return a result as vkUnmapMemory can't fail
+    * @note Does not return a result as vkUnmapMemory can't fail. Persistently mapped buffers stay mapped
     */
     void Buffer::Unmap() {
-        if (m_mapped) {
-            vkUnmapMemory(*m_device, m_memory);
+        if (m_persistentData) {
             m_mapped = nullptr;
+            return;
         }
-    }
 
-    /**
-    * Attach the allocated memory block to the buffer
-    *
-    * @param offset (Optional) Byte offset (from the beginning) for the memory region to bind
-    *
-    * @return VkResult of the bindBufferMemory call
-    */
-    VkResult Buffer::Bind(VkDeviceSize offset) const {
-        return vkBindBufferMemory(*m_device, m_buffer, m_memory, offset);
+        if (m_mapped) {
+            vmaUnmapMemory(*m_allocator, m_allocation);
+            m_mapped = nullptr;
+        }
     }
 
     /**
@@ -71,11 +76,29 @@ namespace EvoVulkan::Types {
     }
 
     void Buffer::CopyToDevice(void *data, VkDeviceSize size) const {
-        vkMapMemory(*m_device, m_memory, 0, size, 0, (void **)&m_mapped);
-        memcpy(m_mapped, data, size);
+        if (m_persistentData) {
+            memcpy(m_persistentData, data, size);
+
+            if ((m_memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+                Flush(size);
+
+            return;
+        }
+
+        void* mapped = nullptr;
+        if (vmaMapMemory(*m_allocator, m_allocation, &mapped) != VK_SUCCESS) {
+            VK_ERROR("Buffer::CopyToDevice() : failed to map memory!");
+            return;
+        }
+
+        memcpy(mapped, data, size);
+
+        // Note: VMA skips the flush for host coherent memory types
+        if ((m_memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+            vmaFlushAllocation(*m_allocator, m_allocation, 0, size);
+
         // Unmap after data has been copied
-        // Note: Since we requested a host coherent memory type for the uniform buffer, the write is instantly visible to the GPU
-        vkUnmapMemory(*m_device, m_memory);
+        vmaUnmapMemory(*m_allocator, m_allocation);
     }
 
     /**
@@ -89,12 +112,8 @@ namespace EvoVulkan::Types {
     * @return VkResult of the flush call
     */
     VkResult Buffer::Flush(VkDeviceSize size, VkDeviceSize offset) const {
-        VkMappedMemoryRange mappedRange = {};
-        mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        mappedRange.memory = m_memory;
-        mappedRange.offset = offset;
-        mappedRange.size = size;
-        return vkFlushMappedMemoryRanges(*m_device, 1, &mappedRange);
+        /// смещение задается относительно аллокации, VMA сам переводит его в смещение блока и выравнивает по nonCoherentAtomSize
+        return vmaFlushAllocation(*m_allocator, m_allocation, offset, size);
     }
 
     /**
@@ -108,25 +127,24 @@ namespace EvoVulkan::Types {
     * @return VkResult of the invalidate call
     */
     VkResult Buffer::Invalidate(VkDeviceSize size, VkDeviceSize offset) const {
-        VkMappedMemoryRange mappedRange = {};
-        mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-        mappedRange.memory = m_memory;
-        mappedRange.offset = offset;
-        mappedRange.size = size;
-        return vkInvalidateMappedMemoryRanges(*m_device, 1, &mappedRange);
+        return vmaInvalidateAllocation(*m_allocator, m_allocation, offset, size);
     }
 
     /**
     * Release all Vulkan resources held by this buffer
     */
     void Buffer::Destroy() {
-        if (m_buffer)
-            vkDestroyBuffer(*m_device, m_buffer, nullptr);
+        Unmap();
+
+        m_persistentData = nullptr;
 
-        m_buffer = VK_NULL_HANDLE;
+        if (m_buffer || m_allocation) {
+            Memory::Buffer memory = { m_buffer, m_allocation };
+            m_allocator->FreeBuffer(memory);
+        }
 
-        if (m_memory.Ready())
-            m_allocator->FreeMemory(&m_memory);
+        m_buffer     = VK_NULL_HANDLE;
+        m_allocation = VK_NULL_HANDLE;
     }
 
     Buffer* Buffer::Create(
@@ -134,44 +152,79 @@ namespace EvoVulkan::Types {
             Memory::Allocator* allocator,
             VkBufferUsageFlags usageFlags,
             VkMemoryPropertyFlags memoryPropertyFlags,
-            VkDeviceSize size, void* data)
+            VkDeviceSize size, void* data,
+            bool persistentMapped,
+            Memory::MemoryPool pool)
     {
         if (size == 0) {
             VK_ERROR("Buffer::Create() : incorrect buffer size!");
             return nullptr;
         }
 
+        // Create the buffer handle and sub-allocate its memory from a shared VMA block
+        VkBufferCreateInfo bufferCreateInfo = Tools::Initializers::BufferCreateInfo(usageFlags, size);
+        auto&& memory = allocator->AllocBuffer(bufferCreateInfo, memoryPropertyFlags, persistentMapped ? VMA_ALLOCATION_CREATE_MAPPED_BIT : 0, pool);
+        if (memory.m_buffer == VK_NULL_HANDLE || memory.m_allocation == VK_NULL_HANDLE) {
+            VK_ERROR("Buffer::Create() : failed to allocate vulkan buffer!");
+            return nullptr;
+        }
+
+        if (persistentMapped && !memory.m_mapped) {
+            VK_ERROR("Buffer::Create() : failed to persistently map buffer! Memory must be host visible.");
+            allocator->FreeBuffer(memory);
+            return nullptr;
+        }
+
+        return Create(device, allocator, memory, usageFlags, memoryPropertyFlags, size, data);
+    }
+
+    Buffer* Buffer::CreateHostWritable(
+            Device* device,
+            Memory::Allocator* allocator,
+            VkBufferUsageFlags usageFlags,
+            VkDeviceSize size, void* data,
+            Memory::MemoryPool pool,
+            bool coherent)
+    {
+        if (size == 0) {
+            VK_ERROR("Buffer::CreateHostWritable() : incorrect buffer size!");
+            return nullptr;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo = Tools::Initializers::BufferCreateInfo(usageFlags, size);
+        auto&& memory = allocator->AllocHostWritableBuffer(bufferCreateInfo, pool, coherent);
+        if (memory.m_buffer == VK_NULL_HANDLE || memory.m_allocation == VK_NULL_HANDLE || !memory.m_mapped) {
+            VK_ERROR("Buffer::CreateHostWritable() : failed to allocate vulkan buffer!");
+            if (memory.m_allocation)
+                allocator->FreeBuffer(memory);
+            return nullptr;
+        }
+
+        /// тип памяти выбирает аллокатор, поэтому флаги берем у готовой аллокации
+        VkMemoryPropertyFlags memoryPropertyFlags = 0;
+        vmaGetAllocationMemoryProperties(*allocator, memory.m_allocation, &memoryPropertyFlags);
+
+        return Create(device, allocator, memory, usageFlags, memoryPropertyFlags, size, data);
+    }
+
+    Buffer* Buffer::Create(
+            Device* device,
+            Memory::Allocator* allocator,
+            const Memory::Buffer& memory,
+            VkBufferUsageFlags usageFlags,
+            VkMemoryPropertyFlags memoryPropertyFlags,
+            VkDeviceSize size, void* data)
+    {
         auto* buffer = new Buffer();
         buffer->m_device = device;
         buffer->m_allocator = allocator;
 
-        // Create the buffer handle
-        VkBufferCreateInfo bufferCreateInfo = Tools::Initializers::BufferCreateInfo(usageFlags, size);
-        auto result = vkCreateBuffer(*device, &bufferCreateInfo, nullptr, &buffer->m_buffer);
-        if (result != VK_SUCCESS) {
-            VK_ERROR("Buffer::Create() : failed to create vulkan buffer!");
-            return {};
-        }
+        buffer->m_buffer         = memory.m_buffer;
+        buffer->m_allocation     = memory.m_allocation;
+        buffer->m_persistentData = memory.m_mapped;
 
-        // Create the memory backing up the buffer handle
         VkMemoryRequirements memReqs;
-        VkMemoryAllocateInfo memAlloc = Tools::Initializers::MemoryAllocateInfo();
         vkGetBufferMemoryRequirements(*device, buffer->m_buffer, &memReqs);
-        memAlloc.allocationSize = memReqs.size;
-        // Find a memory type index that fits the properties of the buffer
-        memAlloc.memoryTypeIndex = device->GetMemoryType(memReqs.memoryTypeBits, memoryPropertyFlags);
-        // If the buffer has VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT set we also need to enable the appropriate flag during allocation
-        VkMemoryAllocateFlagsInfoKHR allocFlagsInfo{};
-        if (usageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
-            allocFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
-            allocFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
-            memAlloc.pNext = &allocFlagsInfo;
-        }
-
-        if (!(buffer->m_memory = allocator->AllocateMemory(memAlloc)).Ready()) {
-            VK_ERROR("Buffer::Create() : failed to allocate vulkan memory!");
-            return { };
-        }
 
         buffer->m_alignment = memReqs.alignment;
         buffer->m_size = size;
@@ -180,10 +233,10 @@ namespace EvoVulkan::Types {
 
         // If a pointer to the buffer data has been passed, map the buffer and copy over the data
         if (data != nullptr) {
-            result = buffer->Map();
-            if (result != VK_SUCCESS) {
+            if (buffer->Map() != VK_SUCCESS) {
                 VK_ERROR("Buffer::Create() : failed to map buffer!");
-                return { };
+                EVSafeFreeObject(buffer);
+                return nullptr;
             }
 
             memcpy(buffer->m_mapped, data, size);
@@ -196,22 +249,22 @@ namespace EvoVulkan::Types {
         // Initialize a default descriptor that covers the whole buffer size
         buffer->SetupDescriptor(buffer->m_size);
 
-        if (buffer->Bind() != VK_SUCCESS) {
-            VK_ERROR("Buffer::Create() : failed to bind buffer!");
-            return {};
-        }
-
-        // Attach the memory to the buffer object
         return buffer;
     }
 
     Buffer *Buffer::Create(Device *device, Memory::Allocator* allocator, VkDeviceSize size, void *data) {
-        return Create(device, allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, size, data);
+        return Create(device, allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, size, data,
+                false, Memory::MemoryPool::Staging);
     }
 
     void *Buffer::MapData()  {
-        //void* data = nullptr;
-        if (vkMapMemory(*m_device, m_memory, 0, m_size, 0, &m_mapped) == VK_SUCCESS)
+        if (m_persistentData)
+            return m_mapped = m_persistentData;
+
+        if (m_mapped)
+            return m_mapped;
+
+        if (Map() == VK_SUCCESS)
             return m_mapped;
         else {
             VK_ERROR("Buffer::Map() : failed to map memory!");
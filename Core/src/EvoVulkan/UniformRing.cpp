@@ -0,0 +1,118 @@
+//
+// Created by Monika on 19.10.2026.
+//
+
+#include <EvoVulkan/UniformRing.h>
+#include <EvoVulkan/Types/Device.h>
+#include <EvoVulkan/Types/VulkanBuffer.h>
+#include <EvoVulkan/Tools/VulkanDebug.h>
+
+namespace EvoVulkan::Core {
+    UniformRing* UniformRing::Create(Types::Device* device, Memory::Allocator* allocator, uint32_t framesCount, VkDeviceSize frameSize) {
+        if (!device || !allocator || framesCount == 0 || frameSize == 0) {
+            VK_ERROR("UniformRing::Create() : invalid arguments!");
+            return nullptr;
+        }
+
+        const VkDeviceSize alignment = EVK_MAX(device->GetMinUniformBufferOffsetAlignment(), static_cast<VkDeviceSize>(1));
+
+        /// каждая часть начинается с выровненного смещения, иначе первый объект кадра нельзя будет привязать
+        frameSize = (frameSize + alignment - 1) / alignment * alignment;
+
+        /// динамические смещения 32-битные, кольцо целиком должно в них помещаться
+        if (frameSize * framesCount > static_cast<VkDeviceSize>(UINT32_MAX)) {
+            VK_ERROR("UniformRing::Create() : ring is too large for dynamic offsets! Size: " + std::to_string(frameSize * framesCount));
+            return nullptr;
+        }
+
+        auto&& ring = new UniformRing();
+
+        ring->m_alignment   = alignment;
+        ring->m_frameSize   = frameSize;
+        ring->m_framesCount = framesCount;
+
+        /// кольцо только пишется с CPU, поэтому при наличии ReBAR оно ложится прямо в видеопамять
+        ring->m_buffer = Types::Buffer::CreateHostWritable(
+                device,
+                allocator,
+                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                frameSize * framesCount,
+                nullptr,
+                Memory::MemoryPool::Uniforms);
+
+        if (!ring->m_buffer) {
+            VK_ERROR("UniformRing::Create() : failed to create uniform buffer!");
+            delete ring;
+            return nullptr;
+        }
+
+        if (!(ring->m_mapped = static_cast<uint8_t*>(ring->m_buffer->GetPersistentData()))) {
+            VK_ERROR("UniformRing::Create() : failed to map uniform buffer!");
+            EVSafeFreeObject(ring);
+            return nullptr;
+        }
+
+        return ring;
+    }
+
+    bool UniformRing::BeginFrame(uint32_t frameIndex) {
+        if (frameIndex >= m_framesCount) {
+            VK_ERROR("UniformRing::BeginFrame() : frame index out of range! Index: " + std::to_string(frameIndex));
+            return false;
+        }
+
+        m_frameOffset = m_frameSize * frameIndex;
+        m_head        = 0;
+
+        return true;
+    }
+
+    void* UniformRing::Allocate(VkDeviceSize size, uint32_t& dynamicOffset) {
+        const VkDeviceSize alignedSize = (size + m_alignment - 1) / m_alignment * m_alignment;
+
+        if (size == 0 || m_head + alignedSize > m_frameSize) {
+            VK_ERROR("UniformRing::Allocate() : frame is out of memory! Used: " + std::to_string(m_head) +
+                     ", requested: " + std::to_string(size) + ", frame size: " + std::to_string(m_frameSize));
+            return nullptr;
+        }
+
+        dynamicOffset = static_cast<uint32_t>(m_frameOffset + m_head);
+        m_head += alignedSize;
+
+        return m_mapped + dynamicOffset;
+    }
+
+    bool UniformRing::Push(const void* data, VkDeviceSize size, uint32_t& dynamicOffset) {
+        if (auto&& pData = Allocate(size, dynamicOffset)) {
+            memcpy(pData, data, size);
+            return true;
+        }
+
+        return false;
+    }
+
+    VkDescriptorBufferInfo UniformRing::GetDescriptor(VkDeviceSize range) const {
+        VkDescriptorBufferInfo descriptor = {};
+
+        descriptor.buffer = m_buffer ? static_cast<VkBuffer>(*m_buffer) : VK_NULL_HANDLE;
+        descriptor.offset = 0;
+        descriptor.range  = range;
+
+        return descriptor;
+    }
+
+    void UniformRing::Destroy() {
+        if (m_buffer) {
+            m_buffer->Unmap();
+            EVSafeFreeObject(m_buffer);
+        }
+
+        m_mapped      = nullptr;
+        m_frameOffset = 0;
+        m_head        = 0;
+    }
+
+    void UniformRing::Free() {
+        delete this;
+    }
+}
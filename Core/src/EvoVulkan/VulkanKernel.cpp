@@ -95,7 +95,8 @@ bool EvoVulkan::Core::VulkanKernel::Init(
             m_validationEnabled ? m_validationLayers : std::vector<const char*>(),
             enableSampleShading,
             m_multisampling,
-            m_sampleCount);
+            m_sampleCount,
+            m_descriptorBackend == DescriptorBackend::DescriptorBuffer);
     if (!m_device) {
         VK_ERROR("VulkanKernel::Init() : failed to create logical device!");
         return false;
@@ -112,7 +113,11 @@ bool EvoVulkan::Core::VulkanKernel::Init(
     //!=============================================[Create allocator]==================================================
 
     VK_LOG("VulkanKernel::Init() : create allocator...");
-    m_allocator = Memory::Allocator::Create(m_device);
+    m_allocator = Memory::Allocator::Create(m_device, m_allocatorThreading);
+    if (!m_allocator) {
+        VK_ERROR("VulkanKernel::Init() : failed to create allocator!");
+        return false;
+    }
 
     //!========================================[Create descriptor manager]==============================================
 
@@ -123,6 +128,18 @@ bool EvoVulkan::Core::VulkanKernel::Init(
         return false;
     }
 
+    if (m_descriptorBackend == DescriptorBackend::DescriptorBuffer) {
+        if (m_device->GetFeatures().m_descriptorBuffer) {
+            VK_LOG("VulkanKernel::Init() : create descriptor buffer...");
+            m_descriptorBuffer = Core::DescriptorBuffer::Create(m_device, m_allocator);
+        }
+
+        if (!m_descriptorBuffer) {
+            VK_WARN("VulkanKernel::Init() : descriptor buffer is unavailable, fall back to descriptor pools!");
+            m_descriptorBackend = DescriptorBackend::Pools;
+        }
+    }
+
     //!=============================================[Init surface]======================================================
 
     if (!m_surface->Init(m_device)) {
@@ -211,6 +228,36 @@ bool EvoVulkan::Core::VulkanKernel::PostInit() {
 
     //!=================================================================================================================
 
+    VK_GRAPH("VulkanKernel::PostInit() : create frame descriptor allocator...");
+    m_frameDescriptors = Core::FrameDescriptorAllocator::Create(m_device, this->m_countDCB);
+    if (!m_frameDescriptors) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create frame descriptor allocator!");
+        return false;
+    }
+
+    VK_GRAPH("VulkanKernel::PostInit() : create uniform ring...");
+    m_uniformRing = Core::UniformRing::Create(m_device, m_allocator, this->m_countDCB, m_uniformRingSize);
+    if (!m_uniformRing) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create uniform ring!");
+        return false;
+    }
+
+    VK_GRAPH("VulkanKernel::PostInit() : create defragmenter...");
+    m_defragmenter = Memory::Defragmenter::Create(m_device, m_allocator, m_cmdPool);
+    if (!m_defragmenter) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create defragmenter!");
+        return false;
+    }
+
+    VK_GRAPH("VulkanKernel::PostInit() : create aliasing pool...");
+    m_aliasingPool = Memory::AliasingPool::Create(m_device, m_allocator);
+    if (!m_aliasingPool) {
+        VK_ERROR("VulkanKernel::PostInit() : failed to create aliasing pool!");
+        return false;
+    }
+
+    //!=================================================================================================================
+
     VK_GRAPH("VulkanKernel::PostInit() : create multisample target...");
     this->m_multisample = Types::MultisampleTarget::Create(
             m_device,
@@ -279,6 +326,12 @@ bool EvoVulkan::Core::VulkanKernel::Destroy() {
         m_multisample->Free();
     }
 
+    EVSafeFreeObject(m_frameDescriptors);
+    EVSafeFreeObject(m_uniformRing);
+    EVSafeFreeObject(m_defragmenter);
+    EVSafeFreeObject(m_aliasingPool);
+    EVSafeFreeObject(m_descriptorBuffer);
+
     if (m_descriptorManager)
         this->m_descriptorManager->Free();
 
@@ -309,7 +362,7 @@ bool EvoVulkan::Core::VulkanKernel::Destroy() {
     EVSafeFreeObject(m_device);
 
     if (m_validationEnabled) {
-        Tools::DestroyDebugUtilsMessengerEXT(*m_instance, m_debugMessenger, nullptr);
+        Tools::DestroyDebugUtilsMessengerEXT(*m_instance, m_debugMessenger, Memory::GetAllocationCallbacks());
         this->m_debugMessenger = VK_NULL_HANDLE;
     }
 
@@ -331,7 +384,7 @@ bool EvoVulkan::Core::VulkanKernel::ReCreateFrameBuffers() {
     this->m_multisample->ReCreate(m_swapchain->GetSurfaceWidth(), m_swapchain->GetSurfaceHeight());
 
     for (auto & m_frameBuffer : m_frameBuffers)
-        vkDestroyFramebuffer(*m_device, m_frameBuffer, nullptr);
+        vkDestroyFramebuffer(*m_device, m_frameBuffer, Memory::GetAllocationCallbacks());
     m_frameBuffers.clear();
 
     std::vector<VkImageView> attachments = {};
@@ -363,7 +416,7 @@ bool EvoVulkan::Core::VulkanKernel::ReCreateFrameBuffers() {
 
         attachments[m_multisampling ? 1 : 0] = m_swapchain->GetBuffers()[i].m_view;
 
-        auto result = vkCreateFramebuffer(*m_device, &frameBufferCreateInfo, nullptr, &m_frameBuffers[i]);
+        auto result = vkCreateFramebuffer(*m_device, &frameBufferCreateInfo, Memory::GetAllocationCallbacks(), &m_frameBuffers[i]);
 
         if (result != VK_SUCCESS) {
             VK_ERROR("VulkanKernel::ReCreateFrameBuffers() : failed to create vulkan frame buffer! Reason: " +
@@ -377,7 +430,7 @@ bool EvoVulkan::Core::VulkanKernel::ReCreateFrameBuffers() {
 
 void EvoVulkan::Core::VulkanKernel::DestroyFrameBuffers() {
     for (auto & m_frameBuffer : m_frameBuffers)
-        vkDestroyFramebuffer(*m_device, m_frameBuffer, nullptr);
+        vkDestroyFramebuffer(*m_device, m_frameBuffer, Memory::GetAllocationCallbacks());
     m_frameBuffers.clear();
 }
 
@@ -415,6 +468,23 @@ EvoVulkan::Core::FrameResult EvoVulkan::Core::VulkanKernel::PrepareFrame() {
         return FrameResult::Error;
     }
 
+    /// SubmitFrame ждет простоя очереди, поэтому прошлый кадр с этим индексом уже отработал
+    if (m_frameDescriptors && !m_frameDescriptors->BeginFrame(m_currentBuffer)) {
+        VK_ERROR("VulkanKernel::PrepareFrame() : failed to reset frame descriptors!");
+        return FrameResult::Error;
+    }
+
+    if (m_uniformRing && !m_uniformRing->BeginFrame(m_currentBuffer)) {
+        VK_ERROR("VulkanKernel::PrepareFrame() : failed to begin uniform ring frame!");
+        return FrameResult::Error;
+    }
+
+    /// записанные командные буферы ссылаются на старые хендлы перенесенных ресурсов
+    if (m_defragmenter && m_defragmenter->Step() && !BuildCmdBuffers()) {
+        VK_ERROR("VulkanKernel::PrepareFrame() : failed to rebuild command buffers after defragmentation!");
+        return FrameResult::Error;
+    }
+
     return FrameResult::Success;
     //vkWaitForFences(*m_device, 1, &m_waitFences[m_currentBuffer], VK_TRUE, UINT64_MAX);
     //vkResetFences(*m_device, 1, &m_waitFences[m_currentBuffer]);
@@ -554,6 +624,33 @@ void EvoVulkan::Core::VulkanKernel::SetSwapchainImagesCount(uint32_t count) {
     m_swapchainImages = count;
 }
 
+void EvoVulkan::Core::VulkanKernel::SetDescriptorBackend(DescriptorBackend backend) {
+    if (m_isInitialized) {
+        VK_ERROR("VulkanKernel::SetDescriptorBackend() : kernel is already initialized!");
+        return;
+    }
+
+    m_descriptorBackend = backend;
+}
+
+void EvoVulkan::Core::VulkanKernel::SetUniformRingSize(VkDeviceSize frameSize) {
+    if (m_isInitialized) {
+        VK_ERROR("VulkanKernel::SetUniformRingSize() : kernel is already initialized!");
+        return;
+    }
+
+    m_uniformRingSize = frameSize;
+}
+
+void EvoVulkan::Core::VulkanKernel::SetAllocatorThreading(Memory::AllocatorThreading threading) {
+    if (m_isInitialized) {
+        VK_ERROR("VulkanKernel::SetAllocatorThreading() : kernel is already initialized!");
+        return;
+    }
+
+    m_allocatorThreading = threading;
+}
+
 void EvoVulkan::Core::VulkanKernel::SetGUIEnabled(bool enabled)
 {
     if ((m_GUIEnabled = enabled)) {
@@ -15,11 +15,13 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>
 
 #include <EvoVulkan/Types/Texture.h>
+#include <EvoVulkan/Types/TrackedUniformBuffer.h>
 
 #include <stbi.h>
 
@@ -33,6 +35,8 @@
 #include <EvoVulkan/Complexes/Mesh.h>
 #include <EvoVulkan/Complexes/Framebuffer.h>
 
+#include <EvoVulkan/DescriptorCache.h>
+
 #include <cmp_core.h>
 
 const std::string resources = "Z:/SREngine/Engine/Core/Dependences/Framework/Depends/EvoVulkan/Resources";
@@ -70,14 +74,17 @@ struct Vertex {
 };
 
 struct Mesh {
-    Core::DescriptorManager* m_descrManager  = nullptr;
-    Core::DescriptorSet      m_descriptorSet = {};
-
-    Types::Buffer*           m_uniformBuffer = nullptr;
-    Types::Buffer*           m_vertexBuffer  = nullptr;
-    Types::Buffer*           m_indexBuffer   = nullptr;
-    ModelUniformBuffer       m_ubo           = {};
-    uint64_t                 m_countIndices  = 0;
+    Core::DescriptorManager*     m_descrManager  = nullptr;
+    /// сет из DescriptorCache, одинаковые (лейаут, ресурсы) разделяют один сет
+    Types::DescriptorSet         m_descriptorSet = {};
+
+    Types::TrackedUniformBuffer* m_uniformBuffer = nullptr;
+    /// смещение данных меша в кольце текущего кадра, если биндинг 0 - UNIFORM_BUFFER_DYNAMIC
+    uint32_t                     m_dynamicOffset = UINT32_MAX;
+    Types::Buffer*               m_vertexBuffer  = nullptr;
+    Types::Buffer*               m_indexBuffer   = nullptr;
+    ModelUniformBuffer           m_ubo           = {};
+    uint64_t                     m_countIndices  = 0;
 
     void Draw(const VkCommandBuffer& cmd, const VkPipelineLayout& layout) const {
         if (!m_vertexBuffer || !m_indexBuffer) {
@@ -88,7 +95,9 @@ struct Mesh {
 
         VkBuffer vertexBuffer = *m_vertexBuffer;
 
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &m_descriptorSet.m_self, 0, NULL);
+        const uint32_t dynamicOffsetCount = m_dynamicOffset != UINT32_MAX ? 1 : 0;
+
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &m_descriptorSet.m_self, dynamicOffsetCount, &m_dynamicOffset);
         vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer, offsets);
         vkCmdBindIndexBuffer(cmd, *m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
@@ -101,13 +110,14 @@ struct Mesh {
         m_vertexBuffer = nullptr;
         m_indexBuffer  = nullptr;
 
-        if (m_descriptorSet.m_self != VK_NULL_HANDLE) {
-            m_descrManager->FreeDescriptorSet(m_descriptorSet);
+        if (m_descriptorSet.Valid()) {
+            m_descrManager->GetDescriptorCache()->Release(m_descriptorSet);
             m_descriptorSet.Reset();
         }
 
-        m_descrManager = nullptr;
-        m_countIndices = 0;
+        m_descrManager  = nullptr;
+        m_countIndices  = 0;
+        m_dynamicOffset = UINT32_MAX;
     }
 };
 
@@ -121,6 +131,8 @@ public:
     Complexes::Shader*          m_postProcessing      = nullptr;
     Core::DescriptorSet         m_PPDescriptorSet     = { };
     Types::Buffer*              m_PPUniformBuffer     = nullptr;
+    /// если устройство поддерживает inline uniform block, гамма лежит прямо в сете и буфер не создается
+    PPUniformBuffer             m_PPUniform           = { 2.2f };
 
     Types::Buffer*              m_planeVerticesBuff   = nullptr;
     Types::Buffer*              m_planeIndicesBuff    = nullptr;
@@ -143,6 +155,15 @@ public:
             return Core::RenderResult::Success;
         }
 
+        /// PrepareFrame переключил кольцо на часть этого кадра, поэтому данные мешей пишутся только теперь,
+        /// а offscreen буфер перезаписывается с новыми динамическими смещениями. Прошлый кадр уже отработал
+        UpdateUBO();
+
+        if (!BuildOffscreenCmd()) {
+            VK_ERROR("renderFunction() : failed to build offscreen command buffer!");
+            return Core::RenderResult::Fatal;
+        }
+
         m_submitInfo.commandBufferCount = 1;
 
         m_submitInfo.pWaitSemaphores    = &m_syncs.m_presentComplete;
@@ -243,7 +264,8 @@ public:
 
             _mesh.m_ubo = { model };
 
-            _mesh.m_uniformBuffer->CopyToDevice(&_mesh.m_ubo, sizeof(ModelUniformBuffer));
+            /// UNIFORM_BUFFER_DYNAMIC: все меши делят один сет, отличается только смещение в кольце
+            GetUniformRing()->Push(_mesh.m_ubo, _mesh.m_dynamicOffset);
         }
 
         SkyboxUniformBuffer ubo = {
@@ -252,7 +274,10 @@ public:
                 glm::vec3(x, y, z)
         };
 
-        skybox.m_uniformBuffer->CopyToDevice(&ubo, sizeof(SkyboxUniformBuffer));
+        skybox.m_uniformBuffer->Write(ubo);
+
+        /// если данные не изменились, flush ничего не делает
+        skybox.m_uniformBuffer->Flush();
     }
 
     void LoadSkybox() {
@@ -282,37 +307,35 @@ public:
                 m_device, m_allocator, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 vertices.size() * sizeof(VertexUV),
-                vertices.data());
+                vertices.data(),
+                false, Memory::MemoryPool::StaticMeshes);
 
         m_skyboxIndicesBuff = Types::Buffer::Create(
                 m_device, m_allocator, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 indices.size() * sizeof(uint32_t),
-                indices.data());
+                indices.data(),
+                false, Memory::MemoryPool::StaticMeshes);
 
-        skybox.m_descriptorSet = m_descriptorManager->AllocateDescriptorSets(m_skyboxShader->GetDescriptorSetLayout(), {
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
-        });
         skybox.m_countIndices = indices.size();
         skybox.m_vertexBuffer = m_skyboxVerticesBuff;
         skybox.m_indexBuffer  = m_skyboxIndicesBuff;
         skybox.m_descrManager = m_descriptorManager;
 
-        skybox.m_uniformBuffer = EvoVulkan::Types::Buffer::Create(
-                m_device,
-                m_allocator,
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-                sizeof(SkyboxUniformBuffer));
-
-        std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-                Tools::Initializers::WriteDescriptorSet(skybox.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0,
-                                                        skybox.m_uniformBuffer->GetDescriptorRef()),
-                Tools::Initializers::WriteDescriptorSet(skybox.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
-                                                        m_cubeMap->GetDescriptorRef()),
-        };
+        skybox.m_uniformBuffer = EvoVulkan::Types::TrackedUniformBuffer::Create(m_device, m_allocator, sizeof(SkyboxUniformBuffer));
+
+        Core::DescriptorWrites writes;
+        writes.AddBuffer(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, *skybox.m_uniformBuffer->GetDescriptorRef());
+        writes.AddImage(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, *m_cubeMap->GetDescriptorRef());
 
-        vkUpdateDescriptorSets(*m_device, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, NULL);
+        skybox.m_descriptorSet = m_descriptorManager->GetDescriptorCache()->Acquire(m_skyboxShader->GetDescriptorSetLayout(), writes);
+        if (!skybox.m_descriptorSet.Valid()) {
+            VK_ERROR("VulkanExample::LoadSkybox() : failed to acquire descriptor set!");
+            return;
+        }
+
+        /// все сеты с кубмапой получены из кэша менеджера, при переносе он перепишет их сам
+        m_cubeMap->EnableRelocation();
     }
 
     static int32_t Find4(int32_t i) {
@@ -364,6 +387,120 @@ public:
         return cmpBuffer;
     }
 
+    /// HDR-пиксели (RGBA32F) -> BC6H. BC6H кодирует только RGB в half float, альфа отбрасывается.
+    /// Размер округляется вверх до блоков 4x4, крайние блоки дополняются повтором последних текселей
+    static uint8_t* CompressBC6H(uint32_t w, uint32_t h, const float_t* pixels) {
+        const uint32_t blocksX = (w + 3) / 4;
+        const uint32_t blocksY = (h + 3) / 4;
+
+        auto* cmpBuffer = (uint8_t*)malloc(16 * blocksX * blocksY);
+        for (uint32_t row = 0; row < blocksY; row++) {
+            for (uint32_t col = 0; col < blocksX; col++) {
+                uint16_t block[4 * 4 * 3];
+
+                for (uint32_t y = 0; y < 4; ++y) {
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        const uint32_t srcX = EVK_MIN(col * 4 + x, w - 1);
+                        const uint32_t srcY = EVK_MIN(row * 4 + y, h - 1);
+                        const float_t* texel = pixels + (srcY * w + srcX) * 4;
+
+                        block[(y * 4 + x) * 3 + 0] = glm::packHalf1x16(texel[0]);
+                        block[(y * 4 + x) * 3 + 1] = glm::packHalf1x16(texel[1]);
+                        block[(y * 4 + x) * 3 + 2] = glm::packHalf1x16(texel[2]);
+                    }
+                }
+
+                CompressBlockBC6(
+                        block,                                  // source
+                        4 * 3,                                  // count shorts
+                        cmpBuffer + (row * blocksX + col) * 16  // dst
+                );
+            }
+        }
+
+        return cmpBuffer;
+    }
+
+    /// RGBA32F -> RGBA16F, если BC6H не поддерживается
+    static uint8_t* PackRGBA16F(uint32_t w, uint32_t h, const float_t* pixels) {
+        auto* halfs = (uint16_t*)malloc(w * h * 4 * sizeof(uint16_t));
+        for (uint32_t i = 0; i < w * h * 4; ++i)
+            halfs[i] = glm::packHalf1x16(pixels[i]);
+
+        return (uint8_t*)halfs;
+    }
+
+    /// RGBA32F -> B10G11R11: вдвое меньше RGBA16F, но без альфы и отрицательных значений
+    static uint8_t* PackB10G11R11(uint32_t w, uint32_t h, const float_t* pixels) {
+        auto* packed = (uint32_t*)malloc(w * h * sizeof(uint32_t));
+        for (uint32_t i = 0; i < w * h; ++i)
+            packed[i] = glm::packF2x11_1x10(glm::max(glm::vec3(pixels[i * 4 + 0], pixels[i * 4 + 1], pixels[i * 4 + 2]), glm::vec3(0.f)));
+
+        return (uint8_t*)packed;
+    }
+
+    bool IsSampledFormatSupported(VkFormat format) const {
+        VkFormatProperties formatProps;
+        vkGetPhysicalDeviceFormatProperties(*m_device, format, &formatProps);
+        return formatProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+    }
+
+    /// кубмапа в float формате: BC6H, если он не поддерживается - RGBA16F, затем B10G11R11
+    bool LoadHDRCubeMap() {
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        for (auto&& candidate : { VK_FORMAT_BC6H_UFLOAT_BLOCK, VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_B10G11R11_UFLOAT_PACK32 }) {
+            if (IsSampledFormatSupported(candidate)) {
+                format = candidate;
+                break;
+            }
+        }
+
+        if (format == VK_FORMAT_UNDEFINED) {
+            VK_WARN("Example::LoadHDRCubeMap() : device does not support HDR texture formats!");
+            return false;
+        }
+
+        /// отдельных .hdr файлов нет, LDR грани переводятся в float без гамма-коррекции, как и в 8-битной версии
+        stbi_ldr_to_hdr_gamma(1.f);
+
+        int w, h, channels;
+        std::array<float_t*, 6> sides {
+                stbi_loadf((resources + "/Skyboxes/Sea/front.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+                stbi_loadf((resources + "/Skyboxes/Sea/back.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+                stbi_loadf((resources + "/Skyboxes/Sea/top.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+                stbi_loadf((resources + "/Skyboxes/Sea/bottom.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+                stbi_loadf((resources + "/Skyboxes/Sea/right.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+                stbi_loadf((resources + "/Skyboxes/Sea/left.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
+        };
+
+        std::array<uint8_t*, 6> packed = { };
+        for (uint8_t i = 0; i < 6; ++i) {
+            if (!sides[i])
+                continue;
+
+            switch (format) {
+                case VK_FORMAT_BC6H_UFLOAT_BLOCK: packed[i] = CompressBC6H(w, h, sides[i]); break;
+                case VK_FORMAT_R16G16B16A16_SFLOAT: packed[i] = PackRGBA16F(w, h, sides[i]); break;
+                default: packed[i] = PackB10G11R11(w, h, sides[i]); break;
+            }
+        }
+
+        if (std::find(packed.begin(), packed.end(), nullptr) == packed.end())
+            m_cubeMap = Types::Texture::LoadCubeMap(m_device, m_allocator, m_descriptorManager, m_cmdPool, format, w, h, packed, 1);
+        else {
+            const char* reason = stbi_failure_reason();
+            VK_ERROR("Example::LoadHDRCubeMap() : failed to load cube map! Reason: " + std::string(reason ? reason : "unknown"));
+        }
+
+        for (auto&& img : sides)
+            stbi_image_free(img);
+
+        for (auto&& img : packed)
+            free(img);
+
+        return m_cubeMap;
+    }
+
     bool LoadCubeMap() {
         //-512x512
         int w, h, channels;
@@ -376,7 +513,7 @@ public:
                 stbi_load((resources + "/Skyboxes/Sea/bottom.jpg").c_str(), &w, &h, &channels, STBI_rgb_alpha),
         };
 
-        m_cubeMap = Types::Texture::LoadCubeMap(m_device, m_allocator, m_cmdPool, VK_FORMAT_R8G8B8A8_UNORM, w, h, sides, 1);
+        m_cubeMap = Types::Texture::LoadCubeMap(m_device, m_allocator, m_descriptorManager, m_cmdPool, VK_FORMAT_R8G8B8A8_UNORM, w, h, sides, 1);
 
         for (auto&& img : sides)
             stbi_image_free(img);
@@ -446,26 +583,17 @@ public:
         attach0.imageLayout = m_texture->m_imageLayout;	// The current layout of the image (Note: Should always fit the actual use, e.g. shader read)
         auto attach1 = attach0;*/
 
-        std::vector<VkWriteDescriptorSet> writeDescriptorSets1 = {
-                // Binding 0 : Fragment shader uniform buffer
-                Tools::Initializers::WriteDescriptorSet(m_PPDescriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0,
-                                                        m_PPUniformBuffer->GetDescriptorRef()),
-
-                // Binding 1: Fragment shader sampler
-                Tools::Initializers::WriteDescriptorSet(m_PPDescriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1,
-                                                        colors[0]->GetDescriptorRef()),
-
-        };
-
-        std::vector<VkWriteDescriptorSet> writeDescriptorSets2 = {
-                // Binding 2: Fragment shader sampler
-                Tools::Initializers::WriteDescriptorSet(m_PPDescriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2,
-                                                        colors[1]->GetDescriptorRef())
-        };
-
+        auto&& updateData = m_postProcessing->CreateUpdateData();
+        // Binding 0 : Fragment shader uniform buffer or inline uniform block
+        if (m_PPUniformBuffer)
+            updateData.SetBuffer(0, *m_PPUniformBuffer->GetDescriptorRef());
+        else
+            updateData.SetInlineUniformBlock(0, &m_PPUniform, sizeof(PPUniformBuffer));
+        // Binding 1, 2: Fragment shader samplers
+        updateData.SetImage(1, *colors[0]->GetDescriptorRef());
+        updateData.SetImage(2, *colors[1]->GetDescriptorRef());
 
-        vkUpdateDescriptorSets(*m_device, writeDescriptorSets1.size(), writeDescriptorSets1.data(), 0, NULL);
-        vkUpdateDescriptorSets(*m_device, writeDescriptorSets2.size(), writeDescriptorSets2.data(), 0, NULL);
+        m_postProcessing->UpdateDescriptorSet(m_PPDescriptorSet, updateData);
 
         return true;
     }
@@ -476,66 +604,59 @@ public:
                 m_allocator,
                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, // | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                sizeof(ViewUniformBuffer));
+                sizeof(ViewUniformBuffer),
+                nullptr,
+                true /** persistentMapped, updates every frame */);
 
         // geometry
 
         for (auto&& mesh : meshes) {
             mesh.m_descrManager = m_descriptorManager;
 
-            mesh.m_descriptorSet = this->m_descriptorManager->AllocateDescriptorSets(m_geometry->GetDescriptorSetLayout(), {
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
-            });
-            if (mesh.m_descriptorSet.m_self == VK_NULL_HANDLE) {
-                VK_ERROR("VulkanExample::SetupDescriptors() : failed to allocate descriptor sets!");
+            /// данные меша пишутся в кольцо каждый кадр, до первого UpdateUBO смещение указывает на начало кольца
+            mesh.m_dynamicOffset = 0;
+
+            Core::DescriptorWrites writes;
+            // Binding 0 : Vertex shader dynamic uniform buffer
+            writes.AddBuffer(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, GetUniformRing()->GetDescriptor(sizeof(ModelUniformBuffer)));
+            writes.AddBuffer(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, *m_viewUniformBuffer->GetDescriptorRef());
+            // Binding 2 : Fragment shader combined image sampler
+            writes.AddImage(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, *m_texture->GetDescriptorRef());
+
+            mesh.m_descriptorSet = m_descriptorManager->GetDescriptorCache()->Acquire(m_geometry->GetDescriptorSetLayout(), writes);
+            if (!mesh.m_descriptorSet.Valid()) {
+                VK_ERROR("VulkanExample::SetupDescriptors() : failed to acquire descriptor set!");
                 return false;
             }
+        }
+
+        /// все сеты с текстурой получены из кэша, дефрагментация перепишет их сама
+        m_texture->EnableRelocation();
+
+        /// post processing
+        const bool inlinePP = m_device->GetFeatures().m_inlineUniformBlock;
 
-            //!=============================================================================================================
+        m_PPDescriptorSet = m_descriptorManager->AllocateDescriptorSets(m_postProcessing->GetDescriptorSetLayout(), {
+                inlinePP ? VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+        });
 
-            mesh.m_uniformBuffer = EvoVulkan::Types::Buffer::Create(
+        if (!inlinePP) {
+            m_PPUniformBuffer = EvoVulkan::Types::Buffer::Create(
                     m_device,
                     m_allocator,
                     VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, // | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                    sizeof(ModelUniformBuffer));
-
-            // Setup a descriptor image info for the current texture to be used as a combined image sampler
-            auto textureDescriptor = m_texture->GetDescriptorRef();
-
-            std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-                    // Binding 0 : Vertex shader uniform buffer
-                    Tools::Initializers::WriteDescriptorSet(mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0,
-                                                            mesh.m_uniformBuffer->GetDescriptorRef()),
-
-                    Tools::Initializers::WriteDescriptorSet(mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1,
-                                                            m_viewUniformBuffer->GetDescriptorRef()),
-
-                    //Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2,
-                    //                                        textureDescriptor)
-            };
-            vkUpdateDescriptorSets(*m_device, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, NULL);
+                    sizeof(PPUniformBuffer));
         }
 
-        /// post processing
-        m_PPDescriptorSet = m_descriptorManager->AllocateDescriptorSets(m_postProcessing->GetDescriptorSetLayout(), {
-                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
-        });
-
-        m_PPUniformBuffer = EvoVulkan::Types::Buffer::Create(
-                m_device,
-                m_allocator,
-                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, // | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-                sizeof(PPUniformBuffer));
-
         return true;
     }
 
     bool SetupShader() {
         bool hasErrors = false;
 
-        m_geometry = new Complexes::Shader(GetDevice(), m_offscreen->GetRenderPass(), GetPipelineCache());
+        m_geometry = new Complexes::Shader(GetDevice(), m_offscreen->GetRenderPass(), GetPipelineCache(), GetDescriptorManager());
 
         hasErrors |= !m_geometry->Load("J:/C++/EvoVulkan/Resources/Cache",
                          {
@@ -543,7 +664,7 @@ public:
                                  { "geometry.frag", resources + "/Shaders/geometry.frag", VK_SHADER_STAGE_FRAGMENT_BIT },
                          },
                          {
-                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                 Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                                                  VK_SHADER_STAGE_VERTEX_BIT, 0),
 
                                  Tools::Initializers::DescriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
@@ -579,7 +700,7 @@ public:
 
         //!=============================================================================================================
 
-        m_skyboxShader = new Complexes::Shader(GetDevice(), m_offscreen->GetRenderPass(), GetPipelineCache());
+        m_skyboxShader = new Complexes::Shader(GetDevice(), m_offscreen->GetRenderPass(), GetPipelineCache(), GetDescriptorManager());
 
         hasErrors |= !m_skyboxShader->Load("J:/C++/EvoVulkan/Resources/Cache",
                          {
@@ -617,7 +738,7 @@ public:
 
         //!=============================================================================================================
 
-        m_postProcessing = new Complexes::Shader(GetDevice(), this->GetRenderPass(), GetPipelineCache());
+        m_postProcessing = new Complexes::Shader(GetDevice(), this->GetRenderPass(), GetPipelineCache(), GetDescriptorManager());
 
         hasErrors |= !m_postProcessing->Load("J://C++/EvoVulkan/Resources/Cache",
                                {
@@ -625,6 +746,11 @@ public:
                                        {"post_processing.frag", resources + "/Shaders/post_processing.frag", VK_SHADER_STAGE_FRAGMENT_BIT},
                                },
                                {
+                                       /// для inline блока descriptorCount - это его размер в байтах
+                                       GetDevice()->GetFeatures().m_inlineUniformBlock ?
+                                       Tools::Initializers::DescriptorSetLayoutBinding(
+                                               VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT,
+                                               VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PPUniformBuffer)) :
                                        Tools::Initializers::DescriptorSetLayoutBinding(
                                                VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
                                                VK_SHADER_STAGE_FRAGMENT_BIT, 0),
@@ -676,7 +802,8 @@ public:
                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 vertices.size() * sizeof(VertexUV),
-                vertices.data());
+                vertices.data(),
+                false, Memory::MemoryPool::StaticMeshes);
 
         /// Index buffer
         m_planeIndicesBuff = Types::Buffer::Create(
@@ -685,7 +812,8 @@ public:
                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 indices.size() * sizeof(uint32_t),
-                indices.data());
+                indices.data(),
+                false, Memory::MemoryPool::StaticMeshes);
 
         for (auto&& mesh : meshes) {
             mesh.m_indexBuffer  = m_planeIndicesBuff;
@@ -733,6 +861,15 @@ public:
     }
 
     bool BuildCmdBuffers() override {
+        if (!BuildOffscreenCmd())
+            return false;
+
+        UpdatePP();
+
+        return BuildCmdBuffersPostProcess();
+    }
+
+    bool BuildOffscreenCmd() {
         std::vector<VkClearValue> clearValues = {
                 VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // color
                 VkClearValue{ .color = {{0.0f, 0.0f, 0.0f, 1.0f}} }, // resolve
@@ -759,14 +896,6 @@ public:
 
         m_offscreen->SetViewportAndScissor();
 
-        for (auto & _mesh : meshes) {
-            std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
-                    Tools::Initializers::WriteDescriptorSet(_mesh.m_descriptorSet.m_self, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2,
-                                                            m_texture->GetDescriptorRef())
-            };
-            vkUpdateDescriptorSets(*m_device, writeDescriptorSets.size(), writeDescriptorSets.data(), 0, NULL);
-        }
-
         {
             vkCmdBindPipeline(m_offscreen->GetCmd(), VK_PIPELINE_BIND_POINT_GRAPHICS, *m_geometry);
 
@@ -782,9 +911,7 @@ public:
 
         m_offscreen->End();
 
-        UpdatePP();
-
-        return BuildCmdBuffersPostProcess();
+        return true;
     }
 
     bool BuildCmdBuffersPostProcess() {
@@ -829,6 +956,11 @@ public:
 
         EVSafeFreeObject(m_offscreen);
 
+        /// сеты возвращаются в кэш до уничтожения текстур, иначе кэш не сможет их вытеснить
+        for (auto&& mesh : meshes)
+            mesh.Destroy();
+        skybox.Destroy();
+
         EVSafeFreeObject(m_texture);
         EVSafeFreeObject(m_cubeMap);
 
@@ -844,10 +976,6 @@ public:
         EVSafeFreeObject(m_postProcessing);
         EVSafeFreeObject(m_skyboxShader);
 
-        for (auto&& mesh : meshes)
-            mesh.Destroy();
-        skybox.Destroy();
-
         EVSafeFreeObject(m_skyboxVerticesBuff);
         EVSafeFreeObject(m_skyboxIndicesBuff);
 
@@ -82,7 +82,7 @@ int main() {
 
     std::function<VkSurfaceKHR(const VkInstance& instance)> surfCreate = [window](const VkInstance& instance) -> VkSurfaceKHR {
         VkSurfaceKHR surfaceKhr = {};
-        if (glfwCreateWindowSurface(instance, window, nullptr, &surfaceKhr) != VK_SUCCESS) {
+        if (glfwCreateWindowSurface(instance, window, EvoVulkan::Memory::GetAllocationCallbacks(), &surfaceKhr) != VK_SUCCESS) {
             VK_ERROR("VulkanKernel::Init(lambda) : failed to create glfw window surface!");
             return VK_NULL_HANDLE;
         }
@@ -111,7 +111,8 @@ int main() {
     if (!kernel->LoadTexture())
         return -1;
 
-    if (!kernel->LoadCubeMap())
+    /// 8-битная кубмапа, если устройство не поддерживает ни один HDR формат
+    if (!kernel->LoadHDRCubeMap() && !kernel->LoadCubeMap())
         return -1;
 
     if (!kernel->SetupShader())
@@ -129,20 +130,23 @@ int main() {
     while (!glfwWindowShouldClose(window) && !kernel->HasErrors()) {
         glfwPollEvents();
 
+        /// юниформы обновляются внутри Render, после переключения кольца на текущий кадр
         kernel->NextFrame();
-
-        kernel->UpdateUBO();
     }
 
     kernel->Destroy();
 
     delete kernel;
 
+    /// после уничтожения ядра живыми остаются только утечки
+    EvoVulkan::Memory::HostAllocator::Instance().LogStatistics();
+
     glfwDestroyWindow(window);
     glfwTerminate();
 
     EvoVulkan::Tools::VkDebug::Destroy();
     EvoVulkan::Complexes::GLSLCompiler::Destroy();
+    EvoVulkan::Memory::HostAllocator::Destroy();
 
     return 0;
 }
\ No newline at end of file